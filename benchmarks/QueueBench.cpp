@@ -0,0 +1,108 @@
+/**
+ * @file QueueBench.cpp
+ * @author Swarnendu RC
+ * @brief Throughput of the queue modes of the pool under many producers.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Every producer thread submits the same number of tiny tasks to a fresh pool, the time
+ * taken until the pool has run them all is reported per queue mode and no. of producers.
+ *
+ * Usage: BenchThreadPool [workers] [tasks per producer]
+ */
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+namespace
+{
+    const char* getModeName(const QueueMode queueMode)
+    {
+        switch (queueMode)
+        {
+            case QueueMode::SHARED:     return "SHARED";
+            case QueueMode::PER_CORE:   return "PER_CORE";
+            case QueueMode::SHARDED:    return "SHARDED";
+        }
+        return "?";
+    }
+
+    /**
+     * @brief Runs the tasks of all the producers to completion.
+     *
+     * @return double The time taken in seconds.
+     */
+    double runProducers(const ui32 workerCnt, const QueueMode queueMode,
+                        const uint32_t producerCnt, const uint32_t taskCnt)
+    {
+        std::atomic<uint64_t> ranCnt = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            ThreadPool tpool(workerCnt, queueMode);
+            std::vector<std::thread> producers;
+            for (uint32_t producerIdx = 0; producerIdx < producerCnt; ++producerIdx)
+            {
+                producers.emplace_back([&tpool, &ranCnt, taskCnt]()
+                {
+                    for (uint32_t idx = 0; idx < taskCnt; ++idx)
+                        tpool.submit([&ranCnt]() { ranCnt.fetch_add(1, std::memory_order_relaxed); });
+                });
+            }
+            for (auto& producer : producers)
+                producer.join();
+        }   // The pool waits for its tasks before going away
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (ranCnt != static_cast<uint64_t>(producerCnt) * taskCnt)
+            std::fprintf(stderr, "Lost tasks in %s mode\n", getModeName(queueMode));
+        return elapsed.count();
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    ui32 workerCnt = (argc > 1) ? static_cast<ui32>(std::atoi(argv[1])) : std::thread::hardware_concurrency();
+    uint32_t taskCnt = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 20000;
+    if (!workerCnt || !taskCnt)
+    {
+        std::fprintf(stderr, "Usage: %s [workers] [tasks per producer]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%u workers, %u tasks per producer\n", static_cast<unsigned>(workerCnt), taskCnt);
+    std::printf("%-10s %10s %12s %14s\n", "mode", "producers", "seconds", "tasks/second");
+    for (auto producerCnt : {1u, 4u, 16u, 64u})
+    {
+        for (auto queueMode : {QueueMode::SHARED, QueueMode::SHARDED, QueueMode::PER_CORE})
+        {
+            auto seconds = runProducers(workerCnt, queueMode, producerCnt, taskCnt);
+            std::printf("%-10s %10u %12.4f %14.0f\n", getModeName(queueMode), producerCnt,
+                        seconds, producerCnt * static_cast<double>(taskCnt) / seconds);
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file Actor.hpp
+ * @brief Lightweight actors sharing the workers of a thread pool.
+ *
+ * An actor owns a mailbox and a handler. It doesn't own a thread: a message sent to an idle
+ * actor queues one activation of it on the pool, which runs the handler on a bounded batch
+ * of messages and then either goes idle or queues itself again. So an actor only occupies
+ * a worker while it has messages, and many actors share a few workers fairly.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ACTOR_HPP
+#define ACTOR_HPP
+
+#include "MpscQueue.hpp"
+#include "ThreadPool.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace t_pool
+{
+    /**
+     * @class Actor
+     * @brief A mailbox of messages of type M processed one at a time by a handler on a pool.
+     *
+     * Any thread may send messages, the handler only ever runs on one worker at a time, so the
+     * state it owns needs no locking. Messages from one sender are handled in the order sent.
+     * An exception escaping the handler is logged and counted, the next message is handled as usual.
+     *
+     * Actors are owned by shared pointers (see create()): a pending activation keeps its actor alive.
+     *
+     * @tparam M The type of the messages, it must be movable and default constructible.
+     */
+    template <typename M>
+    class Actor : public std::enable_shared_from_this<Actor<M>>
+    {
+        public:
+            using Handler = std::function<void(M&)>;
+
+            static constexpr uint32_t DEFAULT_BATCH_SIZE = 64;
+
+            /**
+             * @brief Creates a new actor.
+             *
+             * @param [in] pool The thread pool to run the actor's activations on.
+             * @param [in] handler The callable handling the messages.
+             * @param [in] batchSize The max no. of messages handled per activation, at least one.
+             * @return std::shared_ptr<Actor> The actor.
+             */
+            static std::shared_ptr<Actor> create(ThreadPool& pool, Handler handler, const uint32_t batchSize = DEFAULT_BATCH_SIZE)
+            {
+                return std::shared_ptr<Actor>(new Actor(pool, std::move(handler), batchSize));
+            }
+
+            Actor(const Actor&) = delete;
+            Actor& operator=(const Actor&) = delete;
+
+            /**
+             * @brief Sends a message to the actor, from any thread.
+             * Queues an activation of the actor if it is idle.
+             *
+             * @param [in] message The message.
+             */
+            void send(M message)
+            {
+                m_pendingCnt.fetch_add(1, std::memory_order_seq_cst);
+                m_mailbox.push(std::move(message));
+                if (!m_isScheduled.exchange(true, std::memory_order_seq_cst))
+                    activate();
+            }
+
+            inline uint64_t getPendingCnt() const noexcept { return m_pendingCnt.load(std::memory_order_relaxed); }
+            inline uint64_t getHandledCnt() const noexcept { return m_handledCnt.load(std::memory_order_relaxed); }
+            inline uint64_t getFailedCnt() const noexcept { return m_failedCnt.load(std::memory_order_relaxed); }
+            inline uint64_t getActivationCnt() const noexcept { return m_activationCnt.load(std::memory_order_relaxed); }
+            inline uint32_t getBatchSize() const noexcept { return m_batchSize; }
+
+        private:
+            Actor(ThreadPool& pool, Handler handler, const uint32_t batchSize)
+                : m_pool(pool)
+                , m_handler(std::move(handler))
+                , m_batchSize(batchSize ? batchSize : 1)
+            {}
+
+            void activate()
+            {
+                m_activationCnt.fetch_add(1, std::memory_order_relaxed);
+                m_pool.submit([pSelf = this->shared_from_this()]() { pSelf->run(); });
+            }
+
+            void run()
+            {
+                M message;
+                for (uint32_t idx = 0; idx < m_batchSize && m_mailbox.tryPop(message); ++idx)
+                {
+                    m_pendingCnt.fetch_sub(1, std::memory_order_relaxed);
+                    try
+                    {
+                        m_handler(message);
+                    }
+                    catch (const std::exception& error)
+                    {
+                        m_failedCnt.fetch_add(1, std::memory_order_relaxed);
+                        LOG_ERR("Actor handler failed: {}", error.what());
+                    }
+                    catch (...)
+                    {
+                        m_failedCnt.fetch_add(1, std::memory_order_relaxed);
+                        LOG_ERR("Actor handler failed with an unknown exception");
+                    }
+                    m_handledCnt.fetch_add(1, std::memory_order_relaxed);
+                }
+                // Go idle, unless messages arrived meanwhile. A sender finding the actor still
+                // scheduled has counted its message before, so it is seen here. The mailbox
+                // itself is off limits past the store, another activation may be popping it.
+                m_isScheduled.store(false, std::memory_order_seq_cst);
+                if (m_pendingCnt.load(std::memory_order_seq_cst) != 0 && !m_isScheduled.exchange(true, std::memory_order_seq_cst))
+                    activate();
+            }
+
+            ThreadPool& m_pool;
+            Handler m_handler;
+            const uint32_t m_batchSize;
+            MpscQueue<M> m_mailbox;
+            std::atomic_bool m_isScheduled = false;
+            std::atomic<uint64_t> m_pendingCnt = 0;
+            std::atomic<uint64_t> m_handledCnt = 0;
+            std::atomic<uint64_t> m_failedCnt = 0;
+            std::atomic<uint64_t> m_activationCnt = 0;
+    };
+};   // namespace t_pool
+
+#endif  // ACTOR_HPP
@@ -0,0 +1,241 @@
+/**
+ * @file AsyncGenerator.hpp
+ * @brief Coroutine generators running on the thread pool, consumed one item at a time.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASYNC_GENERATOR_HPP
+#define ASYNC_GENERATOR_HPP
+
+#include "CoTask.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace t_pool
+{
+    /**
+     * @class AsyncGenerator
+     * @brief A coroutine yielding a stream of T, its body running on a thread pool.
+     *
+     * The pool is the first parameter of the generator coroutine (the first after the
+     * object for a member function or a lambda). Consumers, being coroutines themselves,
+     * pull the items with `while (auto item = co_await generator.next())`.
+     *
+     * The body starts on the first pull. Each `co_yield` hands an item over and suspends the
+     * body until the consumer takes the item; taking it queues the body on the pool to produce
+     * the next item while the consumer works on this one. So the body is never more than one
+     * item ahead of its consumer, and neither a waiting body nor a waiting consumer occupies a
+     * worker. An exception escaping the body is rethrown by the pull following the last item.
+     *
+     * Destroying the generator while the body is producing lets the body run up to its next
+     * `co_yield`, where it is then destroyed, on its worker.
+     *
+     * @tparam T The type of the items, it must be movable.
+     */
+    template <typename T>
+    class AsyncGenerator
+    {
+        public:
+            class promise_type
+            {
+                public:
+                    template <typename ...A>
+                    explicit promise_type(ThreadPool& pool, A&& ...) noexcept : m_pPool(&pool) {}
+
+                    template <typename C, typename ...A>
+                        requires (!std::is_same_v<std::remove_cvref_t<C>, ThreadPool>)
+                    promise_type(C&&, ThreadPool& pool, A&& ...) noexcept : m_pPool(&pool) {}
+
+                    AsyncGenerator get_return_object() noexcept
+                    {
+                        return AsyncGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+                    }
+
+                    std::suspend_always initial_suspend() const noexcept { return {}; }
+                    auto final_suspend() noexcept { return HandOffAwaiter{true}; }
+                    void unhandled_exception() noexcept { m_pError = std::current_exception(); }
+                    void return_void() const noexcept {}
+
+                    template <typename U>
+                    auto yield_value(U&& value)
+                    {
+                        // The consumer has taken the previous item before the body got resumed
+                        m_item.emplace(std::forward<U>(value));
+                        return HandOffAwaiter{false};
+                    }
+
+                private:
+                    friend class AsyncGenerator;
+
+                    /**
+                     * @brief Publishes the item yielded (or the end of the stream) once the body
+                     * is suspended and resumes the consumer waiting for it, if any.
+                     */
+                    struct HandOffAwaiter
+                    {
+                        bool m_isFinal;
+
+                        bool await_ready() const noexcept { return false; }
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                        {
+                            auto& promise = handle.promise();
+                            std::coroutine_handle<> consumer;
+                            {
+                                std::unique_lock<std::mutex> lock(promise.m_mtx);
+                                promise.m_isRunning = false;
+                                if (promise.m_isAbandoned)
+                                {
+                                    lock.unlock();
+                                    handle.destroy();
+                                    return std::noop_coroutine();
+                                }
+                                (m_isFinal ? promise.m_isDone : promise.m_hasItem) = true;
+                                consumer = std::exchange(promise.m_consumer, {});
+                            }
+                            return consumer ? consumer : std::noop_coroutine();
+                        }
+                        void await_resume() const noexcept {}
+                    };
+
+                    void resumeOnPool()
+                    {
+                        auto handle = std::coroutine_handle<promise_type>::from_promise(*this);
+                        m_pPool->submit([handle]() { handle.resume(); });
+                    }
+
+                    ThreadPool* m_pPool;
+                    std::mutex m_mtx;
+                    std::coroutine_handle<> m_consumer;
+                    std::optional<T> m_item;
+                    std::exception_ptr m_pError;
+                    bool m_hasItem = false;
+                    bool m_isDone = false;
+                    bool m_isRunning = false;
+                    bool m_isAbandoned = false;
+            };
+
+            using Handle = std::coroutine_handle<promise_type>;
+
+            explicit AsyncGenerator(Handle handle) noexcept : m_handle(handle) {}
+            AsyncGenerator(AsyncGenerator&& rhs) noexcept : m_handle(std::exchange(rhs.m_handle, {})) {}
+            AsyncGenerator& operator=(AsyncGenerator&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    release();
+                    m_handle = std::exchange(rhs.m_handle, {});
+                }
+                return *this;
+            }
+            ~AsyncGenerator() { release(); }
+
+            AsyncGenerator(const AsyncGenerator&) = delete;
+            AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+
+            /** @brief Suspends the consumer until the next item is produced */
+            class NextAwaiter
+            {
+                public:
+                    explicit NextAwaiter(Handle handle) noexcept : m_handle(handle) {}
+
+                    bool await_ready() const noexcept { return false; }
+
+                    bool await_suspend(std::coroutine_handle<> consumer)
+                    {
+                        auto& promise = m_handle.promise();
+                        {
+                            std::lock_guard<std::mutex> lock(promise.m_mtx);
+                            if (promise.m_hasItem || promise.m_isDone)
+                                return false;
+                            promise.m_consumer = consumer;
+                            // The body is only idle without an item before the first pull
+                            if (promise.m_isRunning)
+                                return true;
+                            promise.m_isRunning = true;
+                        }
+                        promise.resumeOnPool();
+                        return true;
+                    }
+
+                    /**
+                     * @return std::optional<T> The item, empty at the end of the stream.
+                     * @throw The exception the body failed with, at the end of the stream.
+                     */
+                    std::optional<T> await_resume()
+                    {
+                        auto& promise = m_handle.promise();
+                        std::optional<T> item;
+                        {
+                            std::lock_guard<std::mutex> lock(promise.m_mtx);
+                            if (!promise.m_hasItem)
+                            {
+                                if (promise.m_pError)
+                                    std::rethrow_exception(promise.m_pError);
+                                return item;
+                            }
+                            item = std::move(promise.m_item);
+                            promise.m_item.reset();
+                            promise.m_hasItem = false;
+                            promise.m_isRunning = true;
+                        }
+                        promise.resumeOnPool();
+                        return item;
+                    }
+
+                private:
+                    Handle m_handle;
+            };
+
+            /**
+             * @brief Pulls the next item, to be co_await'ed by the consumer.
+             * Only one pull may be pending at a time.
+             */
+            NextAwaiter next() noexcept { return NextAwaiter(m_handle); }
+
+        private:
+            void release() noexcept
+            {
+                if (!m_handle)
+                    return;
+                auto handle = std::exchange(m_handle, {});
+                {
+                    std::lock_guard<std::mutex> lock(handle.promise().m_mtx);
+                    if (handle.promise().m_isRunning)
+                    {
+                        // The body is or will be running on a worker, it frees itself when it suspends
+                        handle.promise().m_isAbandoned = true;
+                        return;
+                    }
+                }
+                handle.destroy();
+            }
+
+            Handle m_handle;
+    };
+};   // namespace t_pool
+
+#endif  // ASYNC_GENERATOR_HPP
@@ -0,0 +1,226 @@
+/**
+ * @file BufferPool.hpp
+ * @brief Reference counted, recycled byte buffers for task payloads.
+ *
+ * A BufferPool hands out Buffer handles on fixed size slabs. A handle is cheap to move,
+ * copying it only bumps a reference count, so a payload written once can be passed on to
+ * any no. of tasks without its bytes ever being copied. The slab goes back to the pool as
+ * soon as the last handle is gone and is reused by the next acquire().
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BUFFER_POOL_HPP
+#define BUFFER_POOL_HPP
+
+#include "HugePages.hpp"
+#include "MemoryGroup.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace t_pool
+{
+    class BufferPool;
+
+    /**
+     * @brief The header in front of every slab of a BufferPool.
+     */
+    struct alignas(64) BufferSlab
+    {
+        std::atomic<uint32_t> refCnt = 0;
+        size_t size = 0;
+        BufferPool* pPool = nullptr;
+        BufferSlab* pNext = nullptr;
+        /** @brief The memory group the slab is charged to while in use */
+        std::shared_ptr<MemoryGroup> pGroup;
+
+        inline std::byte* getData() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+    };
+
+    /**
+     * @class Buffer
+     * @brief A reference counted handle on a slab of a BufferPool.
+     *
+     * Move the handle into a task (capture or argument) to hand the payload over without
+     * touching the reference count. Copies share the same bytes.
+     */
+    class Buffer
+    {
+        public:
+            Buffer() = default;
+            Buffer(const Buffer& rhs) noexcept : m_pSlab(rhs.m_pSlab)
+            {
+                if (m_pSlab)
+                    m_pSlab->refCnt.fetch_add(1, std::memory_order_relaxed);
+            }
+            Buffer(Buffer&& rhs) noexcept : m_pSlab(std::exchange(rhs.m_pSlab, nullptr)) {}
+            ~Buffer() { reset(); }
+
+            Buffer& operator=(const Buffer& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    Buffer copy(rhs);
+                    std::swap(m_pSlab, copy.m_pSlab);
+                }
+                return *this;
+            }
+
+            Buffer& operator=(Buffer&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    reset();
+                    m_pSlab = std::exchange(rhs.m_pSlab, nullptr);
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Drops this reference, the slab is recycled with the last one.
+             */
+            void reset() noexcept;
+
+            inline explicit operator bool() const noexcept { return m_pSlab != nullptr; }
+            inline std::byte* getData() noexcept { return m_pSlab ? m_pSlab->getData() : nullptr; }
+            inline const std::byte* getData() const noexcept { return m_pSlab ? m_pSlab->getData() : nullptr; }
+            inline size_t getSize() const noexcept { return m_pSlab ? m_pSlab->size : 0; }
+            size_t getCapacity() const noexcept;
+            inline uint32_t getRefCnt() const noexcept
+                { return m_pSlab ? m_pSlab->refCnt.load(std::memory_order_relaxed) : 0; }
+
+            /**
+             * @brief Sets the no. of bytes of the buffer in use.
+             *
+             * @param [in] size The size, at most getCapacity().
+             * @throw std::length_error if the size exceeds the capacity.
+             */
+            void setSize(const size_t size);
+
+        private:
+            friend class BufferPool;
+            explicit Buffer(BufferSlab* pSlab) noexcept : m_pSlab(pSlab) {}
+
+            BufferSlab* m_pSlab = nullptr;
+    };
+
+    /**
+     * @class BufferPool
+     * @brief A pool of fixed size slabs backing Buffer handles.
+     *
+     * Released slabs are kept in a fixed no. of caches, each with its own lock and each
+     * thread sticking to one cache, so the workers recycling payloads hardly ever contend.
+     * A cache growing beyond its capacity hands half of its slabs over to a shared list
+     * other threads refill from. Slabs are allocated in chunks and only freed with the pool.
+     * The chunks can be backed by huge pages, in which case a chunk fills a whole huge page.
+     *
+     * @note The pool must outlive every Buffer acquired from it.
+     */
+    class BufferPool
+    {
+        public:
+            /** @brief The min no. of slabs allocated at a time */
+            static constexpr size_t SLABS_PER_CHUNK = 32;
+
+            /**
+             * @brief Construct a new Buffer Pool object
+             *
+             * @param [in] slabSize The capacity of every buffer in bytes.
+             * @param [in] cacheCnt The no. of thread caches, defaults to hardware concurrency.
+             * @param [in] cacheCapacity The max no. of free slabs held by a thread cache.
+             * @param [in] hugePages The backing wanted for the slabs, see allocateHugePages().
+             */
+            explicit BufferPool(const size_t slabSize,
+                                const size_t cacheCnt = std::thread::hardware_concurrency(),
+                                const size_t cacheCapacity = 64,
+                                const HugePageMode hugePages = HugePageMode::OFF);
+            ~BufferPool();
+
+            BufferPool(const BufferPool&) = delete;
+            BufferPool& operator=(const BufferPool&) = delete;
+
+            /**
+             * @brief Hands out a buffer, recycled if possible.
+             *
+             * The slab is charged to the current memory group (see MemoryGroup) until recycled.
+             *
+             * @param [in] size The no. of bytes in use, at most getSlabSize().
+             * @return Buffer The only handle on the buffer. Its bytes are not cleared.
+             * @throw std::length_error if the size exceeds the slab size.
+             */
+            Buffer acquire(const size_t size = 0);
+
+            inline size_t getSlabSize() const noexcept { return m_slabSize; }
+
+            /** @brief The no. of slabs allocated so far, free or in use */
+            inline size_t getAllocatedCnt() const noexcept { return m_allocatedCnt.load(std::memory_order_relaxed); }
+
+            /** @brief The no. of slabs currently handed out */
+            inline size_t getInUseCnt() const noexcept { return m_inUseCnt.load(std::memory_order_relaxed); }
+
+            /** @brief The no. of bytes of slab memory actually backed by (transparent or explicit) huge pages */
+            inline size_t getHugePageBytes() const noexcept { return m_hugePageBytes.load(std::memory_order_relaxed); }
+
+        private:
+            friend class Buffer;
+
+            struct alignas(64) Cache
+            {
+                std::mutex mtx;
+                BufferSlab* pFree = nullptr;
+                size_t freeCnt = 0;
+            };
+
+            Cache& getCache() const noexcept;
+            void recycle(BufferSlab* pSlab) noexcept;
+            BufferSlab* allocateChunk();
+
+            size_t m_slabSize;
+            size_t m_slabStride;
+            size_t m_cacheCnt;
+            size_t m_cacheCapacity;
+            HugePageMode m_hugePages;
+            size_t m_slabsPerChunk;
+            std::unique_ptr<Cache[]> m_pCaches;
+            std::mutex m_sharedMtx;
+            BufferSlab* m_pSharedFree = nullptr;
+            std::vector<HugePageRegion> m_chunks;
+            std::atomic<size_t> m_allocatedCnt = 0;
+            std::atomic<size_t> m_inUseCnt = 0;
+            std::atomic<size_t> m_hugePageBytes = 0;
+    };
+
+    inline void Buffer::reset() noexcept
+    {
+        if (m_pSlab && m_pSlab->refCnt.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            m_pSlab->pPool->recycle(m_pSlab);
+        m_pSlab = nullptr;
+    }
+};   // namespace t_pool
+
+#endif  // BUFFER_POOL_HPP
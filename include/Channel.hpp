@@ -0,0 +1,197 @@
+/**
+ * @file Channel.hpp
+ * @brief A bounded channel streaming values from a producing task to its consumers.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CHANNEL_HPP
+#define CHANNEL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+namespace t_pool
+{
+    /**
+     * @class Channel
+     * @brief A bounded, thread safe FIFO of values with close semantics.
+     *
+     * The producer blocks while the channel is full, so it never runs further ahead of the
+     * consumers than the capacity, which bounds the memory held by a stream of results.
+     * Closing the channel wakes everybody up: the producer stops being able to push and the
+     * consumers drain what is left. A producer failing hands its exception to the consumers,
+     * who get it rethrown once they have drained the values produced before the failure.
+     *
+     * @tparam T The type of the values, it must be movable.
+     */
+    template <typename T>
+    class Channel
+    {
+        public:
+            /**
+             * @brief Construct a new Channel object
+             *
+             * @param [in] capacity The max no. of values buffered, at least one.
+             */
+            explicit Channel(const size_t capacity) : m_capacity(capacity ? capacity : 1) {}
+
+            Channel(const Channel&) = delete;
+            Channel& operator=(const Channel&) = delete;
+
+            /**
+             * @brief Pushes a value, waiting while the channel is full.
+             *
+             * @param [in] value The value.
+             * @return true if pushed, false if the channel has been closed (the value is dropped).
+             */
+            bool push(T value)
+            {
+                std::unique_lock<std::mutex> lock(m_mtx);
+                m_notFullCv.wait(lock, [this]() { return m_closed || m_values.size() < m_capacity; });
+                if (m_closed)
+                    return false;
+                m_values.emplace_back(std::move(value));
+                lock.unlock();
+                m_notEmptyCv.notify_one();
+                return true;
+            }
+
+            /**
+             * @brief Pushes a value if there is room for it.
+             *
+             * @param [in] value The value, left untouched if not pushed.
+             * @return true if pushed, false if the channel is full or closed.
+             */
+            bool tryPush(T& value)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mtx);
+                    if (m_closed || m_values.size() >= m_capacity)
+                        return false;
+                    m_values.emplace_back(std::move(value));
+                }
+                m_notEmptyCv.notify_one();
+                return true;
+            }
+
+            /**
+             * @brief Pops the oldest value, waiting while the channel is empty.
+             *
+             * @param [out] value The value popped.
+             * @return true if a value was popped, false if the channel is closed and drained.
+             * @throw The exception the producer failed with, once the channel is drained.
+             */
+            bool pop(T& value)
+            {
+                std::unique_lock<std::mutex> lock(m_mtx);
+                m_notEmptyCv.wait(lock, [this]() { return m_closed || !m_values.empty(); });
+                return popLocked(lock, value);
+            }
+
+            /**
+             * @brief Pops the oldest value if there is one.
+             *
+             * @param [out] value The value popped.
+             * @return true if a value was popped, false if the channel is empty.
+             * @throw The exception the producer failed with, once the channel is drained.
+             */
+            bool tryPop(T& value)
+            {
+                std::unique_lock<std::mutex> lock(m_mtx);
+                return popLocked(lock, value);
+            }
+
+            /**
+             * @brief Closes the channel, no more values can be pushed.
+             * Consumers still get the values already in the channel. Consumers
+             * not interested in any more values may close it to stop the producer.
+             */
+            void close()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mtx);
+                    m_closed = true;
+                }
+                m_notEmptyCv.notify_all();
+                m_notFullCv.notify_all();
+            }
+
+            /**
+             * @brief Closes the channel on behalf of a failed producer.
+             *
+             * @param [in] pError The exception rethrown to the consumers once they have drained the channel.
+             */
+            void fail(std::exception_ptr pError)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mtx);
+                    if (!m_pError)
+                        m_pError = std::move(pError);
+                }
+                close();
+            }
+
+            inline bool isClosed() const
+            {
+                std::lock_guard<std::mutex> lock(m_mtx);
+                return m_closed;
+            }
+
+            inline size_t getSize() const
+            {
+                std::lock_guard<std::mutex> lock(m_mtx);
+                return m_values.size();
+            }
+
+            inline size_t getCapacity() const noexcept { return m_capacity; }
+
+        private:
+            bool popLocked(std::unique_lock<std::mutex>& lock, T& value)
+            {
+                if (m_values.empty())
+                {
+                    if (m_closed && m_pError)
+                        std::rethrow_exception(m_pError);
+                    return false;
+                }
+                value = std::move(m_values.front());
+                m_values.pop_front();
+                lock.unlock();
+                m_notFullCv.notify_one();
+                return true;
+            }
+
+            const size_t m_capacity;
+            mutable std::mutex m_mtx;
+            std::condition_variable m_notEmptyCv;
+            std::condition_variable m_notFullCv;
+            std::deque<T> m_values;
+            bool m_closed = false;
+            std::exception_ptr m_pError;
+    };
+};   // namespace t_pool
+
+#endif  // CHANNEL_HPP
@@ -0,0 +1,288 @@
+/**
+ * @file CoTask.hpp
+ * @brief Coroutine tasks running on the thread pool.
+ *
+ * A CoTask is a lazily started coroutine, which runs once it is awaited by another coroutine
+ * or spawned onto a pool. Awaiting schedule() moves the coroutine onto a worker of the pool,
+ * so a coroutine waiting for something doesn't occupy a worker, unlike a blocking task.
+ * Awaiting yield() lets the tasks waiting for a worker run before the coroutine goes on.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CO_TASK_HPP
+#define CO_TASK_HPP
+
+#include "ThreadPool.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace t_pool
+{
+    template <typename T>
+    class CoTask;
+
+    /**
+     * @brief The part of a CoTask's promise common to all result types:
+     * the continuation resumed on completion and the exception the coroutine failed with.
+     */
+    class CoTaskPromiseBase
+    {
+        public:
+            /** @brief Resumes the awaiting coroutine, if any, once the task completes */
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+                template <typename P>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+                {
+                    auto continuation = handle.promise().m_continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { m_pError = std::current_exception(); }
+
+            inline void setContinuation(std::coroutine_handle<> continuation) noexcept { m_continuation = continuation; }
+
+        protected:
+            void rethrowIfFailed() const
+            {
+                if (m_pError)
+                    std::rethrow_exception(m_pError);
+            }
+
+        private:
+            std::coroutine_handle<> m_continuation;
+            std::exception_ptr m_pError;
+    };
+
+    /** @brief The promise of a CoTask producing a value */
+    template <typename T>
+    class CoTaskPromise : public CoTaskPromiseBase
+    {
+        public:
+            CoTask<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U&& value) { m_result.emplace(std::forward<U>(value)); }
+
+            T takeResult()
+            {
+                rethrowIfFailed();
+                return std::move(*m_result);
+            }
+
+        private:
+            std::optional<T> m_result;
+    };
+
+    /** @brief The promise of a CoTask producing nothing */
+    template <>
+    class CoTaskPromise<void> : public CoTaskPromiseBase
+    {
+        public:
+            CoTask<void> get_return_object() noexcept;
+
+            void return_void() const noexcept {}
+            void takeResult() const { rethrowIfFailed(); }
+    };
+
+    /**
+     * @class CoTask
+     * @brief A lazily started coroutine producing a T, awaitable once.
+     *
+     * Awaiting it starts the coroutine on the awaiting thread and resumes the awaiting
+     * coroutine when it completes, on the thread it completed on. Its result or its
+     * exception is handed to the awaiting coroutine.
+     *
+     * @note Like every lazy coroutine, the arguments referenced by the coroutine (and the
+     * captures of a coroutine lambda) must outlive the task, not just the call creating it.
+     *
+     * @tparam T The type of the result, void for none.
+     */
+    template <typename T = void>
+    class CoTask
+    {
+        public:
+            using promise_type = CoTaskPromise<T>;
+            using Handle = std::coroutine_handle<promise_type>;
+
+            explicit CoTask(Handle handle) noexcept : m_handle(handle) {}
+            CoTask(CoTask&& rhs) noexcept : m_handle(std::exchange(rhs.m_handle, {})) {}
+            CoTask& operator=(CoTask&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    if (m_handle)
+                        m_handle.destroy();
+                    m_handle = std::exchange(rhs.m_handle, {});
+                }
+                return *this;
+            }
+            ~CoTask()
+            {
+                if (m_handle)
+                    m_handle.destroy();
+            }
+
+            CoTask(const CoTask&) = delete;
+            CoTask& operator=(const CoTask&) = delete;
+
+            /** @brief Starts the task and suspends the awaiting coroutine until it completes */
+            struct Awaiter
+            {
+                Handle m_handle;
+
+                bool await_ready() const noexcept { return !m_handle || m_handle.done(); }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    m_handle.promise().setContinuation(awaiting);
+                    return m_handle;
+                }
+                T await_resume() { return m_handle.promise().takeResult(); }
+            };
+
+            Awaiter operator co_await() && noexcept { return Awaiter{m_handle}; }
+            Awaiter operator co_await() & noexcept { return Awaiter{m_handle}; }
+
+            inline bool isDone() const noexcept { return m_handle && m_handle.done(); }
+
+        private:
+            Handle m_handle;
+    };
+
+    template <typename T>
+    inline CoTask<T> CoTaskPromise<T>::get_return_object() noexcept
+    {
+        return CoTask<T>(std::coroutine_handle<CoTaskPromise<T>>::from_promise(*this));
+    }
+
+    inline CoTask<void> CoTaskPromise<void>::get_return_object() noexcept
+    {
+        return CoTask<void>(std::coroutine_handle<CoTaskPromise<void>>::from_promise(*this));
+    }
+
+    /**
+     * @brief Awaitable moving the awaiting coroutine onto a worker of a pool.
+     * `co_await schedule(pool);` suspends the coroutine and queues its resumption
+     * as a task of the pool.
+     *
+     * @param [in] pool The thread pool to continue on.
+     */
+    inline auto schedule(ThreadPool& pool) noexcept
+    {
+        struct ScheduleAwaiter
+        {
+            ThreadPool& m_pool;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { m_pool.submit([handle]() { handle.resume(); }); }
+            void await_resume() const noexcept {}
+        };
+        return ScheduleAwaiter{pool};
+    }
+
+    /**
+     * @brief Awaitable letting the tasks waiting for a worker of a pool run first.
+     * `co_await yield(pool);` queues the resumption of the coroutine behind the tasks
+     * waiting, if any, and frees the worker for them, otherwise it goes straight on.
+     * Long running coroutines can do it whenever ThreadPool::shouldYield() says so.
+     *
+     * @param [in] pool The thread pool the coroutine runs on.
+     */
+    inline auto yield(ThreadPool& pool) noexcept
+    {
+        struct YieldAwaiter
+        {
+            ThreadPool& m_pool;
+
+            bool await_ready() const noexcept { return !m_pool.getTaskQueued(); }
+            void await_suspend(std::coroutine_handle<> handle) { m_pool.submit([handle]() { handle.resume(); }); }
+            void await_resume() const noexcept {}
+        };
+        return YieldAwaiter{pool};
+    }
+
+    /**
+     * @brief A coroutine which starts eagerly and frees itself on completion,
+     * used to run a CoTask on behalf of non coroutine code.
+     */
+    struct DetachedCoroutine
+    {
+        struct promise_type
+        {
+            DetachedCoroutine get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+
+    /**
+     * @brief Runs a coroutine task on a pool, for non coroutine code.
+     * The task is started on a worker of the pool and its result or its
+     * exception is delivered through the future returned.
+     *
+     * @tparam T The type of the result of the task.
+     * @param [in] pool The thread pool to run the task on.
+     * @param [in] task The coroutine task, not started yet.
+     * @return std::future<T> The future of the task's result.
+     */
+    template <typename T>
+    std::future<T> spawn(ThreadPool& pool, CoTask<T> task)
+    {
+        auto pPromise = std::make_shared<std::promise<T>>();
+        auto future = pPromise->get_future();
+        [](ThreadPool& pool, CoTask<T> task, std::shared_ptr<std::promise<T>> pPromise) -> DetachedCoroutine
+        {
+            co_await schedule(pool);
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await std::move(task);
+                    pPromise->set_value();
+                }
+                else
+                {
+                    pPromise->set_value(co_await std::move(task));
+                }
+            }
+            catch (...)
+            {
+                pPromise->set_exception(std::current_exception());
+            }
+        }(pool, std::move(task), std::move(pPromise));
+        return future;
+    }
+};   // namespace t_pool
+
+#endif  // CO_TASK_HPP
@@ -0,0 +1,165 @@
+/**
+ * @file DagExecutor.hpp
+ * @brief Dataflow executor for task graphs stored in compressed sparse row (CSR) form.
+ *
+ * The executor is the common engine behind the graph front ends of the library. A graph
+ * is described by a node count, an offsets array and a targets array where the successors
+ * of node `n` are `targets[offsets[n] .. offsets[n + 1])`. Every node gets an atomic
+ * counter of unfinished predecessors; once it drops to zero the node is handed to the
+ * thread pool. Nothing is hashed while the graph runs.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DAG_EXECUTOR_HPP
+#define DAG_EXECUTOR_HPP
+
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace t_pool
+{
+    /**
+     * @brief A read only view of a graph in CSR form.
+     * The successors (dependents) of node `n` are
+     * `targets[offsets[n] .. offsets[n + 1])`.
+     * The view does not own any memory.
+     */
+    struct CsrGraphView
+    {
+        uint32_t nodeCount = 0;
+        const uint64_t* offsets = nullptr;
+        const uint32_t* targets = nullptr;
+
+        /** @brief Total no. of edges in the graph */
+        inline uint64_t edgeCount() const noexcept { return nodeCount ? offsets[nodeCount] : 0; }
+    };
+
+    /**
+     * @class DagExecutor
+     * @brief Runs every node of an acyclic CSR graph on a ThreadPool honouring the edges.
+     *
+     * A node is submitted to the pool as soon as all of its predecessors have finished.
+     * When a finishing node releases several successors the first one is executed inline
+     * by the same worker, the rest are submitted to the pool, which saves a queue round
+     * trip along chains.
+     *
+     * Nodes can be run a second time while the graph is executing (see duplicate()), in
+     * which case whichever run of the node finishes first releases its successors.
+     *
+     * The nodes inherit the priority of the context calling run(), which waits for all of
+     * them. A node awaited by a more urgent context can be boosted (see boost()), along with
+     * the predecessors it still waits for.
+     *
+     * @note run() blocks the calling thread until the whole graph is done, so it must not
+     * be called from a worker of the same pool.
+     */
+    class DagExecutor
+    {
+        public:
+            using NodeFunc = std::function<void(uint32_t)>;
+            using WaitFunc = std::function<void()>;
+
+            /**
+             * @brief Construct a new Dag Executor object
+             *
+             * @param [in] pool The thread pool the nodes are executed on.
+             */
+            explicit DagExecutor(ThreadPool& pool) : m_pool(pool) {}
+
+            /**
+             * @brief Executes the graph.
+             * The node function is invoked once per node with the node index. If any node
+             * throws, the remaining nodes are skipped (but still accounted for) and the first
+             * exception is rethrown to the caller once the graph has drained.
+             *
+             * @param [in] graph The graph to execute. It must be acyclic.
+             * @param [in] nodeFunc The callable executed for every node. It is copied, so
+             * a duplicated node still running after run() has returned can use it safely.
+             */
+            void run(const CsrGraphView& graph, NodeFunc nodeFunc)
+                { run(graph, std::move(nodeFunc), WaitFunc{}, std::chrono::microseconds(0)); }
+
+            /**
+             * @brief Executes the graph, calling back the waiting thread periodically.
+             * Same as run() but the calling thread invokes @p onWait every @p waitInterval
+             * while the graph is in flight, e.g. to monitor the running nodes.
+             *
+             * @param [in] graph The graph to execute. It must be acyclic.
+             * @param [in] nodeFunc The callable executed for every node.
+             * @param [in] onWait The callable invoked periodically by the waiting thread.
+             * @param [in] waitInterval The interval between two invocations of @p onWait.
+             */
+            void run(const CsrGraphView& graph,
+                     NodeFunc nodeFunc,
+                     const WaitFunc& onWait,
+                     const std::chrono::microseconds waitInterval);
+
+            /**
+             * @brief Runs a node of the graph in flight once more on the pool.
+             * The first of the two runs to finish releases the successors of the node,
+             * the other one is ignored. Only to be called from the wait callback and
+             * only for nodes whose node function is safe to be executed twice.
+             *
+             * @param [in] nodeIdx The node to run again.
+             */
+            void duplicate(const uint32_t nodeIdx);
+
+            /**
+             * @brief Raises the priority of a node of the graph in flight and of all of its
+             * unfinished predecessors, queued ones being moved up in the ready queues.
+             * To be called from any thread while run() is in progress.
+             *
+             * @param [in] nodeIdx The node awaited by a more urgent context.
+             * @param [in] priority The priority to raise the node to.
+             */
+            void boost(const uint32_t nodeIdx, const TaskPriority priority);
+
+            /**
+             * @brief Computes a topological order of a graph (Kahn's algorithm).
+             *
+             * @param [in] graph The graph to sort.
+             * @param [out] order The nodes, every node after all of its predecessors.
+             * @return true if the graph is acyclic, false if it has a cycle (@p order
+             * then only holds the nodes which are not part of or behind a cycle).
+             */
+            static bool getTopologicalOrder(const CsrGraphView& graph, std::vector<uint32_t>& order);
+
+        private:
+            struct RunState;
+
+            static void executeFrom(ThreadPool& pool, const std::shared_ptr<RunState>& pState, uint32_t nodeIdx);
+            static void submitNode(ThreadPool& pool, const std::shared_ptr<RunState>& pState, const uint32_t nodeIdx);
+
+            ThreadPool& m_pool;
+            std::mutex m_stateMtx;
+            std::shared_ptr<RunState> m_pState;
+    };
+};   // namespace t_pool
+
+#endif  // DAG_EXECUTOR_HPP
@@ -0,0 +1,197 @@
+/**
+ * @file DagJobScheduler.hpp
+ * @brief Fair execution of many concurrent TDAG jobs on one pool.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DAG_JOB_SCHEDULER_HPP
+#define DAG_JOB_SCHEDULER_HPP
+
+#include "TaskDAG.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace t_pool
+{
+    /**
+     * @brief How a DagJobScheduler picks the job whose ready node runs next.
+     */
+    enum class JobSchedulingPolicy : uint32_t
+    {
+        /**
+         * @brief The job with the least remaining work per unit of weight first (weighted
+         * shortest remaining processing time), which minimises the average completion time.
+         * The work is predicted by the cost model of the pool if it has one, else every node
+         * counts as one unit.
+         */
+        SHORTEST_FIRST = 0,
+        /** @brief The job which got the least nodes run per unit of weight first */
+        FAIR_SHARE = 1
+    };
+
+    /** @brief How a job is to be scheduled */
+    struct DagJobOptions
+    {
+        std::string name;
+        /** @brief The share of the job relative to the others, a positive no. */
+        double weight = 1.0;
+        /** @brief The most nodes of the job running at a time */
+        uint32_t maxConcurrency = UINT32_MAX;
+    };
+
+    /** @brief How a job fared, final once the job is done */
+    struct DagJobStats
+    {
+        uint32_t nodeCnt = 0;
+        /** @brief The time its nodes waited, ready, for the scheduler to dispatch them, summed up */
+        std::chrono::nanoseconds totalQueueingDelay = std::chrono::nanoseconds(0);
+        /** @brief The longest a node of the job waited, ready, to be dispatched */
+        std::chrono::nanoseconds maxQueueingDelay = std::chrono::nanoseconds(0);
+        /** @brief From the submission of the job to the dispatch of its first node */
+        std::chrono::nanoseconds startDelay = std::chrono::nanoseconds(0);
+        /** @brief From the submission of the job to the completion of its last node */
+        std::chrono::nanoseconds completionTime = std::chrono::nanoseconds(0);
+
+        inline std::chrono::nanoseconds getMeanQueueingDelay() const noexcept
+            { return nodeCnt ? totalQueueingDelay / nodeCnt : std::chrono::nanoseconds(0); }
+    };
+
+    /**
+     * @class DagJob
+     * @brief The handle of a job submitted to a DagJobScheduler.
+     */
+    class DagJob
+    {
+        public:
+            DagJob() = default;
+
+            /** @brief Waits for all the nodes of the job */
+            inline void wait() const { m_done.wait(); }
+
+            inline bool isDone() const
+                { return m_done.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+            /**
+             * @brief Get the stats of the job. Only to be called once it is done.
+             */
+            inline const DagJobStats& getStats() const noexcept { return *m_pStats; }
+
+            inline uint64_t getJobId() const noexcept { return m_jobId; }
+            inline bool valid() const noexcept { return m_done.valid(); }
+
+        private:
+            friend class DagJobScheduler;
+
+            uint64_t m_jobId = 0;
+            std::shared_future<void> m_done;
+            std::shared_ptr<const DagJobStats> m_pStats;
+    };
+
+    /**
+     * @class DagJobScheduler
+     * @brief Runs many TDAG jobs at once on one pool, interleaving their ready nodes.
+     *
+     * Executing the jobs each with its own TDAG::execute() queues the ready nodes first come
+     * first served, so whichever job starts first holds the workers until it drains. The
+     * scheduler instead keeps the ready nodes of every job itself and only hands the pool
+     * as many as it has workers (see the maxInFlight parameter). Whenever a node completes,
+     * the next one is picked across the jobs as per the policy, skipping the jobs running
+     * as many nodes as their concurrency cap allows.
+     *
+     * The results of the nodes are delivered through the futures of their tasks, as with
+     * TDAG::execute().
+     */
+    class DagJobScheduler
+    {
+        public:
+            /**
+             * @brief Construct a new Dag Job Scheduler object
+             *
+             * @param [in] pool The pool the nodes run on.
+             * @param [in] policy How the next job to run a node of is picked.
+             * @param [in] maxInFlight The most nodes handed to the pool at a time, 0 for its size.
+             */
+            explicit DagJobScheduler(ThreadPool& pool,
+                                     const JobSchedulingPolicy policy = JobSchedulingPolicy::SHORTEST_FIRST,
+                                     const uint32_t maxInFlight = 0);
+
+            /**
+             * @brief Destroy the Dag Job Scheduler object, after all its jobs are done.
+             */
+            ~DagJobScheduler();
+
+            DagJobScheduler(const DagJobScheduler&) = delete;
+            DagJobScheduler& operator=(const DagJobScheduler&) = delete;
+
+            /**
+             * @brief Submits the nodes of a graph as a job. The graph is consumed, as by
+             * TDAG::execute(), it can go away once submitted.
+             *
+             * @param [in] dag The graph.
+             * @param [in] options How the job is to be scheduled.
+             * @return DagJob The handle of the job.
+             * @throw std::logic_error if the graph has a cycle.
+             * @throw std::invalid_argument if the weight isn't positive or the cap is zero.
+             */
+            DagJob submit(TDAG& dag, const DagJobOptions& options = {});
+
+            /** @brief Waits for all the jobs submitted so far */
+            void waitAll();
+
+            /** @brief The no. of jobs submitted and not done yet */
+            size_t getActiveJobCnt() const;
+
+            inline JobSchedulingPolicy getPolicy() const noexcept { return m_policy; }
+            inline uint32_t getMaxInFlight() const noexcept { return m_maxInFlight; }
+
+        private:
+            struct Job;
+            struct Dispatch
+            {
+                std::shared_ptr<Job> pJob;
+                uint32_t nodeIdx;
+            };
+
+            void pickNodes(std::vector<Dispatch>& dispatches);
+            void dispatch(std::vector<Dispatch>& dispatches);
+            void onNodeDone(const std::shared_ptr<Job>& pJob, const uint32_t nodeIdx);
+
+            ThreadPool& m_pool;
+            const JobSchedulingPolicy m_policy;
+            const uint32_t m_maxInFlight;
+            mutable std::mutex m_mtx;
+            std::condition_variable m_idleCv;
+            /** @brief The jobs not done yet, in submission order */
+            std::vector<std::shared_ptr<Job>> m_jobs;
+            uint32_t m_inFlightCnt = 0;
+            uint64_t m_nextJobId = 1;
+    };
+};   // namespace t_pool
+
+#endif  // DAG_JOB_SCHEDULER_HPP
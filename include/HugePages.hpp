@@ -0,0 +1,96 @@
+/**
+ * @file HugePages.hpp
+ * @brief Huge page backed memory for the task slabs and the queue rings.
+ *
+ * Large, long lived and randomly accessed regions (buffer slabs, shared memory rings) cost
+ * a TLB miss per 4 KiB page touched. Backing them with 2 MiB pages cuts the no. of TLB
+ * entries needed by a factor of 512. Explicit huge pages (`MAP_HUGETLB`) need pages to be
+ * reserved by the administrator, transparent huge pages (`madvise(MADV_HUGEPAGE)`) depend
+ * on the kernel settings, so every request falls back to the next best backing silently.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HUGE_PAGES_HPP
+#define HUGE_PAGES_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace t_pool
+{
+    /**
+     * @brief How memory is backed, in the order of preference of the fallbacks.
+     */
+    enum class HugePageMode : uint32_t
+    {
+        /** @brief Regular pages */
+        OFF = 0,
+        /** @brief Transparent huge pages, madvise(MADV_HUGEPAGE) */
+        TRANSPARENT = 1,
+        /** @brief Reserved huge pages, mmap(MAP_HUGETLB) */
+        EXPLICIT = 2
+    };
+
+    /** @brief The huge page size assumed for rounding, the common 2 MiB */
+    constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    /**
+     * @brief A region obtained from allocateHugePages().
+     */
+    struct HugePageRegion
+    {
+        void* pData = nullptr;
+        size_t size = 0;
+        /** @brief The backing actually obtained, may be weaker than requested */
+        HugePageMode backing = HugePageMode::OFF;
+    };
+
+    /**
+     * @brief Maps an anonymous, zero filled region, huge page backed if possible.
+     * EXPLICIT falls back to TRANSPARENT which falls back to regular pages.
+     *
+     * @param [in] size The size in bytes, rounded up to HUGE_PAGE_SIZE unless mode is OFF.
+     * @param [in] mode The backing wanted.
+     * @return HugePageRegion The region, to be released with freeHugePages().
+     * @throw std::bad_alloc if no memory could be mapped at all.
+     */
+    HugePageRegion allocateHugePages(const size_t size, const HugePageMode mode);
+
+    /**
+     * @brief Unmaps a region obtained from allocateHugePages().
+     *
+     * @param [in] region The region to release.
+     */
+    void freeHugePages(const HugePageRegion& region) noexcept;
+
+    /**
+     * @brief Asks the kernel to back an existing mapping with transparent huge pages.
+     * Only the huge page aligned part of the range is advised.
+     *
+     * @param [in] pData The start of the range.
+     * @param [in] size The size of the range in bytes.
+     * @return true if the advice has been taken.
+     */
+    bool adviseHugePages(void* pData, const size_t size) noexcept;
+};   // namespace t_pool
+
+#endif  // HUGE_PAGES_HPP
@@ -0,0 +1,190 @@
+/**
+ * @file MemoryGroup.hpp
+ * @brief Attribution of memory to task groups, with per group budgets.
+ *
+ * Tasks submitted to a MemoryGroup (ThreadPool::submitToGroup()) run with their group set as
+ * the current group of the worker. Memory obtained through the pool's allocators, i.e. the
+ * BufferPool and TrackedAllocator, while a group is current is charged to that group and
+ * credited back when it is freed, so the groups causing memory spikes show up in the stats.
+ * A group over its budget makes the submissions to it fail or wait.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MEMORY_GROUP_HPP
+#define MEMORY_GROUP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+namespace t_pool
+{
+    /**
+     * @class MemoryGroup
+     * @brief A group of tasks whose memory is accounted together, optionally within a budget.
+     *
+     * The counters are plain atomics, charging and crediting never block nor fail. The
+     * budget is enforced when tasks are submitted to the group: while the group uses more
+     * than its limit, a submission either throws or is deferred by the pool until the
+     * usage has dropped back within the limit.
+     */
+    class MemoryGroup : public std::enable_shared_from_this<MemoryGroup>
+    {
+        public:
+            /** @brief What a submission to a group over its budget does */
+            enum class OverBudget : uint32_t
+            {
+                /** @brief The submission throws std::runtime_error */
+                FAIL = 0,
+                /** @brief The task is held back until the group is within its budget again */
+                DEFER = 1
+            };
+
+            /**
+             * @brief Construct a new Memory Group object
+             *
+             * @param [in] name The name of the group, e.g. the kind of tasks in it.
+             * @param [in] limit The budget in bytes, unlimited by default.
+             * @param [in] overBudget What submissions do while the group exceeds its budget.
+             */
+            explicit MemoryGroup(std::string_view name,
+                                 const size_t limit = std::numeric_limits<size_t>::max(),
+                                 const OverBudget overBudget = OverBudget::FAIL)
+                : m_name(name)
+                , m_limit(limit)
+                , m_overBudget(overBudget)
+            {}
+
+            MemoryGroup(const MemoryGroup&) = delete;
+            MemoryGroup& operator=(const MemoryGroup&) = delete;
+
+            /**
+             * @brief Charges an allocation to the group.
+             *
+             * @param [in] bytes The size of the allocation.
+             */
+            void charge(const size_t bytes) noexcept
+            {
+                auto used = m_usedBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                m_allocationCnt.fetch_add(1, std::memory_order_relaxed);
+                auto peak = m_peakBytes.load(std::memory_order_relaxed);
+                while (used > peak && !m_peakBytes.compare_exchange_weak(peak, used, std::memory_order_relaxed));
+            }
+
+            /**
+             * @brief Credits a deallocation back to the group.
+             *
+             * @param [in] bytes The size of the allocation, as charged.
+             */
+            inline void release(const size_t bytes) noexcept { m_usedBytes.fetch_sub(bytes, std::memory_order_relaxed); }
+
+            inline const std::string& getName() const noexcept { return m_name; }
+            inline size_t getLimit() const noexcept { return m_limit; }
+            inline OverBudget getOverBudget() const noexcept { return m_overBudget; }
+            inline size_t getUsedBytes() const noexcept { return m_usedBytes.load(std::memory_order_relaxed); }
+            inline size_t getPeakBytes() const noexcept { return m_peakBytes.load(std::memory_order_relaxed); }
+            inline uint64_t getAllocationCnt() const noexcept { return m_allocationCnt.load(std::memory_order_relaxed); }
+            inline bool isOverBudget() const noexcept { return getUsedBytes() > m_limit; }
+
+            /**
+             * @brief Get the group of the task the calling thread is running, if any.
+             *
+             * @return MemoryGroup* The current group or nullptr.
+             */
+            static MemoryGroup* getCurrent() noexcept;
+
+            /**
+             * @class Scope
+             * @brief Makes a group the current one of the calling thread for its lifetime.
+             */
+            class Scope
+            {
+                public:
+                    explicit Scope(MemoryGroup* pGroup) noexcept;
+                    ~Scope();
+
+                    Scope(const Scope&) = delete;
+                    Scope& operator=(const Scope&) = delete;
+
+                private:
+                    MemoryGroup* m_pPrevious;
+            };
+
+        private:
+            std::string m_name;
+            size_t m_limit;
+            OverBudget m_overBudget;
+            std::atomic<size_t> m_usedBytes = 0;
+            std::atomic<size_t> m_peakBytes = 0;
+            std::atomic<uint64_t> m_allocationCnt = 0;
+    };
+
+    /**
+     * @brief A standard allocator charging the group current at its construction.
+     * Containers using it attribute their memory to the task which created them.
+     *
+     * @tparam T The type of the elements allocated.
+     */
+    template <typename T>
+    class TrackedAllocator
+    {
+        public:
+            using value_type = T;
+
+            TrackedAllocator() noexcept
+                : m_pGroup(MemoryGroup::getCurrent() ? MemoryGroup::getCurrent()->weak_from_this().lock() : nullptr)
+            {}
+            explicit TrackedAllocator(std::shared_ptr<MemoryGroup> pGroup) noexcept : m_pGroup(std::move(pGroup)) {}
+            template <typename U>
+            TrackedAllocator(const TrackedAllocator<U>& rhs) noexcept : m_pGroup(rhs.getGroup()) {}
+
+            T* allocate(const size_t count)
+            {
+                auto pData = std::allocator<T>().allocate(count);
+                if (m_pGroup)
+                    m_pGroup->charge(count * sizeof(T));
+                return pData;
+            }
+
+            void deallocate(T* pData, const size_t count) noexcept
+            {
+                std::allocator<T>().deallocate(pData, count);
+                if (m_pGroup)
+                    m_pGroup->release(count * sizeof(T));
+            }
+
+            inline const std::shared_ptr<MemoryGroup>& getGroup() const noexcept { return m_pGroup; }
+
+            template <typename U>
+            inline bool operator==(const TrackedAllocator<U>& rhs) const noexcept { return m_pGroup == rhs.getGroup(); }
+
+        private:
+            std::shared_ptr<MemoryGroup> m_pGroup;
+    };
+};   // namespace t_pool
+
+#endif  // MEMORY_GROUP_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file MpscQueue.hpp
+ * @brief An unbounded lock-free multi-producer single-consumer queue.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace t_pool
+{
+    /**
+     * @class MpscQueue
+     * @brief A linked queue any no. of threads push into and one thread at a time pops from.
+     *
+     * Pushing is a single atomic exchange on the head, so producers never wait for each other
+     * nor for the consumer. The queue always holds a stub node whose successor is the oldest
+     * value; popping a value turns its node into the new stub and frees the old one.
+     *
+     * @note A push which has swapped the head but not yet linked its node makes the queue look
+     * empty to the consumer until the link is stored, even though values follow.
+     *
+     * @tparam T The type of the values, it must be movable.
+     */
+    template <typename T>
+    class MpscQueue
+    {
+        public:
+            MpscQueue() : m_pHead(new Node()), m_pTail(m_pHead.load(std::memory_order_relaxed)) {}
+            ~MpscQueue()
+            {
+                while (m_pTail)
+                    delete std::exchange(m_pTail, m_pTail->pNext.load(std::memory_order_relaxed));
+            }
+
+            MpscQueue(const MpscQueue&) = delete;
+            MpscQueue& operator=(const MpscQueue&) = delete;
+
+            /**
+             * @brief Pushes a value, from any thread.
+             *
+             * @param [in] value The value.
+             */
+            void push(T value)
+            {
+                auto pNode = new Node();
+                pNode->value.emplace(std::move(value));
+                auto pPrev = m_pHead.exchange(pNode, std::memory_order_acq_rel);
+                pPrev->pNext.store(pNode, std::memory_order_seq_cst);
+            }
+
+            /**
+             * @brief Pops the oldest value, from the consuming thread only.
+             *
+             * @param [out] value The value popped.
+             * @return true if a value was popped, false if the queue is empty.
+             */
+            bool tryPop(T& value)
+            {
+                auto pNext = m_pTail->pNext.load(std::memory_order_acquire);
+                if (!pNext)
+                    return false;
+                value = std::move(*pNext->value);
+                pNext->value.reset();
+                delete std::exchange(m_pTail, pNext);
+                return true;
+            }
+
+            /**
+             * @brief Checks for values, from the consuming thread only.
+             * The load is sequentially consistent, so that a consumer going idle and then
+             * checking for values can't miss a producer pushing and then checking for idleness.
+             */
+            inline bool isEmpty() const noexcept { return m_pTail->pNext.load(std::memory_order_seq_cst) == nullptr; }
+
+        private:
+            struct Node
+            {
+                std::atomic<Node*> pNext = nullptr;
+                std::optional<T> value;
+            };
+
+            alignas(64) std::atomic<Node*> m_pHead;
+            alignas(64) Node* m_pTail;
+    };
+};   // namespace t_pool
+
+#endif  // MPSC_QUEUE_HPP
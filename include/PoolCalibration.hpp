@@ -0,0 +1,116 @@
+/**
+ * @file PoolCalibration.hpp
+ * @brief Startup calibration choosing the pool parameters for the host.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POOL_CALIBRATION_HPP
+#define POOL_CALIBRATION_HPP
+
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace t_pool
+{
+    /**
+     * @brief What a calibration measured on the host and the pool parameters chosen from it.
+     * Pass it to ThreadPool(poolSize, tuning) to construct a pool with them.
+     */
+    struct PoolTuning
+    {
+        /** @brief The name of the host measured, a cache is only valid for the same */
+        std::string hostName;
+        /** @brief The no. of hardware threads of the host measured, a cache is only valid for the same */
+        ui32 hardwareThreadCnt = 0;
+        /** @brief How late the shortest nap returns: the cost of waking up a sleeping worker */
+        std::chrono::nanoseconds wakeLatency = std::chrono::nanoseconds(0);
+        /** @brief The one way hand off of a cache line between two threads, zero on a single core */
+        std::chrono::nanoseconds lineTransferCost = std::chrono::nanoseconds(0);
+        /** @brief Taking a task out of a locked queue another thread keeps feeding, zero on a single core */
+        std::chrono::nanoseconds stealCost = std::chrono::nanoseconds(0);
+        /** @brief One yield of the calling thread */
+        std::chrono::nanoseconds yieldCost = std::chrono::nanoseconds(0);
+
+        /** @brief The chosen no. of idle rounds a worker yields in before napping */
+        ui32 idleSpinCnt = 0;
+        /** @brief The chosen nap of an idle worker in microseconds */
+        ui32 sleepDuration = 0;
+        /** @brief The chosen queueing mode */
+        QueueMode queueMode = QueueMode::SHARED;
+        /**
+         * @brief Whether PER_CORE may be chosen. Off by default: its workers don't take tasks
+         * from each other, so a task waiting for one it submitted itself never gets it run.
+         */
+        bool allowPerCore = false;
+    };
+
+    /**
+     * @brief Measures the host and chooses the parameters of a pool of @p poolSize workers.
+     * It takes some tens of milliseconds and keeps two threads busy meanwhile.
+     *
+     * @param [in] poolSize The no. of workers of the pool to tune.
+     * @return PoolTuning The measurements and the chosen parameters.
+     */
+    PoolTuning calibratePool(const ui32 poolSize);
+
+    /**
+     * @brief Like calibratePool(poolSize), but the measurements are cached in @p cachePath.
+     * A cache written on a host of the same name and no. of hardware threads is reused
+     * instead of measuring again, otherwise the host is measured and the cache (re)written.
+     *
+     * @param [in] poolSize The no. of workers of the pool to tune.
+     * @param [in] cachePath The file the measurements are cached in.
+     * @return PoolTuning The measurements and the chosen parameters.
+     */
+    PoolTuning calibratePool(const ui32 poolSize, const std::string& cachePath);
+
+    /**
+     * @brief Chooses the pool parameters of @p tuning from its measurements.
+     * The queueing mode is SHARED or SHARDED, PER_CORE only if @p tuning allows it.
+     *
+     * @param [in, out] tuning The measurements, the parameters are filled in.
+     * @param [in] poolSize The no. of workers of the pool to tune.
+     */
+    void choosePoolParameters(PoolTuning& tuning, const ui32 poolSize) noexcept;
+
+    /**
+     * @brief Writes the measurements of a tuning to a file, one per line.
+     *
+     * @return true if written.
+     */
+    bool saveTuning(const PoolTuning& tuning, const std::string& path);
+
+    /**
+     * @brief Loads the measurements written by saveTuning(), the parameters aren't chosen.
+     *
+     * @return true if loaded, false if missing, malformed or measured on another host,
+     * i.e. one of another name (gethostname()) or no. of hardware threads.
+     */
+    bool loadTuning(PoolTuning& tuning, const std::string& path);
+
+    /** @brief The name of the calling host, as recorded by the calibration */
+    std::string getCalibrationHostName();
+};   // namespace t_pool
+
+#endif  // POOL_CALIBRATION_HPP
@@ -0,0 +1,84 @@
+/**
+ * @file SharedPtrSlot.hpp
+ * @brief A shared (or weak) pointer replaced and read by several threads at once.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHARED_PTR_SLOT_HPP
+#define SHARED_PTR_SLOT_HPP
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace t_pool
+{
+    /**
+     * @class SharedPtrSlot
+     * @brief Holds a std::shared_ptr or std::weak_ptr any thread may load or store at any time.
+     *
+     * A copy is taken or swapped in under a spin lock held for a few instructions, the
+     * pointer replaced is released after it. Unlike std::atomic<std::shared_ptr> it is
+     * available with every standard library and known to the thread sanitizer.
+     *
+     * @tparam P The pointer type, std::shared_ptr<T> or std::weak_ptr<T>.
+     */
+    template <typename P>
+    class SharedPtrSlot
+    {
+        public:
+            SharedPtrSlot() = default;
+            SharedPtrSlot(const SharedPtrSlot&) = delete;
+            SharedPtrSlot& operator=(const SharedPtrSlot&) = delete;
+
+            P load() const noexcept
+            {
+                lock();
+                P ptr = m_ptr;
+                m_isLocked.clear(std::memory_order_release);
+                return ptr;
+            }
+
+            void store(P ptr) noexcept
+            {
+                lock();
+                std::swap(m_ptr, ptr);
+                m_isLocked.clear(std::memory_order_release);
+            }   // The pointer replaced is released here, out of the lock
+
+        private:
+            void lock() const noexcept
+            {
+                while (m_isLocked.test_and_set(std::memory_order_acquire))
+                {
+                    while (m_isLocked.test(std::memory_order_relaxed))
+                        std::this_thread::yield();
+                }
+            }
+
+            mutable std::atomic_flag m_isLocked;
+            P m_ptr;
+    };
+};   // namespace t_pool
+
+#endif  // SHARED_PTR_SLOT_HPP
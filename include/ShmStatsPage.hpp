@@ -0,0 +1,158 @@
+/**
+ * @file ShmStatsPage.hpp
+ * @brief Live pool and worker counters published in shared memory for external monitors.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHM_STATS_PAGE_HPP
+#define SHM_STATS_PAGE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace t_pool
+{
+    /** @brief The counters of a pool as a whole */
+    struct PoolStats
+    {
+        /** @brief When they were published, steady clock (CLOCK_MONOTONIC) nanoseconds */
+        uint64_t publishedNs = 0;
+        uint64_t poolSize = 0;
+        /** @brief The tasks submitted and not completed yet */
+        uint64_t taskCnt = 0;
+        uint64_t queuedCnt = 0;
+        uint64_t deferredCnt = 0;
+        uint64_t deadlineMissedCnt = 0;
+        uint64_t yieldCnt = 0;
+    };
+
+    /** @brief The counters of one worker of a pool */
+    struct WorkerStats
+    {
+        /** @brief The tasks the worker has run */
+        uint64_t taskCnt = 0;
+        /** @brief The time the worker has spent running tasks */
+        uint64_t busyNs = 0;
+        /** @brief When the last task completed, steady clock (CLOCK_MONOTONIC) nanoseconds */
+        uint64_t lastTaskEndNs = 0;
+    };
+
+    /**
+     * @class ShmStatsPage
+     * @brief A POSIX shared memory segment exposing the counters of a pool to other processes.
+     *
+     * The pool owning the page (see ThreadPool::setStatsPage()) writes its counters into it,
+     * monitoring processes attach to it by name, read only, and never call into the pool.
+     * Every record (the pool's one and one per worker) sits on its own cache line and is
+     * guarded by a seqlock: its single writer bumps the sequence to odd, writes, and bumps
+     * it to even again, a reader retries while the sequence is odd or has moved under it.
+     * Writers never wait for readers, each worker only writes its own record.
+     */
+    class ShmStatsPage
+    {
+        public:
+            static constexpr char MAGIC[8] = {'T', 'P', 'O', 'O', 'L', 'S', 'T', 'A'};
+            static constexpr uint32_t VERSION = 1;
+
+            /**
+             * @brief Creates a new stats page, zeroed.
+             * The segment is unlinked again when this object is destroyed,
+             * the processes attached by then keep reading the last values.
+             *
+             * @param [in] name The name of the segment, e.g. "/myPoolStats".
+             * @param [in] workerCapacity The no. of worker records, workers beyond them aren't published.
+             * @throw std::runtime_error if the segment exists already or can't be created.
+             */
+            ShmStatsPage(const std::string& name, const uint32_t workerCapacity);
+
+            /**
+             * @brief Attaches read only to a page created by another process (or this one).
+             *
+             * @param [in] name The name the page was created with.
+             * @throw std::runtime_error if there is no such page or it is malformed.
+             */
+            explicit ShmStatsPage(const std::string& name);
+
+            ~ShmStatsPage();
+
+            ShmStatsPage(const ShmStatsPage&) = delete;
+            ShmStatsPage& operator=(const ShmStatsPage&) = delete;
+
+            /**
+             * @brief Publishes the counters of the pool. Only one thread at a time may
+             * publish them, only the creator of the page can.
+             *
+             * @param [in] stats The counters.
+             */
+            void publishPool(const PoolStats& stats) noexcept;
+
+            /**
+             * @brief Accounts a task run by a worker into its record. Only the worker itself
+             * may write its record, only the creator of the page can.
+             *
+             * @param [in] workerIdx The index of the worker, ignored beyond the capacity.
+             * @param [in] busyNs The time the task took.
+             * @param [in] endNs When the task completed, steady clock nanoseconds.
+             */
+            void recordWorkerTask(const uint32_t workerIdx, const uint64_t busyNs, const uint64_t endNs) noexcept;
+
+            /**
+             * @brief Reads a consistent copy of the pool counters.
+             *
+             * @param [out] stats The counters.
+             * @return true if read, false if the record kept changing (or its writer died midway).
+             */
+            bool readPool(PoolStats& stats) const noexcept;
+
+            /**
+             * @brief Reads a consistent copy of the counters of a worker.
+             *
+             * @param [in] workerIdx The index of the worker, below getWorkerCapacity().
+             * @param [out] stats The counters.
+             * @return true if read, false if out of range or the record kept changing.
+             */
+            bool readWorker(const uint32_t workerIdx, WorkerStats& stats) const noexcept;
+
+            inline const std::string& getName() const noexcept { return m_name; }
+            inline uint32_t getWorkerCapacity() const noexcept { return m_workerCapacity; }
+            inline bool isOwner() const noexcept { return m_isOwner; }
+
+        private:
+            struct Header;
+            struct Record;
+
+            void map(const int fd, const size_t size, const bool isWritable);
+            Record& poolRecord() const noexcept;
+            Record& workerRecord(const uint32_t workerIdx) const noexcept;
+
+            std::string m_name;
+            bool m_isOwner = false;
+            uint32_t m_workerCapacity = 0;
+            void* m_pMapping = nullptr;
+            size_t m_mappingSize = 0;
+            Header* m_pHeader = nullptr;
+    };
+};   // namespace t_pool
+
+#endif  // SHM_STATS_PAGE_HPP
@@ -0,0 +1,239 @@
+/**
+ * @file ShmTaskQueue.hpp
+ * @brief A task queue in POSIX shared memory, shared by several processes.
+ *
+ * The queue is a bounded multi-producer multi-consumer ring of fixed size slots living in
+ * a `shm_open()` segment. A slot holds a task descriptor: the name of the handler to run
+ * and an opaque payload. Producers write the payload straight into the slot and consumers
+ * hand the slot's memory to the handler, so a payload is never copied on its way from one
+ * process to another. Handlers are resolved by name in every consumer process through a
+ * ShmHandlerRegistry, so no code pointer ever crosses a process boundary.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHM_TASK_QUEUE_HPP
+#define SHM_TASK_QUEUE_HPP
+
+#include "HugePages.hpp"
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace t_pool
+{
+    /**
+     * @class ShmHandlerRegistry
+     * @brief Maps handler names to the callables consuming the shared memory task descriptors.
+     *
+     * The callable receives the payload of the descriptor, pointing into the shared memory.
+     * It is only valid until the callable returns.
+     */
+    class ShmHandlerRegistry
+    {
+        public:
+            using Handler = std::function<void(const void*, uint32_t)>;
+
+            /**
+             * @brief Registers (or replaces) a handler.
+             *
+             * @param [in] handlerName The name the producers address the handler by.
+             * @param [in] handler The callable to run for the descriptors naming it.
+             * @return ShmHandlerRegistry& Reference to self for chaining.
+             */
+            ShmHandlerRegistry& registerHandler(std::string_view handlerName, Handler handler)
+            {
+                m_handlers[std::string(handlerName)] = std::move(handler);
+                return *this;
+            }
+
+            /**
+             * @brief Looks up a handler.
+             *
+             * @param [in] handlerName The name of the handler.
+             * @return const Handler* The handler or nullptr if not registered.
+             */
+            const Handler* find(std::string_view handlerName) const
+            {
+                auto itr = m_handlers.find(std::string(handlerName));
+                return (itr == m_handlers.end()) ? nullptr : &itr->second;
+            }
+
+        private:
+            std::unordered_map<std::string, Handler> m_handlers;
+    };
+
+    /**
+     * @class ShmTaskQueue
+     * @brief A bounded MPMC ring of task descriptors in POSIX shared memory.
+     *
+     * One process creates the queue, any no. of processes attach to it by name. Every
+     * slot carries a sequence number telling whether it is free, being written, ready
+     * or being consumed, so producers and consumers of all the processes only ever
+     * synchronise through atomics in the segment.
+     *
+     * Producing is done in two steps, beginPush() hands out the payload area of a free
+     * slot and commitPush() publishes it, or in one step with tryPush() which copies the
+     * payload in. serve() dispatches the ready descriptors to the workers of a pool.
+     *
+     * @note A process dying between beginPush() and commitPush() (or while a handler is
+     * running) leaves its slot claimed, which stalls the ring once it wraps around to it.
+     */
+    class ShmTaskQueue
+    {
+        public:
+            static constexpr char MAGIC[8] = {'T', 'P', 'O', 'O', 'L', 'S', 'H', 'M'};
+            static constexpr uint32_t VERSION = 1;
+            static constexpr size_t MAX_HANDLER_NAME_LENGTH = 39;
+
+            /** @brief The payload area of a claimed slot, to be passed to commitPush() */
+            struct WriteSlot
+            {
+                void* pData = nullptr;
+                uint32_t capacity = 0;
+                uint64_t pos = 0;
+
+                inline explicit operator bool() const noexcept { return pData != nullptr; }
+            };
+
+            /** @brief A descriptor taken off the queue, to be passed to release() */
+            struct ReadSlot
+            {
+                std::string_view handlerName;
+                const void* pData = nullptr;
+                uint32_t size = 0;
+                uint64_t pos = 0;
+            };
+
+            /**
+             * @brief Creates a new shared memory queue.
+             * The segment is unlinked again when this object is destroyed,
+             * the processes attached by then keep using it.
+             *
+             * @param [in] name The name of the segment, e.g. "/myQueue".
+             * @param [in] slotCnt The no. of slots, rounded up to a power of two.
+             * @param [in] slotSize The max payload size of a slot in bytes.
+             * @param [in] hugePages Whether to advise transparent huge pages for the ring, to all
+             * the attaching processes as well. Explicit huge pages need a hugetlbfs mount, so
+             * EXPLICIT is taken for TRANSPARENT here.
+             * @throw std::runtime_error if the segment exists already or can't be created.
+             */
+            ShmTaskQueue(const std::string& name,
+                         const uint32_t slotCnt,
+                         const uint32_t slotSize,
+                         const HugePageMode hugePages = HugePageMode::OFF);
+
+            /**
+             * @brief Attaches to a queue created by another process (or this one).
+             *
+             * @param [in] name The name the queue was created with.
+             * @throw std::runtime_error if there is no such queue or it is malformed.
+             */
+            explicit ShmTaskQueue(const std::string& name);
+            ~ShmTaskQueue();
+
+            ShmTaskQueue(const ShmTaskQueue&) = delete;
+            ShmTaskQueue& operator=(const ShmTaskQueue&) = delete;
+
+            /**
+             * @brief Claims a free slot to write a descriptor into.
+             *
+             * @param [in] handlerName The name of the handler consuming the descriptor.
+             * @param [in] payloadSize The size of the payload, at most getSlotSize().
+             * @return WriteSlot The payload area, empty if the queue is full.
+             * @throw std::invalid_argument if the name or the payload doesn't fit a slot.
+             */
+            WriteSlot beginPush(std::string_view handlerName, const uint32_t payloadSize);
+
+            /**
+             * @brief Publishes a slot claimed by beginPush() to the consumers.
+             *
+             * @param [in] slot The slot, written completely.
+             */
+            void commitPush(const WriteSlot& slot);
+
+            /**
+             * @brief Pushes a descriptor, copying the payload into the slot.
+             *
+             * @param [in] handlerName The name of the handler consuming the descriptor.
+             * @param [in] pPayload The payload.
+             * @param [in] payloadSize The size of the payload, at most getSlotSize().
+             * @return true if pushed, false if the queue is full.
+             */
+            bool tryPush(std::string_view handlerName, const void* pPayload, const uint32_t payloadSize);
+
+            /**
+             * @brief Takes the oldest ready descriptor off the queue.
+             * The slot stays owned by the caller until release() is called.
+             *
+             * @param [out] slot The descriptor, pointing into the shared memory.
+             * @return true if a descriptor was taken, false if none is ready.
+             */
+            bool tryPop(ReadSlot& slot);
+
+            /**
+             * @brief Hands a slot taken by tryPop() back to the producers.
+             *
+             * @param [in] slot The descriptor consumed.
+             */
+            void release(const ReadSlot& slot);
+
+            /**
+             * @brief Dispatches the ready descriptors to the workers of a pool.
+             * Each descriptor becomes one task running its handler on the payload in
+             * place. Descriptors naming unknown handlers are dropped. The queue and
+             * the registry must outlive the dispatched tasks.
+             *
+             * @param [in] pool The thread pool to run the handlers on.
+             * @param [in] registry The handlers known to this process.
+             * @param [in] maxTasks The max no. of descriptors to dispatch.
+             * @return size_t The no. of descriptors taken off the queue.
+             */
+            size_t serve(ThreadPool& pool, const ShmHandlerRegistry& registry, const size_t maxTasks);
+
+            inline uint32_t getSlotCnt() const noexcept { return m_slotCnt; }
+            inline uint32_t getSlotSize() const noexcept { return m_slotSize; }
+
+        private:
+            struct Header;
+            struct SlotHeader;
+
+            void map(const int fd, const size_t size);
+            SlotHeader& slotAt(const uint64_t pos) const noexcept;
+
+            std::string m_name;
+            bool m_isOwner = false;
+            void* m_pMapping = nullptr;
+            size_t m_mappingSize = 0;
+            Header* m_pHeader = nullptr;
+            char* m_pSlots = nullptr;
+            uint32_t m_slotCnt = 0;
+            uint32_t m_slotSize = 0;
+            uint32_t m_slotStride = 0;
+    };
+};   // namespace t_pool
+
+#endif  // SHM_TASK_QUEUE_HPP
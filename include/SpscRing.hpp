@@ -0,0 +1,122 @@
+/**
+ * @file SpscRing.hpp
+ * @brief A bounded lock-free single-producer single-consumer ring.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace t_pool
+{
+    /**
+     * @class SpscRing
+     * @brief A fixed capacity ring one thread pushes into and one other thread pops from.
+     *
+     * The producer owns the tail index and the consumer the head index, each on its own cache
+     * line. Both keep a cached copy of the other side's index and only reload it when the ring
+     * looks full (or empty), so in the steady state a push or a pop touches no shared line
+     * except the slot itself.
+     *
+     * @tparam T The type of the values, it must be movable and default constructible.
+     */
+    template <typename T>
+    class SpscRing
+    {
+        public:
+            /**
+             * @brief Construct a new Spsc Ring object
+             *
+             * @param [in] capacity The max no. of values, rounded up to a power of two.
+             */
+            explicit SpscRing(const size_t capacity)
+                : m_capacity(std::bit_ceil(capacity ? capacity : 1))
+                , m_mask(m_capacity - 1)
+                , m_pSlots(std::make_unique<T[]>(m_capacity))
+            {}
+
+            SpscRing(const SpscRing&) = delete;
+            SpscRing& operator=(const SpscRing&) = delete;
+
+            /**
+             * @brief Pushes a value, from the producing thread only.
+             *
+             * @param [in] value The value, left untouched if not pushed.
+             * @return true if pushed, false if the ring is full.
+             */
+            bool tryPush(T& value)
+            {
+                auto tail = m_tail.load(std::memory_order_relaxed);
+                if (tail - m_cachedHead == m_capacity)
+                {
+                    m_cachedHead = m_head.load(std::memory_order_acquire);
+                    if (tail - m_cachedHead == m_capacity)
+                        return false;
+                }
+                m_pSlots[tail & m_mask] = std::move(value);
+                m_tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /**
+             * @brief Pops the oldest value, from the consuming thread only.
+             *
+             * @param [out] value The value popped.
+             * @return true if a value was popped, false if the ring is empty.
+             */
+            bool tryPop(T& value)
+            {
+                auto head = m_head.load(std::memory_order_relaxed);
+                if (head == m_cachedTail)
+                {
+                    m_cachedTail = m_tail.load(std::memory_order_acquire);
+                    if (head == m_cachedTail)
+                        return false;
+                }
+                value = std::move(m_pSlots[head & m_mask]);
+                m_pSlots[head & m_mask] = T();
+                m_head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            inline size_t getCapacity() const noexcept { return m_capacity; }
+
+        private:
+            const size_t m_capacity;
+            const size_t m_mask;
+            std::unique_ptr<T[]> m_pSlots;
+            // Written by the consumer
+            alignas(64) std::atomic<size_t> m_head = 0;
+            size_t m_cachedTail = 0;
+            // Written by the producer
+            alignas(64) std::atomic<size_t> m_tail = 0;
+            size_t m_cachedHead = 0;
+    };
+};   // namespace t_pool
+
+#endif  // SPSC_RING_HPP
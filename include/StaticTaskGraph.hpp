@@ -0,0 +1,321 @@
+/**
+ * @file StaticTaskGraph.hpp
+ * @brief Task graphs fixed at compile time, nodes being types and edges type lists.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef STATIC_TASK_GRAPH_HPP
+#define STATIC_TASK_GRAPH_HPP
+
+#include "ThreadPool.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace t_pool
+{
+    /** @brief A compile time list of types */
+    template <typename ...Ts>
+    struct TypeList {};
+
+    /**
+     * @brief A node of a StaticTaskGraph along with the nodes it depends upon.
+     *
+     * @tparam Node The node, a default constructible type with a `void operator()()`.
+     * @tparam Deps The nodes which have to finish before this one runs.
+     */
+    template <typename Node, typename ...Deps>
+    struct StaticNode
+    {
+        using Type = Node;
+        using DepList = TypeList<Deps...>;
+        static constexpr uint32_t DEP_CNT = sizeof...(Deps);
+    };
+
+    /**
+     * @brief Get the index of a type within a list of types.
+     *
+     * @return uint32_t The index, the no. of types if it is not in the list.
+     */
+    template <typename T, typename ...Ts>
+    constexpr uint32_t getTypeIdx() noexcept
+    {
+        uint32_t idx = 0;
+        bool isFound = ((std::is_same_v<T, Ts> ? true : (++idx, false)) || ...);
+        return isFound ? idx : static_cast<uint32_t>(sizeof...(Ts));
+    }
+
+    /**
+     * @brief The shape of a StaticTaskGraph, computed at compile time.
+     * The successors of node `n` are `targets[offsets[n] .. offsets[n + 1])`.
+     */
+    template <uint32_t NodeCnt, uint32_t EdgeCnt>
+    struct StaticGraphLayout
+    {
+        std::array<uint32_t, NodeCnt> depCnts = {};
+        std::array<uint32_t, NodeCnt + 1> offsets = {};
+        std::array<uint32_t, EdgeCnt + 1> targets = {};
+        bool hasUnknownDep = false;
+        bool hasDuplicateNode = false;
+        bool isAcyclic = false;
+    };
+
+    /**
+     * @brief Lays out the graph of the given StaticNode entries.
+     */
+    template <typename ...Entries>
+    constexpr auto makeStaticGraphLayout() noexcept
+    {
+        constexpr uint32_t NODE_CNT = sizeof...(Entries);
+        constexpr uint32_t EDGE_CNT = (Entries::DEP_CNT + ... + 0);
+        StaticGraphLayout<NODE_CNT, EDGE_CNT> layout;
+        std::array<uint32_t, EDGE_CNT + 1> srcs = {};
+        std::array<uint32_t, EDGE_CNT + 1> dsts = {};
+        uint32_t edgeIdx = 0;
+        uint32_t nodeIdx = 0;
+        auto addEdges = [&]<typename ...Deps>(TypeList<Deps...>)
+        {
+            ((srcs[edgeIdx] = getTypeIdx<Deps, typename Entries::Type...>(), dsts[edgeIdx] = nodeIdx, ++edgeIdx), ...);
+        };
+        ((addEdges(typename Entries::DepList{}), ++nodeIdx), ...);
+
+        std::array<uint32_t, NODE_CNT> typeIdxs = {getTypeIdx<typename Entries::Type, typename Entries::Type...>()...};
+        for (uint32_t idx = 0; idx < NODE_CNT; ++idx)
+            layout.hasDuplicateNode |= (typeIdxs[idx] != idx);
+        for (uint32_t idx = 0; idx < EDGE_CNT; ++idx)
+            layout.hasUnknownDep |= (srcs[idx] >= NODE_CNT);
+        if (layout.hasUnknownDep)
+            return layout;
+
+        // Successors in CSR form, grouped by their dependency
+        for (uint32_t idx = 0; idx < EDGE_CNT; ++idx)
+        {
+            ++layout.depCnts[dsts[idx]];
+            ++layout.offsets[srcs[idx] + 1];
+        }
+        for (uint32_t idx = 0; idx < NODE_CNT; ++idx)
+            layout.offsets[idx + 1] += layout.offsets[idx];
+        std::array<uint32_t, NODE_CNT> fill = {};
+        for (uint32_t idx = 0; idx < EDGE_CNT; ++idx)
+            layout.targets[layout.offsets[srcs[idx]] + fill[srcs[idx]]++] = dsts[idx];
+
+        // Kahn's algorithm, all the nodes get sorted unless there is a cycle
+        auto pendingCnts = layout.depCnts;
+        std::array<uint32_t, NODE_CNT> ready = {};
+        uint32_t readyCnt = 0;
+        for (uint32_t idx = 0; idx < NODE_CNT; ++idx)
+        {
+            if (!pendingCnts[idx])
+                ready[readyCnt++] = idx;
+        }
+        for (uint32_t head = 0; head < readyCnt; ++head)
+        {
+            for (auto edge = layout.offsets[ready[head]]; edge < layout.offsets[ready[head] + 1]; ++edge)
+            {
+                if (!--pendingCnts[layout.targets[edge]])
+                    ready[readyCnt++] = layout.targets[edge];
+            }
+        }
+        layout.isAcyclic = (readyCnt == NODE_CNT);
+        return layout;
+    }
+
+    /**
+     * @class StaticTaskGraph
+     * @brief A task graph described at compile time, executed on a ThreadPool.
+     *
+     * The layout of the graph (dependency counts, successors in CSR form) is computed by the
+     * compiler, which also rejects unknown dependencies, duplicate nodes and cycles. At run
+     * time the graph keeps its dependency counters in a fixed size array and dispatches the
+     * nodes through a table of functions, so executing it neither hashes nor allocates
+     * anything besides the pool's tasks. It complements Task_As_DAG for the graphs whose
+     * shape is known upfront.
+     *
+     * The graph owns one instance of every node type, the nodes keep their results in them
+     * (see getNode()). As with DagExecutor, a node releasing several successors executes the
+     * first one inline and submits the others, and the first exception thrown by a node is
+     * rethrown by run() once the graph has drained, the nodes behind it being skipped.
+     *
+     * @code
+     * using Graph = StaticTaskGraph<StaticNode<Load>,
+     *                               StaticNode<Parse, Load>,
+     *                               StaticNode<Index, Parse>,
+     *                               StaticNode<Report, Parse, Index>>;
+     * Graph graph;
+     * graph.run(pool);
+     * @endcode
+     *
+     * @note run() blocks the calling thread until the whole graph is done, so it must not
+     * be called from a worker of the same pool, nor twice at the same time.
+     *
+     * @tparam Entries The StaticNode entries, a node's dependencies may be listed in any order.
+     */
+    template <typename ...Entries>
+    class StaticTaskGraph
+    {
+        public:
+            static constexpr uint32_t NODE_CNT = sizeof...(Entries);
+            static constexpr uint32_t EDGE_CNT = (Entries::DEP_CNT + ... + 0);
+
+            static_assert(NODE_CNT > 0, "A static task graph needs at least one node");
+
+            /**
+             * @brief Get the index of a node type within the graph.
+             *
+             * @tparam Node The node type.
+             * @return uint32_t The index, NODE_CNT if the type is not a node of the graph.
+             */
+            template <typename Node>
+            static constexpr uint32_t getNodeIdx() noexcept { return getTypeIdx<Node, typename Entries::Type...>(); }
+
+            static constexpr StaticGraphLayout<NODE_CNT, EDGE_CNT> LAYOUT = makeStaticGraphLayout<Entries...>();
+
+            static_assert(!LAYOUT.hasDuplicateNode, "A node type is listed more than once");
+            static_assert(!LAYOUT.hasUnknownDep, "A dependency is not a node of the graph");
+            static_assert(LAYOUT.hasUnknownDep || LAYOUT.isAcyclic, "The static task graph has a cycle");
+
+            StaticTaskGraph() = default;
+            StaticTaskGraph(const StaticTaskGraph&) = delete;
+            StaticTaskGraph& operator=(const StaticTaskGraph&) = delete;
+
+            /**
+             * @brief Executes every node on the pool, each after its dependencies,
+             * and waits for all of them. The graph can be run again afterwards.
+             *
+             * @param [in] pool The thread pool the nodes are executed on.
+             * @throw The first exception thrown by a node.
+             */
+            void run(ThreadPool& pool)
+            {
+                m_pPool = &pool;
+                for (uint32_t idx = 0; idx < NODE_CNT; ++idx)
+                    m_pendingCnts[idx].store(LAYOUT.depCnts[idx], std::memory_order_relaxed);
+                m_pError = nullptr;
+                m_isFailed.store(false, std::memory_order_relaxed);
+                m_remainingCnt.store(NODE_CNT, std::memory_order_relaxed);
+                m_inFlightCnt.store(0, std::memory_order_relaxed);
+
+                for (uint32_t idx = 0; idx < NODE_CNT; ++idx)
+                {
+                    if (!LAYOUT.depCnts[idx])
+                        submitNode(idx);
+                }
+                for (auto remaining = m_remainingCnt.load(std::memory_order_acquire); remaining;
+                     remaining = m_remainingCnt.load(std::memory_order_acquire))
+                    m_remainingCnt.wait(remaining, std::memory_order_acquire);
+                // The last node may still be notifying, wait for it to be off the graph
+                while (m_inFlightCnt.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                if (m_isFailed.load(std::memory_order_relaxed))
+                    std::rethrow_exception(m_pError);
+            }
+
+            /**
+             * @brief Get the instance of a node type owned by the graph, e.g. to read its results.
+             *
+             * @tparam Node The node type.
+             */
+            template <typename Node>
+            inline Node& getNode() noexcept
+            {
+                static_assert(getNodeIdx<Node>() < NODE_CNT, "Not a node of the graph");
+                return std::get<getNodeIdx<Node>()>(m_nodes);
+            }
+
+        private:
+            using NodeRunner = void (*)(StaticTaskGraph&);
+
+            template <size_t ...Idxs>
+            static constexpr std::array<NodeRunner, NODE_CNT> makeRunners(std::index_sequence<Idxs...>) noexcept
+            {
+                return {[](StaticTaskGraph& graph) { std::get<Idxs>(graph.m_nodes)(); }...};
+            }
+
+            void submitNode(const uint32_t nodeIdx)
+            {
+                m_inFlightCnt.fetch_add(1, std::memory_order_relaxed);
+                m_pPool->submit([this, nodeIdx]()
+                {
+                    executeFrom(nodeIdx);
+                    m_inFlightCnt.fetch_sub(1, std::memory_order_release);  // Last touch of the graph
+                });
+            }
+
+            /**
+             * @brief Executes a node, then the first successor it releases inline and so on,
+             * submitting the other successors released on the way.
+             */
+            void executeFrom(uint32_t nodeIdx)
+            {
+                static constexpr auto RUNNERS = makeRunners(std::make_index_sequence<NODE_CNT>{});
+                while (true)
+                {
+                    if (!m_isFailed.load(std::memory_order_relaxed))
+                    {
+                        try
+                        {
+                            RUNNERS[nodeIdx](*this);
+                        }
+                        catch (...)
+                        {
+                            if (!m_isFailed.exchange(true, std::memory_order_relaxed))
+                                m_pError = std::current_exception();
+                        }
+                    }
+
+                    auto nextIdx = NODE_CNT;
+                    for (auto edge = LAYOUT.offsets[nodeIdx]; edge < LAYOUT.offsets[nodeIdx + 1]; ++edge)
+                    {
+                        auto succIdx = LAYOUT.targets[edge];
+                        if (m_pendingCnts[succIdx].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                            continue;
+                        if (nextIdx == NODE_CNT)
+                            nextIdx = succIdx;
+                        else
+                            submitNode(succIdx);
+                    }
+                    if (m_remainingCnt.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        m_remainingCnt.notify_all();
+                    if (nextIdx == NODE_CNT)
+                        return;
+                    nodeIdx = nextIdx;
+                }
+            }
+
+            std::tuple<typename Entries::Type...> m_nodes;
+            std::array<std::atomic<uint32_t>, NODE_CNT> m_pendingCnts = {};
+            std::atomic<uint32_t> m_remainingCnt = 0;
+            std::atomic<uint32_t> m_inFlightCnt = 0;
+            std::atomic_bool m_isFailed = false;
+            std::exception_ptr m_pError;
+            ThreadPool* m_pPool = nullptr;
+    };
+};   // namespace t_pool
+
+#endif  // STATIC_TASK_GRAPH_HPP
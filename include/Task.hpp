@@ -26,6 +26,9 @@
 #ifndef TASK_HPP
 #define TASK_HPP
 
+#include "MemoryGroup.hpp"
+#include "TaskContext.hpp"
+
 #include <logger/LOGGER_MACROS.hpp>
 
 #include <future>
@@ -34,6 +37,7 @@
 #include <any>
 #include <utility>
 #include <atomic>
+#include <cstdint>
 
 using namespace logger;
 
@@ -53,8 +57,10 @@ namespace t_pool
      * - Conversion to a std::function for flexible scheduling.
      * - Assignment and retrieval of a human-readable task name.
      * - Thread-safe generation of unique task IDs.
+     * - Idempotent tasks may be run more than once concurrently (speculative execution),
+     *   the first run to finish publishes the result and the later ones are discarded.
      *
-     * @note The callable and its arguments must be copyable types, as they are stored in a std::packaged_task.
+     * @note The callable and its arguments must be copyable types, as they are stored in a std::function.
      *       Move semantics are not supported for return and argument types.
      */
     class Task
@@ -72,9 +78,18 @@ namespace t_pool
             Task(Task&& rhs)
             {
                 m_task = std::move(rhs.m_task);
+                m_promise = std::move(rhs.m_promise);
                 m_future = std::move(rhs.m_future);
                 m_taskName = std::move(rhs.m_taskName);
                 m_taskId.store(rhs.m_taskId);
+                m_completed.store(rhs.m_completed);
+                m_idempotent = rhs.m_idempotent;
+                m_pMemoryGroup = std::move(rhs.m_pMemoryGroup);
+                m_pDataHint = rhs.m_pDataHint;
+                m_context = rhs.m_context;
+                m_priority.store(rhs.m_priority);
+                m_queueIdx.store(rhs.m_queueIdx);
+                m_isClaimed.store(rhs.m_isClaimed);
                 rhs.m_taskId.store(0);
             }
 
@@ -120,11 +135,11 @@ namespace t_pool
              * @brief Submits a callable task with arguments to be executed asynchronously.
              *
              * This template method accepts any callable object (function, lambda, functor) and its arguments,
-             * binds them together, and wraps the invocation in a std::packaged_task that returns a std::any.
+             * binds them together, and wraps the invocation in a std::function that returns a std::any.
              * The result type is deduced using std::invoke_result_t. If the callable returns void, an empty
              * std::any is returned; otherwise, the result is returned as std::any.
              *
-             * The future associated with the packaged task is stored in m_future, and the packaged task itself
+             * The future associated with the task's promise is stored in m_future, and the wrapped callable
              * is stored in m_task for later execution. A unique task ID is assigned via nextTaskId().
              *
              * @tparam F Type of the callable object.
@@ -133,7 +148,7 @@ namespace t_pool
              * @param args Arguments to pass to the callable object.
              *
              * @note Please keep in mind that the return and argument types of the callable must be copyable,
-             * as it will be stored in a packaged_task.
+             * as it will be stored in a std::function.
              * What it means is either you can have premitive types or types that have copy constructor defined.
              * Or, a derived class that implements the copy constructor. Move semantics are not supported here
              * for return and arguments types. So use std shared_ptr in place of unique_ptr or raw pointers.
@@ -144,12 +159,10 @@ namespace t_pool
                 LOG_ENTRY_DBG();
                 using Result = std::invoke_result_t<F, Args...>;
                 auto boundFunc = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-                // Wrap the bound function in a packaged_task that returns std::any
-                // The lambda inside the packaged_task handles both void and non-void return types
-                // by checking if Result is void at compile time. Use constructor as assignment or
-                // copy initialization does not work with std::packaged_task.
-                std::packaged_task<std::any()> packagedTask(
-                [boundFunc]() -> std::any
+                // Wrap the bound function in a callable that returns std::any
+                // The lambda handles both void and non-void return types
+                // by checking if Result is void at compile time.
+                m_task = [boundFunc]() -> std::any
                 {
                     if constexpr (std::is_void_v<Result>)
                     {
@@ -160,10 +173,11 @@ namespace t_pool
                     {
                         return boundFunc();
                     }
-                });
+                };
                 m_taskId.store(nextTaskId());
-                m_future = packagedTask.get_future();
-                m_task = std::move(packagedTask);
+                m_promise = std::promise<std::any>();
+                m_future = m_promise.get_future();
+                m_completed = false;
                 LOG_EXIT_DBG();
             }
 
@@ -180,9 +194,9 @@ namespace t_pool
             {
                 LOG_ENTRY_DBG();
                 std::any result;
-                if (m_task.valid())
+                if (m_task)
                 {
-                    m_task();
+                    runAndForget();
                     result = m_future.get();
                 }
                 LOG_EXIT_DBG();
@@ -195,17 +209,59 @@ namespace t_pool
              * This method runs the task if it has been submitted and is valid. It does not wait for the task
              * to complete or retrieve its result. If the task has not been submitted or is invalid, this method
              * does nothing.
+             *
+             * It is safe to call this concurrently from several threads for an idempotent task. Every call
+             * executes the callable, but only the first one to finish publishes its result (or exception)
+             * to the future.
+             *
+             * @return true if this call published the task's result, false otherwise.
              */
-            void runAndForget()
+            bool runAndForget()
             {
                 LOG_ENTRY_DBG();
-                if (m_task.valid())
+                auto published = false;
+                if (m_task)
                 {
-                    m_task();
+                    try
+                    {
+                        auto result = m_task();
+                        if (!m_completed.exchange(true))
+                        {
+                            m_promise.set_value(std::move(result));
+                            published = true;
+                        }
+                    }
+                    catch (...)
+                    {
+                        if (!m_completed.exchange(true))
+                        {
+                            m_promise.set_exception(std::current_exception());
+                            published = true;
+                        }
+                    }
                 }
                 LOG_EXIT_DBG();
+                return published;
             }
 
+            /**
+             * @brief Whether the task's result (or exception) has been published.
+             */
+            inline bool isCompleted() const noexcept { return m_completed; }
+
+            /**
+             * @brief Marks the task as idempotent, i.e. safe to be executed more than once
+             * and concurrently. Only idempotent tasks are considered for speculative execution.
+             *
+             * @param idempotent TRUE if the task is idempotent.
+             */
+            inline void setIdempotent(const bool idempotent) noexcept { m_idempotent = idempotent; }
+
+            /**
+             * @brief Whether the task has been marked as idempotent.
+             */
+            inline bool isIdempotent() const noexcept { return m_idempotent; }
+
             /**
              * @brief Sets the human-readable name for the task.
              * 
@@ -220,11 +276,133 @@ namespace t_pool
              */
             inline std::string getTaskName() const noexcept { return m_taskName; }
 
+            /**
+             * @brief Puts the task into a memory group, the memory allocated
+             * through the pool's allocators while it runs is charged to it.
+             *
+             * @param pMemoryGroup The group, nullptr for none.
+             */
+            inline void setMemoryGroup(std::shared_ptr<MemoryGroup> pMemoryGroup) noexcept
+                { m_pMemoryGroup = std::move(pMemoryGroup); }
+
+            /**
+             * @brief Gets the memory group of the task.
+             *
+             * @return const std::shared_ptr<MemoryGroup>& The group, nullptr if none.
+             */
+            inline const std::shared_ptr<MemoryGroup>& getMemoryGroup() const noexcept { return m_pMemoryGroup; }
+
+            /**
+             * @brief Declares the data the task is going to touch first, the
+             * worker prefetches it while running the task queued before it.
+             *
+             * @param [in] pDataHint The data, nullptr for none.
+             */
+            inline void setDataHint(const void* pDataHint) noexcept { m_pDataHint = pDataHint; }
+            inline const void* getDataHint() const noexcept { return m_pDataHint; }
+
+            /**
+             * @brief Gets the context the task runs in, captured from the thread creating it.
+             * The priority of the task is kept apart, as it may be boosted meanwhile.
+             *
+             * @return TaskContext The context with the task's current priority.
+             */
+            inline TaskContext getContext() const noexcept { return m_context.withPriority(getPriority()); }
+
+            /**
+             * @brief Sets the context the task runs in, its priority included.
+             *
+             * @param [in] context The context.
+             */
+            inline void setContext(const TaskContext& context) noexcept
+            {
+                m_context = context;
+                setPriority(context.priority);
+            }
+
+            /**
+             * @brief The priority of the task, by default the one of the context creating it.
+             * Sequentially consistent, along with the queue index: a boost finding the task
+             * not queued yet and the push queueing it meanwhile can't both miss each other.
+             */
+            inline TaskPriority getPriority() const noexcept { return m_priority.load(std::memory_order_seq_cst); }
+            inline void setPriority(const TaskPriority priority) noexcept { m_priority.store(priority, std::memory_order_seq_cst); }
+
+            /**
+             * @brief Raises the priority of the task, never lowers it.
+             *
+             * @param [in] priority The priority of the context waiting for the task.
+             * @return true if the priority was raised, false if it was as high already.
+             */
+            bool boost(const TaskPriority priority) noexcept
+            {
+                auto current = m_priority.load(std::memory_order_seq_cst);
+                while (current < priority)
+                {
+                    if (m_priority.compare_exchange_weak(current, priority, std::memory_order_seq_cst))
+                        return true;
+                }
+                return false;
+            }
+
+            /** @brief The queue index of a task not sitting in any ready queue */
+            static constexpr uint32_t NOT_QUEUED = UINT32_MAX;
+
+            /**
+             * @brief Marks the task as sitting in a ready queue of a pool.
+             * A queued task which gets boosted is queued once more at its new
+             * priority, whichever of its entries is popped first claims it.
+             *
+             * @param [in] queueIdx The index of the ready queue of the pool.
+             */
+            inline void setQueued(const uint32_t queueIdx) noexcept { m_queueIdx.store(queueIdx, std::memory_order_seq_cst); }
+            inline uint32_t getQueueIdx() const noexcept { return m_queueIdx.load(std::memory_order_seq_cst); }
+            inline bool isQueued() const noexcept { return getQueueIdx() != NOT_QUEUED; }
+
+            /**
+             * @brief Claims a queued task for execution.
+             *
+             * @return true for the first claim, false for any later one (a stale queue entry).
+             */
+            inline bool claim() noexcept { return !m_isClaimed.exchange(true, std::memory_order_acq_rel); }
+            inline bool isClaimed() const noexcept { return m_isClaimed.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Gets the priority of the calling thread's context, i.e. of the task
+             * it is running or the one set by a PriorityScope, NORMAL by default.
+             */
+            static inline TaskPriority getCurrentPriority() noexcept { return TaskContext::getCurrent().priority; }
+
+            /**
+             * @class PriorityScope
+             * @brief Sets the priority of the calling thread's context for its lifetime.
+             * Tasks submitted and awaited from the context inherit its priority.
+             */
+            class PriorityScope
+            {
+                public:
+                    explicit PriorityScope(const TaskPriority priority) noexcept
+                        : m_scope(TaskContext::getCurrent().withPriority(priority))
+                    {}
+
+                private:
+                    TaskContext::Scope m_scope;
+            };
+
         private:
-            std::packaged_task<std::any()> m_task;
+            std::function<std::any()> m_task;
+            std::promise<std::any> m_promise;
             std::future<std::any> m_future;
             std::atomic<uint32_t> m_taskId = 0;
+            std::atomic_bool m_completed = false;
+            bool m_idempotent = false;
             std::string m_taskName;
+            std::shared_ptr<MemoryGroup> m_pMemoryGroup;
+            const void* m_pDataHint = nullptr;
+            TaskContext m_context = TaskContext::getCurrent();
+            std::atomic<TaskPriority> m_priority = m_context.priority;
+            std::atomic<uint32_t> m_queueIdx = NOT_QUEUED;
+            std::atomic_bool m_isClaimed = false;
     };
 
 };   // namespace t_pool
@@ -0,0 +1,119 @@
+/**
+ * @file TaskContext.hpp
+ * @brief The context a task runs in, propagated from the submitting thread to the worker.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TASK_CONTEXT_HPP
+#define TASK_CONTEXT_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace t_pool
+{
+    /**
+     * @brief The priority of a task, the workers pick the queued tasks of the highest one first.
+     */
+    enum class TaskPriority : uint32_t
+    {
+        LOW = 0,
+        NORMAL = 1,
+        HIGH = 2,
+        CRITICAL = 3
+    };
+
+    /** @brief The no. of task priorities, i.e. of ready queues of a pool */
+    inline constexpr uint32_t TASK_PRIORITY_LEVELS = 4;
+
+    /**
+     * @struct TaskContext
+     * @brief The request a piece of work belongs to: its trace, tenant, deadline and priority.
+     *
+     * Every thread has a current context. A task captures the current context of the thread
+     * creating it and the worker running the task makes it current for the task's duration,
+     * so the context follows the work through submit(), the tasks those tasks submit and the
+     * nodes of a DAG. The context is a plain value of a fixed size, capturing and restoring
+     * it is a copy, never a heap allocation.
+     */
+    struct TaskContext
+    {
+        using Clock = std::chrono::steady_clock;
+
+        /** @brief The trace the work belongs to, 0 for none */
+        uint64_t traceId = 0;
+        /** @brief The span within the trace which submitted the work, 0 for none */
+        uint64_t spanId = 0;
+        /** @brief The tenant the work is done for, 0 for none */
+        uint32_t tenantId = 0;
+        /** @brief The priority of the work */
+        TaskPriority priority = TaskPriority::NORMAL;
+        /** @brief When the work should be done by, Clock::time_point::max() for no deadline */
+        Clock::time_point deadline = Clock::time_point::max();
+
+        inline bool hasDeadline() const noexcept { return deadline != Clock::time_point::max(); }
+        inline bool isExpired(const Clock::time_point now = Clock::now()) const noexcept { return now > deadline; }
+
+        /**
+         * @brief Gets a copy of the context with another priority.
+         *
+         * @param [in] newPriority The priority of the copy.
+         */
+        inline TaskContext withPriority(const TaskPriority newPriority) const noexcept
+        {
+            auto context = *this;
+            context.priority = newPriority;
+            return context;
+        }
+
+        /**
+         * @brief Gets the current context of the calling thread, i.e. the one
+         * of the task it is running or the one set by a Scope.
+         */
+        static const TaskContext& getCurrent() noexcept;
+
+        class Scope;
+    };
+
+    /**
+     * @class TaskContext::Scope
+     * @brief Makes a context the current one of the calling thread for its lifetime.
+     */
+    class TaskContext::Scope
+    {
+        public:
+            explicit Scope(const TaskContext& context) noexcept;
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            TaskContext m_previous;
+    };
+
+    static_assert(std::is_trivially_copyable_v<TaskContext>, "The task context must be copied by value");
+    static_assert(sizeof(TaskContext) <= 32, "The task context must stay small, it is copied with every task");
+};   // namespace t_pool
+
+#endif  // TASK_CONTEXT_HPP
@@ -0,0 +1,182 @@
+/**
+ * @file TaskCostModel.hpp
+ * @brief Historical cost model predicting task durations by task name.
+ *
+ * The model keeps an exponentially weighted moving average (EWMA) of the duration and
+ * of its variance for every task name. Updates are lock free: the per name entries live
+ * in a fixed size open addressing table, claimed with a compare-and-swap on the name hash,
+ * and the statistics are updated with compare-and-swap loops. The model can be persisted
+ * to a local file, so the estimates survive restarts.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TASK_COST_MODEL_HPP
+#define TASK_COST_MODEL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace t_pool
+{
+    /**
+     * @brief The cost estimate of a task, as known to the TaskCostModel.
+     * A sample count of zero means the task is unknown to the model.
+     */
+    struct TaskCostEstimate
+    {
+        std::chrono::nanoseconds mean = std::chrono::nanoseconds(0);
+        std::chrono::nanoseconds stdDev = std::chrono::nanoseconds(0);
+        uint64_t sampleCnt = 0;
+    };
+
+    /**
+     * @class TaskCostModel
+     * @brief Per task name EWMA duration statistics with lock free updates.
+     *
+     * Attach a model to a ThreadPool (ThreadPool::setCostModel()) to have the duration
+     * of every named task recorded by the workers. Schedulers query the model through
+     * getEstimate()/predict(), loops through suggestGrainSize().
+     *
+     * @note Names longer than MAX_NAME_LENGTH are not tracked and once the table is full
+     * new names are dropped.
+     */
+    class TaskCostModel
+    {
+        public:
+            static constexpr size_t MAX_NAME_LENGTH = 63;
+            static constexpr double DEFAULT_ALPHA = 0.2;
+
+            /**
+             * @brief Construct a new Task Cost Model object
+             *
+             * @param [in] capacity The max no. of task names tracked, rounded up to a power of two.
+             * @param [in] alpha The weight of a new sample in the moving averages, in (0, 1].
+             */
+            explicit TaskCostModel(const size_t capacity = 1024, const double alpha = DEFAULT_ALPHA);
+
+            /**
+             * @brief Construct a new Task Cost Model object persisted to a file.
+             * The statistics are loaded from @p persistPath (if it exists) now
+             * and written back to it when the model is destroyed.
+             *
+             * @param [in] persistPath The file to load from and save to.
+             * @param [in] capacity The max no. of task names tracked.
+             * @param [in] alpha The weight of a new sample in the moving averages.
+             */
+            TaskCostModel(const std::string& persistPath, const size_t capacity, const double alpha = DEFAULT_ALPHA);
+            ~TaskCostModel();
+
+            TaskCostModel(const TaskCostModel&) = delete;
+            TaskCostModel& operator=(const TaskCostModel&) = delete;
+
+            /**
+             * @brief Records one execution duration of a task. Lock free.
+             *
+             * @param [in] taskName The name of the task, unnamed tasks are ignored.
+             * @param [in] duration The time the task took.
+             */
+            void record(std::string_view taskName, const std::chrono::nanoseconds duration);
+
+            /**
+             * @brief Get the cost estimate of a task.
+             *
+             * @param [in] taskName The name of the task.
+             * @return TaskCostEstimate The estimate, with a zero sample count if unknown.
+             */
+            TaskCostEstimate getEstimate(std::string_view taskName) const;
+
+            /**
+             * @brief Predicts the duration of a task.
+             *
+             * @param [in] taskName The name of the task.
+             * @param [in] defaultCost What to return if the task is unknown.
+             * @return std::chrono::nanoseconds The mean duration or @p defaultCost.
+             */
+            std::chrono::nanoseconds predict(std::string_view taskName, const std::chrono::nanoseconds defaultCost) const;
+
+            /**
+             * @brief Suggests how many items a chunk of a parallel loop should hold.
+             * The task is expected to be named after the per item work, so that a chunk
+             * of the returned size takes about @p targetChunkDuration.
+             *
+             * @param [in] itemTaskName The name the per item duration is recorded under.
+             * @param [in] targetChunkDuration The desired duration of one chunk.
+             * @param [in] maxGrainSize The upper bound, also returned for unknown tasks.
+             * @return size_t The no. of items per chunk, at least one.
+             */
+            size_t suggestGrainSize(std::string_view itemTaskName,
+                                    const std::chrono::nanoseconds targetChunkDuration,
+                                    const size_t maxGrainSize) const;
+
+            /**
+             * @brief Writes the statistics to a file, one task name per line.
+             *
+             * @param [in] path The file to (over)write.
+             * @return true if the file has been written.
+             */
+            bool save(const std::string& path) const;
+
+            /**
+             * @brief Loads the statistics from a file written by save().
+             * Loaded entries replace the current statistics of the same names.
+             *
+             * @param [in] path The file to read.
+             * @return true if the file could be read.
+             */
+            bool load(const std::string& path);
+
+            /** @brief The no. of task names currently tracked */
+            size_t getTaskCnt() const noexcept;
+
+        private:
+            /**
+             * @brief The statistics of one task name, on its own cache line
+             * so that the updates of different tasks don't false share.
+             */
+            struct alignas(64) Entry
+            {
+                /** @brief Zero while the entry is free */
+                std::atomic<uint64_t> nameHash = 0;
+                /** @brief Set once the name is written by the thread claiming the entry */
+                std::atomic_bool ready = false;
+                uint32_t nameLength = 0;
+                char name[MAX_NAME_LENGTH + 1] = {};
+                std::atomic<double> mean = 0.0;
+                std::atomic<double> variance = 0.0;
+                std::atomic<uint64_t> sampleCnt = 0;
+            };
+
+            static uint64_t hashName(std::string_view taskName) noexcept;
+            Entry* findEntry(std::string_view taskName, const bool create) const;
+
+            size_t m_capacity;
+            double m_alpha;
+            std::string m_persistPath;
+            std::unique_ptr<Entry[]> m_pEntries;
+    };
+};   // namespace t_pool
+
+#endif  // TASK_COST_MODEL_HPP
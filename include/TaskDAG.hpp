@@ -2,8 +2,16 @@
 #define TASK_DIRECTED_ASSOCIATED_GRAPH
 
 #include "Task.hpp"
+#include "DagExecutor.hpp"
 
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace t_pool
 {
@@ -11,20 +19,405 @@ namespace t_pool
     using TASK_GRAPH = std::unordered_map<uint32_t, std::vector<uint32_t>>;
     using TASK_QUEUE = std::queue<std::weak_ptr<Task>>;
 
+    class ConcurrentDAGBuilder;
+    class DataflowDAGBuilder;
+    class DagJobScheduler;
+
+    /**
+     * @class TaskDurationHistory
+     * @brief Keeps the most recent execution durations of the tasks, by task name.
+     *
+     * A sliding window of the last WINDOW_SIZE durations is kept per task name,
+     * from which percentiles are derived. Thread safe.
+     */
+    class TaskDurationHistory
+    {
+        public:
+            static constexpr size_t WINDOW_SIZE = 64;
+
+            /**
+             * @brief The process wide history, used unless another one is configured.
+             */
+            static TaskDurationHistory& global();
+
+            /**
+             * @brief Records one execution duration of a task.
+             *
+             * @param [in] taskName The name of the task, unnamed tasks are not recorded.
+             * @param [in] duration The time it took to execute the task.
+             */
+            void record(std::string_view taskName, const std::chrono::nanoseconds duration);
+
+            /**
+             * @brief Get the no. of durations recorded (at most WINDOW_SIZE) for a task.
+             */
+            size_t getSampleCnt(std::string_view taskName) const;
+
+            /**
+             * @brief Get a percentile of the recorded durations of a task.
+             *
+             * @param [in] taskName The name of the task.
+             * @param [in] percentile The percentile in the range [0, 1], e.g. 0.95.
+             * @return std::chrono::nanoseconds The duration, zero if nothing is recorded.
+             */
+            std::chrono::nanoseconds getPercentile(std::string_view taskName, const double percentile) const;
+
+        private:
+            struct Samples
+            {
+                std::array<int64_t, WINDOW_SIZE> durations = {};
+                size_t count = 0;
+                size_t next = 0;
+            };
+
+            mutable std::mutex m_mtx;
+            std::unordered_map<std::string, Samples> m_samples;
+    };
+
+    /**
+     * @brief Settings of the speculative (duplicate) execution of the TDAG nodes.
+     *
+     * While a TDAG executes, a node on the critical path which is idempotent and has
+     * been running longer than @p slack times the @p percentile of its historical
+     * durations is executed once more on another worker. The critical path is estimated
+     * from the cost model of the pool if it has one, from the medians otherwise. Whichever of the two runs
+     * finishes first completes the node.
+     */
+    struct SpeculationPolicy
+    {
+        /** @brief Whether speculative execution is enabled at all */
+        bool enabled = false;
+        /** @brief The percentile of the historical durations a run is compared with */
+        double percentile = 0.95;
+        /** @brief The factor applied on the percentile before launching a duplicate */
+        double slack = 1.5;
+        /** @brief The no. of historical durations needed before a node is speculated */
+        size_t minSamples = 5;
+        /** @brief How often the running nodes are checked */
+        std::chrono::microseconds checkInterval = std::chrono::microseconds(500);
+        /** @brief The history to use, the process wide one if not set */
+        std::shared_ptr<TaskDurationHistory> pHistory;
+    };
+
+    /**
+     * @brief How a TDAG tracks which of its nodes are ready while it executes.
+     */
+    enum class DagExecutionMode : uint32_t
+    {
+        /** @brief Chosen by the shape of the graph, see TDAG::setExecutionMode() */
+        AUTO = 0,
+        /** @brief Every node is submitted once its own dependencies are done, counted per node */
+        DATAFLOW = 1,
+        /**
+         * @brief Level synchronous (BSP): the nodes of each topological level run as one bulk
+         * parallel loop, with a barrier between two levels, nothing is counted per node
+         */
+        LEVELS = 2
+    };
+
+    /**
+     * @brief The TDAG flattened into CSR form, indexed from 0 to the no. of tasks.
+     * An edge goes from a dependency to the task depending upon it.
+     */
+    struct CompiledTDAG
+    {
+        std::vector<uint32_t> taskIds;
+        std::vector<std::shared_ptr<Task>> tasks;
+        std::vector<uint64_t> offsets;
+        std::vector<uint32_t> targets;
+        /** @brief The node indices in topological order */
+        std::vector<uint32_t> order;
+        /** @brief The node indices grouped by topological level, the roots being level 0 */
+        std::vector<uint32_t> levelNodes;
+        /** @brief The nodes of level `l` are `levelNodes[levelOffsets[l] .. levelOffsets[l + 1])` */
+        std::vector<uint32_t> levelOffsets;
+
+        inline uint32_t getLevelCnt() const noexcept
+            { return levelOffsets.empty() ? 0 : static_cast<uint32_t>(levelOffsets.size() - 1); }
+
+        inline CsrGraphView getGraphView() const noexcept
+        {
+            return CsrGraphView{static_cast<uint32_t>(tasks.size()), offsets.data(), targets.data()};
+        }
+    };
+
     typedef class Task_As_DAG
     {
         public:
             Task_As_DAG& addTask(Task&& task);
             Task_As_DAG& addDependency(Task&& task);
             Task_As_DAG& removeDependency(Task&& task);
+
+            /**
+             * @brief Configures the speculative execution of the nodes.
+             *
+             * @param [in] policy The speculation settings.
+             * @return Task_As_DAG& Reference to self for chaining.
+             */
+            inline Task_As_DAG& setSpeculation(const SpeculationPolicy& policy)
+            {
+                m_speculation = policy;
+                return *this;
+            }
+
+            /**
+             * @brief Configures how the readiness of the nodes is tracked while executing.
+             * AUTO, the default, runs the graph level by level when its levels are at least
+             * LEVEL_MIN_WIDTH_PER_WORKER times as wide as the pool on average, where the
+             * barriers cost less than counting the dependencies of every node, and node by
+             * node otherwise. Speculation needs the DATAFLOW mode, LEVELS disables it.
+             *
+             * @param [in] mode The execution mode.
+             * @return Task_As_DAG& Reference to self for chaining.
+             */
+            inline Task_As_DAG& setExecutionMode(const DagExecutionMode mode)
+            {
+                m_executionMode = mode;
+                return *this;
+            }
+            inline DagExecutionMode getExecutionMode() const noexcept { return m_executionMode; }
+
+            /**
+             * @brief Get the mode the last execute() ran in, never AUTO once executed.
+             */
+            inline DagExecutionMode getLastExecutionMode() const noexcept { return m_lastExecutionMode; }
+
+            /** @brief The average no. of nodes per level and worker from which AUTO runs level by level */
+            static constexpr uint32_t LEVEL_MIN_WIDTH_PER_WORKER = 4;
+
+            /**
+             * @brief Executes all the tasks of the graph on the pool, every task after its
+             * dependencies, and waits for them to finish.
+             * The results are delivered through the futures of the individual tasks. A task
+             * can only be executed once, so is the graph.
+             *
+             * @param [in] pool The thread pool to execute the tasks on.
+             * @throw std::logic_error if the graph has a cycle.
+             */
+            void execute(ThreadPool& pool);
+
+            /**
+             * @brief Estimates the critical path (the longest chain of dependent tasks)
+             * from the predicted durations of the tasks.
+             *
+             * @param [in] costModel The model the task durations are predicted by.
+             * @param [in] defaultCost The duration assumed for tasks unknown to the model.
+             * @return std::chrono::nanoseconds The estimated duration of the critical path,
+             * i.e. the least time the graph takes on an unlimited no. of workers.
+             * @throw std::logic_error if the graph has a cycle.
+             */
+            std::chrono::nanoseconds estimateCriticalPath(const TaskCostModel& costModel,
+                                                          const std::chrono::nanoseconds defaultCost) const;
+
+            /**
+             * @brief Get the no. of duplicate runs launched by the last execute().
+             */
+            inline uint32_t getSpeculationCnt() const noexcept { return m_speculationCnt; }
+
+            /**
+             * @brief Get the no. of tasks in the graph
+             *
+             * @return size_t The no. of tasks including the dependencies.
+             */
+            inline size_t getTaskCnt() const noexcept { return m_taskIdMap.size(); }
+
+            /**
+             * @brief Get the dependencies of a task
+             *
+             * @param [in] taskId The id of the task.
+             * @return std::vector<uint32_t> The ids of the tasks it depends upon,
+             * empty if there are none or the task is unknown.
+             */
+            std::vector<uint32_t> getDependencies(const uint32_t taskId) const;
+
         private:
+            friend class ConcurrentDAGBuilder;
+            friend class DataflowDAGBuilder;
+            friend class DagJobScheduler;
+
             bool removeDependencyRecurs(const uint32_t taskId);
+            void insertTask(std::shared_ptr<Task> pTask);
+            bool insertDependency(const uint32_t taskId, const uint32_t dependencyId);
+            CompiledTDAG compile() const;
+            void executeSpeculative(ThreadPool& pool, const CompiledTDAG& graph);
+            void executeLevels(ThreadPool& pool, const CompiledTDAG& graph, const DagExecutor::NodeFunc& runNode);
+            DagExecutionMode chooseExecutionMode(const ThreadPool& pool, const CompiledTDAG& graph) const noexcept;
             std::shared_ptr<Task> m_task;
             std::future<std::any> m_taskFuture;
             TASK_GRAPH m_taskGraph;
             TASK_MAP m_taskIdMap;
             TASK_QUEUE m_tasksSorted;
+            SpeculationPolicy m_speculation;
+            uint32_t m_speculationCnt = 0;
+            DagExecutionMode m_executionMode = DagExecutionMode::AUTO;
+            DagExecutionMode m_lastExecutionMode = DagExecutionMode::AUTO;
     } TDAG;
+
+    /**
+     * @class ConcurrentDAGBuilder
+     * @brief Lets many threads add tasks and dependencies for a TDAG at the same time.
+     *
+     * Task_As_DAG itself is not thread safe. The builder appends the tasks and the
+     * dependency edges into a fixed no. of shards, each with its own lock and each
+     * thread sticking to one shard, so concurrent producers hardly ever contend.
+     * Once all the producers are done mergeInto() moves everything into a TDAG in
+     * one single threaded, linear pass.
+     *
+     * Dependencies are given by task id, so a dependency may be declared before or
+     * after the task it refers to is added, by any thread.
+     */
+    class ConcurrentDAGBuilder
+    {
+        public:
+            /**
+             * @brief Construct a new Concurrent DAG Builder object
+             *
+             * @param [in] shardCnt The no. of shards. Defaults to the hardware concurrency.
+             */
+            explicit ConcurrentDAGBuilder(const uint32_t shardCnt = std::thread::hardware_concurrency())
+                : m_shardCnt(shardCnt ? shardCnt : 1)
+                , m_pShards(std::make_unique<Shard[]>(m_shardCnt))
+            {}
+
+            /**
+             * @brief Adds a task to the graph being built. Thread safe.
+             *
+             * @param [in] task The task to add, it must have been submitted already.
+             * @return uint32_t The id of the task, used to declare the dependencies.
+             */
+            uint32_t addTask(Task&& task);
+
+            /**
+             * @brief Declares that a task depends upon another one. Thread safe.
+             *
+             * @param [in] taskId The id of the dependent task.
+             * @param [in] dependencyId The id of the task it depends upon.
+             */
+            void addDependency(const uint32_t taskId, const uint32_t dependencyId);
+
+            /**
+             * @brief Moves all the tasks and dependencies collected so far into a TDAG.
+             * Must not run concurrently with addTask()/addDependency(). The builder
+             * is empty afterwards and can be reused. Dependencies referring to tasks
+             * which were never added are dropped with an error.
+             *
+             * @param [in,out] dag The graph to merge into.
+             */
+            void mergeInto(TDAG& dag);
+
+        private:
+            /**
+             * @brief One append buffer, padded to its own cache line
+             * so that neighbouring shards don't false share.
+             */
+            struct alignas(64) Shard
+            {
+                std::mutex mtx;
+                std::vector<std::shared_ptr<Task>> tasks;
+                std::vector<std::pair<uint32_t, uint32_t>> dependencies;
+            };
+
+            Shard& getShard() noexcept;
+
+            uint32_t m_shardCnt;
+            std::unique_ptr<Shard[]> m_pShards;
+    };
+
+    /** @brief How a task accesses a piece of data, see DataflowDAGBuilder */
+    enum class AccessMode : uint32_t
+    {
+        /** @brief Only reads it, readers run alongside each other */
+        READ = 0,
+        /** @brief Overwrites it, after all the earlier accesses */
+        WRITE = 1,
+        /** @brief Reads then updates it, after all the earlier accesses */
+        READ_WRITE = 2,
+        /**
+         * @brief Updates it in a way which commutes with the other CONCURRENT updates
+         * (e.g. an atomic accumulation), so consecutive ones run alongside each other
+         */
+        CONCURRENT = 3
+    };
+
+    /** @brief A piece of data registered with a DataflowDAGBuilder */
+    struct DataHandle
+    {
+        uint32_t id = UINT32_MAX;
+    };
+
+    /** @brief An access of a task to a piece of data */
+    struct DataAccess
+    {
+        DataHandle handle;
+        AccessMode mode = AccessMode::READ;
+    };
+
+    /**
+     * @class DataflowDAGBuilder
+     * @brief Derives the dependencies of a TDAG from the data its tasks access.
+     *
+     * Tasks are added in program order along with their accesses to registered data, and
+     * each one gets the dependencies program order requires: on the last writers of what
+     * it reads (RAW), on the readers since the last write of what it writes (WAR) and on
+     * the last writers of what it writes if nothing read it since (WAW). Readers of the
+     * same data depend on its writers only, so they run in parallel, as do the tasks
+     * writing disjoint data and consecutive CONCURRENT updates of the same data. Edges
+     * implied by others are left out. Not thread safe.
+     */
+    class DataflowDAGBuilder
+    {
+        public:
+            /**
+             * @brief Registers a piece of data the tasks can access.
+             *
+             * @param [in] name The name of the data, for the logs.
+             * @return DataHandle The handle to declare the accesses with.
+             */
+            DataHandle registerData(std::string_view name);
+
+            /**
+             * @brief Adds a task, depending upon the earlier tasks as per its accesses.
+             * A piece of data accessed more than once by the task counts once, with
+             * the strongest of the modes.
+             *
+             * @param [in] task The task to add, it must have been submitted already.
+             * @param [in] accesses The data the task reads and writes.
+             * @return uint32_t The id of the task.
+             * @throw std::invalid_argument if a handle is not registered with the builder.
+             */
+            uint32_t addTask(Task&& task, const std::vector<DataAccess>& accesses);
+
+            /**
+             * @brief Get the no. of dependencies derived so far.
+             */
+            inline size_t getDependencyCnt() const noexcept { return m_dependencies.size(); }
+
+            /**
+             * @brief Moves all the tasks and the derived dependencies into a TDAG. The builder
+             * is empty afterwards, the registered data starting over from no access at all.
+             *
+             * @param [in,out] dag The graph to merge into.
+             */
+            void mergeInto(TDAG& dag);
+
+        private:
+            /** @brief The accesses to a piece of data which later accesses depend upon */
+            struct DataState
+            {
+                std::string name;
+                /** @brief The last writer, or the current group of CONCURRENT writers */
+                std::vector<uint32_t> writers;
+                /** @brief The readers since the last write */
+                std::vector<uint32_t> readers;
+                /** @brief What the current group of CONCURRENT writers depends upon */
+                std::vector<uint32_t> groupDeps;
+                bool isConcurrentGroup = false;
+            };
+
+            std::vector<DataState> m_data;
+            std::vector<std::shared_ptr<Task>> m_tasks;
+            std::vector<std::pair<uint32_t, uint32_t>> m_dependencies;
+    };
 };
 
 #endif //TASK_DIRECTED_ASSOCIATED_GRAPH
\ No newline at end of file
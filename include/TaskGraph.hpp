@@ -0,0 +1,325 @@
+/**
+ * @file TaskGraph.hpp
+ * @brief Task graphs captured once and replayed many times with new arguments.
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include "DagExecutor.hpp"
+
+#include <any>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace t_pool
+{
+    class TaskGraph;
+
+    /**
+     * @brief The result of a task captured into a TaskGraph.
+     * Passed as an argument to a task captured later on, it makes that task depend on this
+     * one and hands it the result (as `const R&`) at every replay.
+     *
+     * @tparam R The result type of the task.
+     */
+    template <typename R>
+    class GraphFuture
+    {
+        public:
+            using ResultType = R;
+
+            GraphFuture() = default;
+
+            inline uint32_t getNodeIdx() const noexcept { return m_nodeIdx; }
+            inline bool valid() const noexcept { return m_nodeIdx != UINT32_MAX; }
+
+        private:
+            friend class TaskGraph;
+
+            explicit GraphFuture(const uint32_t nodeIdx) noexcept : m_nodeIdx(nodeIdx) {}
+
+            uint32_t m_nodeIdx = UINT32_MAX;
+    };
+
+    template <typename T>
+    struct IsGraphFuture : std::false_type {};
+
+    template <typename R>
+    struct IsGraphFuture<GraphFuture<R>> : std::true_type {};
+
+    /** @brief What a captured task receives for an argument captured as a T */
+    template <typename T>
+    struct GraphArg { using Type = T&; };
+
+    template <typename R>
+    struct GraphArg<GraphFuture<R>> { using Type = const R&; };
+
+    /**
+     * @brief Estimates the memory held by a result of a captured task: its size, plus
+     * the elements of a contiguous container (anything with a capacity() and a value_type).
+     */
+    template <typename R>
+    size_t estimateResultBytes(const R& result) noexcept
+    {
+        if constexpr (requires { typename R::value_type; result.capacity(); })
+            return sizeof(R) + result.capacity() * sizeof(typename R::value_type);
+        else
+            return sizeof(R);
+    }
+
+    /**
+     * @class TaskGraph
+     * @brief A pattern of tasks captured once and replayed on a ThreadPool many times.
+     *
+     * Tasks are captured with submit(), the same way they are submitted to a pool, except
+     * that they don't run: a GraphFuture stands for the result of each one, and passing it
+     * to a later task is what makes the two dependent. replay() then runs the whole pattern,
+     * every task after the ones whose results it takes, and the arguments of any task can
+     * be replaced between two replays (see setArguments()).
+     *
+     * A replay skips much of what a fresh submission pays for per task: the graph is compiled
+     * once, the arguments are not bound again, and no task blocks a worker waiting on the
+     * future of another one. Chains of tasks run back to back on the same worker, without a
+     * trip through the queues (see DagExecutor). The other tasks, those the executor submits,
+     * still cost a pool Task each, with its promise and future.
+     *
+     * The results are held by the graph, all of them until the next replay by default. With
+     * early release on (see setEarlyRelease()) every result taken by other tasks is counted
+     * down by its consumers instead, one per edge, and freed as soon as the last of them has
+     * run, so the intermediates of a deep graph don't all live at once. The results of the
+     * tasks nobody consumes and those kept with keepResult() live on until the next replay.
+     *
+     * @note Capturing and replaying are not thread safe, one thread at a time. Arguments
+     * and results are held in std::any, so they have to be copyable, as with Task.
+     */
+    class TaskGraph
+    {
+        public:
+            /**
+             * @brief Captures a task into the graph.
+             *
+             * @param [in] func The callable, taking the arguments as captured, GraphFuture<R>
+             * arguments being replaced by the results they stand for.
+             * @param [in] args The arguments of the callable, stored in the graph.
+             * @return GraphFuture<R> Stands for the result of the task.
+             * @throw std::invalid_argument if a GraphFuture argument is not from this graph.
+             */
+            template <typename F, typename ...A>
+            auto submit(F&& func, A&& ...args)
+            {
+                using ArgTuple = std::tuple<std::decay_t<A>...>;
+                using Result = std::invoke_result_t<std::decay_t<F>&, typename GraphArg<std::decay_t<A>>::Type...>;
+                static_assert(!(std::is_same_v<std::decay_t<A>, GraphFuture<void>> || ...),
+                              "A GraphFuture<void> carries no result, depend on it with addDependency()");
+
+                Node node;
+                (collectDependency(node.argDeps, args), ...);
+                node.args = std::make_any<ArgTuple>(std::forward<A>(args)...);
+                node.invoke = [func = std::forward<F>(func)](const TaskGraph& graph, std::any& nodeArgs,
+                                                             size_t& resultBytes) mutable -> std::any
+                {
+                    return std::apply([&func, &graph, &resultBytes](auto& ...arg) -> std::any
+                    {
+                        if constexpr (std::is_void_v<Result>)
+                        {
+                            std::invoke(func, graph.resolve(arg)...);
+                            resultBytes = 0;
+                            return std::any{};
+                        }
+                        else
+                        {
+                            std::any result(std::invoke(func, graph.resolve(arg)...));
+                            resultBytes = estimateResultBytes(std::any_cast<const Result&>(result));
+                            return result;
+                        }
+                    }, std::any_cast<ArgTuple&>(nodeArgs));
+                };
+                m_nodes.push_back(std::move(node));
+                m_results.emplace_back();
+                m_isCompiled = false;
+                return GraphFuture<Result>(static_cast<uint32_t>(m_nodes.size() - 1));
+            }
+
+            /**
+             * @brief Makes a task depend on another one it takes no result from.
+             *
+             * @param [in] task The task.
+             * @param [in] dependency The task it has to run after.
+             * @throw std::invalid_argument if either is not from this graph.
+             */
+            template <typename R, typename D>
+            void addDependency(const GraphFuture<R>& task, const GraphFuture<D>& dependency)
+            {
+                checkNode(task.m_nodeIdx);
+                checkNode(dependency.m_nodeIdx);
+                m_nodes[task.m_nodeIdx].extraDeps.push_back(dependency.m_nodeIdx);
+                m_isCompiled = false;
+            }
+
+            /**
+             * @brief Replaces the arguments of a captured task for the next replays.
+             * The arguments must have the types they were captured with, and the
+             * GraphFuture arguments must be the same, the shape of the graph is fixed.
+             *
+             * @param [in] task The task.
+             * @param [in] args The new arguments.
+             * @throw std::bad_any_cast if the argument types differ from the captured ones.
+             * @throw std::invalid_argument if the task is not from this graph or the
+             * GraphFuture arguments differ.
+             */
+            template <typename R, typename ...A>
+            void setArguments(const GraphFuture<R>& task, A&& ...args)
+            {
+                using ArgTuple = std::tuple<std::decay_t<A>...>;
+                checkNode(task.m_nodeIdx);
+                auto& node = m_nodes[task.m_nodeIdx];
+                auto& storedArgs = std::any_cast<ArgTuple&>(node.args);
+                std::vector<uint32_t> argDeps;
+                (collectDependency(argDeps, args), ...);
+                if (argDeps != node.argDeps)
+                    throw std::invalid_argument("The dependencies of a captured task can't change");
+                storedArgs = ArgTuple(std::forward<A>(args)...);
+            }
+
+            /**
+             * @brief Frees every result as soon as the last task taking it has run,
+             * instead of keeping all of them until the next replay.
+             *
+             * @param [in] isEnabled Whether to release the results early.
+             */
+            inline void setEarlyRelease(const bool isEnabled) noexcept { m_isEarlyRelease = isEnabled; }
+            inline bool isEarlyRelease() const noexcept { return m_isEarlyRelease; }
+
+            /**
+             * @brief Keeps the result of a task until the next replay even if
+             * other tasks take it and early release is on.
+             *
+             * @param [in] task The task.
+             * @throw std::invalid_argument if the task is not from this graph.
+             */
+            template <typename R>
+            void keepResult(const GraphFuture<R>& task)
+            {
+                checkNode(task.m_nodeIdx);
+                m_nodes[task.m_nodeIdx].isKept = true;
+            }
+
+            /**
+             * @brief Runs all the captured tasks on the pool, every task after its
+             * dependencies, and waits for them to finish. If a task throws, the tasks
+             * not started yet are skipped and the first exception is rethrown.
+             * It must not be called from a worker of the pool.
+             *
+             * @param [in] pool The thread pool to run the tasks on.
+             * @throw std::logic_error if addDependency() introduced a cycle.
+             */
+            void replay(ThreadPool& pool);
+
+            /**
+             * @brief Get the result of a task from the last replay.
+             *
+             * @throw std::bad_any_cast if the task hasn't completed in the last replay
+             * or its result has been released early.
+             */
+            template <typename R>
+            const R& getResult(const GraphFuture<R>& task) const
+            {
+                checkNode(task.m_nodeIdx);
+                return std::any_cast<const R&>(m_results[task.m_nodeIdx]);
+            }
+
+            inline uint32_t getTaskCnt() const noexcept { return static_cast<uint32_t>(m_nodes.size()); }
+            inline uint64_t getReplayCnt() const noexcept { return m_replayCnt; }
+
+            /** @brief The estimated memory held by the results alive at most at once during the last replay */
+            inline size_t getPeakLiveResultBytes() const noexcept { return m_peakLiveResultBytes; }
+            /** @brief The estimated memory held by the results alive now */
+            inline size_t getLiveResultBytes() const noexcept { return m_liveResultBytes; }
+
+        private:
+            struct Node
+            {
+                std::function<std::any(const TaskGraph&, std::any&, size_t&)> invoke;
+                std::any args;
+                /** @brief The tasks whose results are arguments, in argument order */
+                std::vector<uint32_t> argDeps;
+                /** @brief The tasks added by addDependency() */
+                std::vector<uint32_t> extraDeps;
+                /** @brief Whether the result outlives its consumers with early release on */
+                bool isKept = false;
+            };
+
+            template <typename T>
+            void collectDependency(std::vector<uint32_t>& deps, const T& arg) const
+            {
+                if constexpr (IsGraphFuture<std::decay_t<T>>::value)
+                {
+                    checkNode(arg.m_nodeIdx);
+                    deps.push_back(arg.m_nodeIdx);
+                }
+            }
+
+            template <typename T>
+            T& resolve(T& arg) const noexcept { return arg; }
+
+            template <typename R>
+            const R& resolve(GraphFuture<R>& arg) const { return std::any_cast<const R&>(m_results[arg.m_nodeIdx]); }
+
+            inline void checkNode(const uint32_t nodeIdx) const
+            {
+                if (nodeIdx >= m_nodes.size())
+                    throw std::invalid_argument("Task not captured in this graph");
+            }
+
+            void compile();
+            void storeResult(const uint32_t nodeIdx);
+            void releaseResult(const uint32_t nodeIdx) noexcept;
+
+            std::vector<Node> m_nodes;
+            std::vector<std::any> m_results;
+            std::vector<uint64_t> m_offsets;
+            std::vector<uint32_t> m_targets;
+            /** @brief The estimated memory held by every result alive */
+            std::vector<size_t> m_resultBytes;
+            /** @brief The no. of argument edges from every task to its consumers */
+            std::vector<uint32_t> m_consumerCnts;
+            /** @brief The consumers of every task yet to run in the replay in progress */
+            std::unique_ptr<std::atomic<uint32_t>[]> m_pPendingConsumerCnts;
+            std::atomic<size_t> m_liveResultBytes = 0;
+            std::atomic<size_t> m_peakLiveResultBytes = 0;
+            bool m_isEarlyRelease = false;
+            bool m_isCompiled = false;
+            uint64_t m_replayCnt = 0;
+    };
+};   // namespace t_pool
+
+#endif  // TASK_GRAPH_HPP
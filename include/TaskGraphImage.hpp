@@ -0,0 +1,235 @@
+/**
+ * @file TaskGraphImage.hpp
+ * @brief Compact binary format for task graph topologies which can be memory mapped.
+ *
+ * Large graphs that are generated the same way on every start up can be written once
+ * with TaskGraphImageWriter and later loaded with TaskGraphImage, which only maps the
+ * file and validates it. No per node allocation or parsing takes place.
+ *
+ * On disk layout (native byte order, every section 8 byte aligned):
+ * - TaskGraphImageHeader
+ * - node table  : uint32_t type id per node
+ * - CSR offsets : uint64_t x (nodeCount + 1)
+ * - CSR targets : uint32_t x edgeCount, successors of every node
+ * - type table  : {uint32_t offset, uint32_t length} x typeCount into the name blob
+ * - name blob   : the type names, not NUL terminated
+ *
+ * The type names are resolved against a TaskRegistry of callables once per type
+ * (not once per node) by TaskGraphImage::bind().
+ *
+ * Copyright (c) 2025 SwarnenduRC
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TASK_GRAPH_IMAGE_HPP
+#define TASK_GRAPH_IMAGE_HPP
+
+#include "DagExecutor.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace t_pool
+{
+    /**
+     * @brief Header at the start of every graph image file.
+     * The section offsets are in bytes from the start of the file.
+     */
+    struct TaskGraphImageHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrderMark;
+        uint32_t nodeCount;
+        uint32_t typeCount;
+        uint64_t edgeCount;
+        uint64_t typeIdsOffset;
+        uint64_t offsetsOffset;
+        uint64_t targetsOffset;
+        uint64_t typeTableOffset;
+        uint64_t nameBlobOffset;
+        uint64_t nameBlobSize;
+        uint64_t fileSize;
+    };
+
+    /**
+     * @class TaskRegistry
+     * @brief Maps node type names to the callables executing them.
+     *
+     * The callable receives the index of the node being executed, so one
+     * registered callable can serve every node of its type.
+     */
+    class TaskRegistry
+    {
+        public:
+            using NodeCallable = std::function<void(uint32_t)>;
+
+            /**
+             * @brief Registers (or replaces) the callable of a node type.
+             *
+             * @param [in] typeName The name of the node type as stored in the image.
+             * @param [in] callable The callable to run for the nodes of that type.
+             * @return TaskRegistry& Reference to self for chaining.
+             */
+            TaskRegistry& registerTask(std::string_view typeName, NodeCallable callable)
+            {
+                m_callables[std::string(typeName)] = std::move(callable);
+                return *this;
+            }
+
+            /**
+             * @brief Looks up the callable of a node type.
+             *
+             * @param [in] typeName The name of the node type.
+             * @return const NodeCallable* The callable or nullptr if not registered.
+             */
+            const NodeCallable* find(std::string_view typeName) const
+            {
+                auto itr = m_callables.find(std::string(typeName));
+                return (itr == m_callables.end()) ? nullptr : &itr->second;
+            }
+
+        private:
+            std::unordered_map<std::string, NodeCallable> m_callables;
+    };
+
+    /**
+     * @class TaskGraphImageWriter
+     * @brief Collects a graph topology and writes it out as a graph image.
+     */
+    class TaskGraphImageWriter
+    {
+        public:
+            /**
+             * @brief Adds a node of the given type.
+             *
+             * @param [in] typeName The type of the node, resolved via TaskRegistry on load.
+             * @return uint32_t The index of the new node.
+             */
+            uint32_t addNode(std::string_view typeName);
+
+            /**
+             * @brief Adds an edge, i.e. node @p to can only start after @p from has finished.
+             *
+             * @param [in] from Index of the predecessor node.
+             * @param [in] to Index of the successor node.
+             * @throw std::out_of_range if either of the nodes doesn't exist.
+             */
+            void addEdge(const uint32_t from, const uint32_t to);
+
+            /**
+             * @brief Writes the graph image to a file.
+             *
+             * @param [in] path The path of the file to (over)write.
+             * @throw std::runtime_error if the file can't be written.
+             */
+            void save(const std::string& path) const;
+
+            inline uint32_t getNodeCnt() const noexcept { return static_cast<uint32_t>(m_nodeTypes.size()); }
+
+        private:
+            std::vector<uint32_t> m_nodeTypes;
+            std::vector<std::pair<uint32_t, uint32_t>> m_edges;
+            std::vector<std::string> m_typeNames;
+            std::unordered_map<std::string, uint32_t> m_typeIds;
+    };
+
+    /**
+     * @class TaskGraphImage
+     * @brief A memory mapped, validated, read only graph image.
+     *
+     * Loading consists of a single mmap of the file plus one linear validation pass
+     * (bounds of every section, CSR monotonicity, node/type ids in range and the graph
+     * being acyclic). All accessors point straight into the mapping.
+     */
+    class TaskGraphImage
+    {
+        public:
+            static constexpr char MAGIC[8] = {'T', 'P', 'O', 'O', 'L', 'D', 'A', 'G'};
+            static constexpr uint32_t VERSION = 1;
+            static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+            /**
+             * @brief Maps and validates a graph image.
+             *
+             * @param [in] path The path of the graph image file.
+             * @throw std::runtime_error if the file can't be mapped or is malformed.
+             */
+            explicit TaskGraphImage(const std::string& path);
+            ~TaskGraphImage();
+
+            TaskGraphImage(const TaskGraphImage&) = delete;
+            TaskGraphImage& operator=(const TaskGraphImage&) = delete;
+
+            inline uint32_t getNodeCnt() const noexcept { return m_pHeader->nodeCount; }
+            inline uint64_t getEdgeCnt() const noexcept { return m_pHeader->edgeCount; }
+            inline uint32_t getTypeCnt() const noexcept { return m_pHeader->typeCount; }
+            inline uint32_t getNodeType(const uint32_t nodeIdx) const noexcept { return m_pTypeIds[nodeIdx]; }
+
+            /**
+             * @brief Get the name of a node type
+             *
+             * @param [in] typeId The type id as stored in the node table.
+             * @return std::string_view The name, pointing into the mapping.
+             */
+            std::string_view getTypeName(const uint32_t typeId) const noexcept;
+
+            /** @brief The CSR view of the edges, valid as long as the image is alive */
+            inline CsrGraphView getGraphView() const noexcept
+                { return CsrGraphView{m_pHeader->nodeCount, m_pOffsets, m_pTargets}; }
+
+            /**
+             * @brief Resolves every node type against the registry.
+             *
+             * @param [in] registry The registry holding the callables. It must outlive the image.
+             * @throw std::runtime_error if a type used in the image isn't registered.
+             */
+            void bind(const TaskRegistry& registry);
+
+            /** @brief Whether bind() has succeeded */
+            inline bool isBound() const noexcept { return !m_boundTypes.empty() || !getTypeCnt(); }
+
+            /**
+             * @brief Executes the bound graph on the pool and waits for it to finish.
+             *
+             * @param [in] pool The thread pool to execute the nodes on.
+             * @throw std::logic_error if the image has not been bound yet.
+             */
+            void run(ThreadPool& pool) const;
+
+        private:
+            void validate(const size_t fileSize);
+
+            void* m_pMapping = nullptr;
+            size_t m_mappingSize = 0;
+            const TaskGraphImageHeader* m_pHeader = nullptr;
+            const uint32_t* m_pTypeIds = nullptr;
+            const uint64_t* m_pOffsets = nullptr;
+            const uint32_t* m_pTargets = nullptr;
+            const uint32_t* m_pTypeTable = nullptr;
+            const char* m_pNameBlob = nullptr;
+            std::vector<const TaskRegistry::NodeCallable*> m_boundTypes;
+    };
+};   // namespace t_pool
+
+#endif  // TASK_GRAPH_IMAGE_HPP
@@ -35,12 +35,114 @@
 #ifndef THREAD_POOL_HPP
 #define THREAD_POOL_HPP
 
+#include "Channel.hpp"
+#include "SharedPtrSlot.hpp"
+#include "ShmStatsPage.hpp"
+#include "SpscRing.hpp"
 #include "Task.hpp"
+#include "TaskCostModel.hpp"
+
+#include <array>
+#include <functional>
+#include <list>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 namespace t_pool
 {
     using ui32 = std::uint_fast32_t;
     using ui64 = std::uint_fast64_t;
+    class ThreadPool;
+
+    /**
+     * @brief How the ready tasks of a pool are queued and picked up by its workers.
+     */
+    enum class QueueMode : uint32_t
+    {
+        /** @brief One queue shared by all the workers, any worker runs any task */
+        SHARED = 0,
+        /**
+         * @brief Thread per core, shared nothing: every worker is pinned to a core and only runs
+         * the tasks of its own queue, nothing is stolen. Tasks submitted by a worker stay on its
+         * core unless sent to another one with ThreadPool::submitTo(), which hands them over
+         * through a single-producer single-consumer ring per pair of cores. Tasks submitted
+         * from outside the pool are spread over the cores round robin.
+         */
+        PER_CORE = 1,
+        /**
+         * @brief One queue shard per worker: a task goes to the shorter of two shards picked
+         * at random (power of two choices), a worker polls its home shard first and then the
+         * others. Spreads the contention of many producers over the shards while keeping
+         * the load balanced, without stealing.
+         */
+        SHARDED = 2
+    };
+
+    struct PoolTuning;
+
+    /**
+     * @class PriorityFuture
+     * @brief The future of a task submitted with a priority.
+     *
+     * Waiting for the result from a context of a higher priority than the task's boosts the
+     * task to that priority in the ready queues first, so a high priority request waiting for
+     * a low priority task doesn't wait behind all the tasks of priorities in between.
+     */
+    class PriorityFuture
+    {
+        public:
+            PriorityFuture() = default;
+            PriorityFuture(ThreadPool& pool, std::shared_ptr<Task> pTask, std::future<std::any> future) noexcept
+                : m_pPool(&pool)
+                , m_pTask(std::move(pTask))
+                , m_future(std::move(future))
+            {}
+
+            /**
+             * @brief Waits for the task, boosted to the caller's priority, and gets its result.
+             *
+             * @return std::any The result of the task.
+             */
+            std::any get()
+            {
+                boost(Task::getCurrentPriority());
+                return m_future.get();
+            }
+
+            /** @brief Waits for the task, boosted to the caller's priority */
+            void wait()
+            {
+                boost(Task::getCurrentPriority());
+                m_future.wait();
+            }
+
+            /** @brief Waits for the task for a while, boosted to the caller's priority */
+            template <typename R, typename P>
+            std::future_status wait_for(const std::chrono::duration<R, P>& timeout)
+            {
+                boost(Task::getCurrentPriority());
+                return m_future.wait_for(timeout);
+            }
+
+            /**
+             * @brief Raises the priority of the task, if it hasn't started yet.
+             *
+             * @param [in] priority The priority to raise it to.
+             */
+            void boost(const TaskPriority priority);
+
+            inline bool valid() const noexcept { return m_future.valid(); }
+
+        private:
+            ThreadPool* m_pPool = nullptr;
+            std::weak_ptr<Task> m_pTask;
+            std::future<std::any> m_future;
+    };
+
     class ThreadPool
     {
         public:
@@ -57,6 +159,7 @@ namespace t_pool
                 , m_taskRunning(true)
                 , m_pause(false)
             {
+                rebuildQueues();
                 createThreads();
             }
 
@@ -75,17 +178,54 @@ namespace t_pool
                 , m_taskRunning(true)
                 , m_pause(false)
             {
+                rebuildQueues();
+                createThreads();
+            }
+
+            /**
+             * @brief Constructs a ThreadPool with a specified number of threads and queueing mode.
+             * The same code can run on pools of different modes, to compare them.
+             *
+             * @param [in] poolSize The number of threads in the pool.
+             * @param [in] queueMode How the ready tasks are queued and picked up by the workers.
+             */
+            ThreadPool(const ui32 poolSize, const QueueMode queueMode)
+                : m_poolSize(poolSize)
+                , m_pThreads(std::make_unique<std::thread[]>(m_poolSize))
+                , m_taskCntTotal(0)
+                , m_queueMode(queueMode)
+                , m_taskRunning(true)
+                , m_pause(false)
+            {
+                rebuildQueues();
                 createThreads();
             }
 
+            /**
+             * @brief Constructs a ThreadPool with the parameters chosen for the host
+             * by a calibration (see calibratePool()): its queueing mode and how long
+             * its idle workers spin before they nap, and for how long.
+             *
+             * @param [in] poolSize The number of threads in the pool.
+             * @param [in] tuning The parameters chosen by the calibration.
+             */
+            ThreadPool(const ui32 poolSize, const PoolTuning& tuning);
+
             /**
              * @brief Destroy the Thread Pool object
              * Destructor that stops all worker threads and cleans up resources.
-             * It waits for all tasks to complete before shutting down the threads.
+             * It waits for all tasks to complete before shutting down the threads,
+             * the deferred ones are queued regardless of their budgets.
              */
             ~ThreadPool()
             {
-                waitForTaskCompletion();
+                // Deferred tasks may wait for a budget which never frees up,
+                // the tasks still running may defer more of them meanwhile
+                do
+                {
+                    admitDeferredTasks(true);
+                    waitForTaskCompletion();
+                } while (m_deferredCnt);
                 m_taskRunning = false;
                 destroyThreads();
             }
@@ -96,7 +236,8 @@ namespace t_pool
              * and then recreates the thread pool with the specified new size.
              * It is thread-safe and can be called at any time.
              * 
-             * @note If there are pending tasks in the queue, this method will wait for them to complete
+             * @note If there are pending tasks in the queue, this method will wait for them to complete.
+             * The deferred tasks stay deferred until their groups are within their budgets.
              * 
              * @param [in] newPoolSize The new size for the thread pool.
              * @note The new pool size must be greater than zero.
@@ -110,9 +251,11 @@ namespace t_pool
                 destroyThreads();
                 m_poolSize = newPoolSize;
                 LOG_ASSERT(m_poolSize > 0); // pool size must be > 0
+                rebuildQueues();    // the tasks still queued (if paused) are carried over
+                // Before the threads start, or they may quit at once leaving their queue behind
+                m_taskRunning = true;
                 createThreads();
                 m_pause = pauseStatus;  // restore previous pause status
-                m_taskRunning = true;
             }
 
             /**
@@ -131,9 +274,9 @@ namespace t_pool
              * Returns the total number of tasks that have been submitted to the thread pool
              * 
              * @return ui64 The total number of tasks submitted to the pool.
-             * @note This includes both tasks that are currently running and those that are still queued.
+             * @note This includes the tasks currently running, those still queued and those deferred.
              */
-            inline ui64 getTotalTaskCnt() const noexcept { return m_taskCntTotal; }
+            inline ui64 getTotalTaskCnt() const noexcept { return m_taskCntTotal + m_deferredCnt; }
 
             /**
              * @brief Get the Task Queued object
@@ -143,11 +286,111 @@ namespace t_pool
              * @return ui64 The number of tasks currently in the queue.
              * @note This value is approximate and may change as tasks are picked up by worker threads.
              */
-            ui64 getTaskQueued() noexcept
+            inline ui64 getTaskQueued() const noexcept { return m_taskQueuedCnt; }
+
+            /**
+             * @brief Get the Task Deferred Cnt object
+             * Returns the number of tasks held back because their memory group is over its budget.
+             * They are queued as soon as their group is within its budget again.
+             *
+             * @return ui64 The number of tasks deferred.
+             */
+            inline ui64 getTaskDeferredCnt() const noexcept { return m_deferredCnt; }
+
+            /**
+             * @brief Get the Deadline Missed Cnt
+             * Returns the number of tasks which completed after the deadline of their context.
+             *
+             * @return ui64 The number of tasks which missed their deadline.
+             */
+            inline ui64 getDeadlineMissedCnt() const noexcept { return m_deadlineMissedCnt; }
+
+            /**
+             * @brief Get the no. of times tasks have yielded to the waiting ones through yieldNow().
+             */
+            inline ui64 getYieldCnt() const noexcept { return m_yieldCnt; }
+
+            /**
+             * @brief Get the no. of times queued tasks have been moved up the ready queues by a boost.
+             */
+            inline ui64 getTaskBoostedCnt() const noexcept { return m_boostedCnt; }
+
+            /**
+             * @brief Sets the time slice of the tasks, the time a task may run before it
+             * is expected to yield (see shouldYield()) if other tasks are waiting.
+             *
+             * @param [in] timeSlice The time slice.
+             */
+            inline void setTimeSlice(const std::chrono::microseconds timeSlice) noexcept
+            {
+                m_timeSliceUs.store(timeSlice.count(), std::memory_order_relaxed);
+            }
+            inline std::chrono::microseconds getTimeSlice() const noexcept
+            {
+                return std::chrono::microseconds(m_timeSliceUs.load(std::memory_order_relaxed));
+            }
+
+            /**
+             * @brief Set how the idle workers wait for tasks. A worker finding no task yields
+             * for @p spinCnt rounds, then naps for @p sleepDuration between the rounds.
+             *
+             * @param [in] spinCnt The no. of idle rounds to yield in before napping.
+             * @param [in] sleepDuration The nap in microseconds, zero to always yield.
+             */
+            inline void setIdlePolicy(const ui32 spinCnt, const ui32 sleepDuration) noexcept
             {
-                std::lock_guard<std::mutex> queueLock(m_taskQueueMtx);
-                return m_taskQueue.size();
+                m_idleSpinCnt.store(spinCnt, std::memory_order_relaxed);
+                m_sleepDuration.store(sleepDuration, std::memory_order_relaxed);
             }
+            inline ui32 getIdleSpinCnt() const noexcept { return m_idleSpinCnt.load(std::memory_order_relaxed); }
+            inline ui32 getSleepDuration() const noexcept { return m_sleepDuration.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief Get what is left of the time slice of the task the calling worker runs.
+             * The slice starts when the task starts and again when it has yielded.
+             *
+             * @return std::chrono::nanoseconds The time left, zero once the slice is used up.
+             * The whole time slice for threads which are not workers of the pool.
+             */
+            std::chrono::nanoseconds getTimeSliceLeft() const noexcept;
+
+            /**
+             * @brief Tells a long running task whether it should yield now, i.e.
+             * it has used up its time slice and other tasks are waiting.
+             * Pools are not preemptive, long tasks are expected to check it
+             * regularly and call yieldNow() (or co_await yield()) when it says so.
+             */
+            inline bool shouldYield() const noexcept { return m_taskQueuedCnt && getTimeSliceLeft().count() == 0; }
+
+            /**
+             * @brief Lets the tasks waiting for a worker run before the calling task goes on.
+             * Called from a task, the worker runs (at most) the tasks queued at the time of
+             * the call, on its own stack, then returns to the calling task with a fresh time
+             * slice. Tasks yielding from within a yield are nested a few levels deep at most,
+             * beyond that and when not called from a worker of the pool it only yields the CPU.
+             *
+             * @note The tasks run meanwhile must not wait for the yielding task, which
+             * can't go on before they are done. Coroutines should co_await yield() instead,
+             * which queues their continuation behind the waiting tasks.
+             *
+             * @return ui32 The no. of tasks run meanwhile.
+             */
+            ui32 yieldNow();
+
+            inline ui32 getPoolSize() const noexcept { return m_poolSize; }
+            inline QueueMode getQueueMode() const noexcept { return m_queueMode; }
+
+            /** @brief The worker index of threads which are not workers of the pool */
+            static constexpr ui32 NOT_A_WORKER = UINT32_MAX;
+
+            /**
+             * @brief Get the index of the calling worker thread within the pool.
+             * In PER_CORE mode it is the index of the core the worker owns, so per core
+             * state (e.g. one BufferPool per core) can be indexed by it without sharing.
+             *
+             * @return ui32 The index, NOT_A_WORKER if the caller is not a worker of this pool.
+             */
+            ui32 getWorkerIdx() const noexcept;
 
             /**
              * @brief Submits a task to the thread pool for execution.
@@ -169,86 +412,723 @@ namespace t_pool
                 // but will be kept alive as long as there are references to it.
                 auto pTask = std::make_shared<Task>();
                 pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
-                m_taskQueue.emplace(pTask);
-                ++m_taskCntTotal;
-                return pTask->getTaskFuture();
+                return enqueue(std::move(pTask));
+            }
+
+            /**
+             * @brief Submits a task to be executed by a given worker.
+             * In PER_CORE mode the task is queued on that worker's core, handed over through
+             * the ring from the calling worker's core if called by a worker. In the other
+             * modes any worker may execute it, as with submit().
+             *
+             * @tparam F The type of the callable (function, lambda, functor).
+             * @tparam A The types of the arguments to pass to the callable.
+             * @param [in] workerIdx The index of the worker, taken modulo the pool size.
+             * @param [in] func The callable to be executed.
+             * @param [in] args The arguments to pass to the callable.
+             * @return std::future<std::any> The future associated with the task's result.
+             */
+            template<typename F, typename ...A>
+            std::future<std::any> submitTo(const ui32 workerIdx, F&& func, A&& ...args)
+            {
+                auto pTask = std::make_shared<Task>();
+                pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
+                return enqueue(std::move(pTask), workerIdx);
+            }
+
+            /**
+             * @brief Submits a task along with a hint of the data it is going to touch first.
+             * The worker prefetches the data (one cache line of it) while it runs the task
+             * queued before this one, so that the data is not cold when this one starts.
+             *
+             * @tparam F The type of the callable (function, lambda, functor).
+             * @tparam A The types of the arguments to pass to the callable.
+             * @param [in] pDataHint The data the task reads first, it must stay valid until the task runs.
+             * @param [in] func The callable to be executed.
+             * @param [in] args The arguments to pass to the callable.
+             * @return std::future<std::any> The future associated with the task's result.
+             */
+            template<typename F, typename ...A>
+            std::future<std::any> submitWithHint(const void* pDataHint, F&& func, A&& ...args)
+            {
+                auto pTask = std::make_shared<Task>();
+                pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
+                pTask->setDataHint(pDataHint);
+                return enqueue(std::move(pTask));
+            }
+
+            /**
+             * @brief Submits a named task to the thread pool for execution.
+             * Same as submit() but the task carries a name, under which its
+             * duration is recorded if a cost model is attached to the pool.
+             *
+             * @tparam F The type of the callable (function, lambda, functor).
+             * @tparam A The types of the arguments to pass to the callable.
+             * @param [in] taskName The name of the task, e.g. the kind of work it does.
+             * @param [in] func The callable to be executed.
+             * @param [in] args The arguments to pass to the callable.
+             * @return std::future<std::any> The future associated with the task's result.
+             */
+            template<typename F, typename ...A>
+            std::future<std::any> submitNamed(std::string_view taskName, F&& func, A&& ...args)
+            {
+                auto pTask = std::make_shared<Task>();
+                pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
+                pTask->setTaskName(taskName);
+                return enqueue(std::move(pTask));
+            }
+
+            /**
+             * @brief Submits a task with a priority to the thread pool.
+             * Tasks submitted otherwise inherit the priority of the submitting context,
+             * i.e. of the task the submitting worker runs, NORMAL for other threads.
+             *
+             * @tparam F The type of the callable (function, lambda, functor).
+             * @tparam A The types of the arguments to pass to the callable.
+             * @param [in] priority The priority of the task.
+             * @param [in] func The callable to be executed.
+             * @param [in] args The arguments to pass to the callable.
+             * @return PriorityFuture The future of the task's result, boosting the task when waited for.
+             */
+            template<typename F, typename ...A>
+            PriorityFuture submitWithPriority(const TaskPriority priority, F&& func, A&& ...args)
+            {
+                auto pTask = std::make_shared<Task>();
+                pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
+                pTask->setPriority(priority);
+                auto taskFuture = enqueue(pTask);
+                return PriorityFuture(*this, std::move(pTask), std::move(taskFuture));
+            }
+
+            /**
+             * @brief Submits a task with a priority, keeping no future of its result,
+             * for callers learning of its completion otherwise (e.g. DagExecutor).
+             *
+             * @tparam F The type of the callable (function, lambda, functor).
+             * @tparam A The types of the arguments to pass to the callable.
+             * @param [in] priority The priority of the task.
+             * @param [in] func The callable to be executed.
+             * @param [in] args The arguments to pass to the callable.
+             * @return std::weak_ptr<Task> The task, to boost it (see boost()) while it is alive.
+             */
+            template<typename F, typename ...A>
+            std::weak_ptr<Task> submitDetachedWithPriority(const TaskPriority priority, F&& func, A&& ...args)
+            {
+                auto pTask = std::make_shared<Task>();
+                pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
+                pTask->setPriority(priority);
+                std::weak_ptr<Task> pWeakTask = pTask;
+                enqueue(std::move(pTask));
+                return pWeakTask;
+            }
+
+            /**
+             * @brief Raises the priority of a task, if it hasn't started yet.
+             *
+             * @param [in] pTask The task, nothing is done if it is gone already.
+             * @param [in] priority The priority to raise it to.
+             */
+            void boost(const std::weak_ptr<Task>& pTask, const TaskPriority priority)
+            {
+                if (auto pLiveTask = pTask.lock())
+                    boostTask(pLiveTask, priority);
             }
 
+            /**
+             * @brief Submits a task belonging to a memory group to the thread pool.
+             * The memory allocated through the pool's allocators while the task runs is charged
+             * to the group. If the group is over its budget, the submission either throws or the
+             * task is held back until the group is within its budget again, as the group says.
+             *
+             * @tparam F The type of the callable (function, lambda, functor).
+             * @tparam A The types of the arguments to pass to the callable.
+             * @param [in] pGroup The memory group of the task.
+             * @param [in] func The callable to be executed.
+             * @param [in] args The arguments to pass to the callable.
+             * @return std::future<std::any> The future associated with the task's result.
+             * @throw std::runtime_error if the group is over its budget and doesn't defer.
+             */
+            template<typename F, typename ...A>
+            std::future<std::any> submitToGroup(std::shared_ptr<MemoryGroup> pGroup, F&& func, A&& ...args)
+            {
+                if (pGroup && pGroup->isOverBudget() && pGroup->getOverBudget() == MemoryGroup::OverBudget::FAIL)
+                {
+                    LOG_ERR("Memory group {} is over its budget, {:d} of {:d} bytes used",
+                            pGroup->getName(), pGroup->getUsedBytes(), pGroup->getLimit());
+                    throw std::runtime_error("Memory group " + pGroup->getName() + " is over its budget");
+                }
+                auto pTask = std::make_shared<Task>();
+                pTask->submit(std::forward<F>(func), std::forward<A>(args)...);
+                pTask->setMemoryGroup(pGroup);
+                if (!pGroup || !pGroup->isOverBudget())
+                    return enqueue(std::move(pTask));
+
+                auto taskFuture = pTask->getTaskFuture();
+                {
+                    std::lock_guard<std::mutex> deferredLock(m_deferredMtx);
+                    m_deferredTasks.emplace_back(std::move(pTask));
+                    ++m_deferredCnt;
+                }
+                return taskFuture;
+            }
+
+            /**
+             * @brief Submits a generator task, streaming its values through a bounded channel.
+             * The callable gets the channel as its first argument and pushes the values into
+             * it as it produces them, instead of returning them all at once. The channel is
+             * closed when the callable returns, or failed with its exception if it throws.
+             * The consumer, the caller or another task, pops the values as they come.
+             *
+             * @note The generator occupies a worker while it waits for room in the channel, so a
+             * consumer running on the same pool needs a worker of its own.
+             *
+             * @tparam T The type of the values generated.
+             * @tparam F The type of the callable, invocable as func(Channel<T>&, args...).
+             * @tparam A The types of the further arguments to pass to the callable.
+             * @param [in] capacity The max no. of values produced ahead of the consumer.
+             * @param [in] func The generator to be executed.
+             * @param [in] args The further arguments to pass to the generator.
+             * @return std::shared_ptr<Channel<T>> The channel to consume the values from.
+             */
+            template<typename T, typename F, typename ...A>
+            std::shared_ptr<Channel<T>> submitGenerator(const size_t capacity, F&& func, A&& ...args)
+            {
+                auto pChannel = std::make_shared<Channel<T>>(capacity);
+                submit([pChannel,
+                        generator = std::forward<F>(func),
+                        genArgs = std::make_tuple(std::forward<A>(args)...)]()
+                {
+                    try
+                    {
+                        std::apply([&](const auto& ...unpacked) { std::invoke(generator, *pChannel, unpacked...); }, genArgs);
+                        pChannel->close();
+                    }
+                    catch (...)
+                    {
+                        pChannel->fail(std::current_exception());
+                    }
+                });
+                return pChannel;
+            }
+
+            /**
+             * @brief Attaches a cost model to the pool.
+             * From now on the workers record the duration of every named task into
+             * the model. It doesn't wait for the pool to drain, the tasks in flight
+             * and the graphs being submitted meanwhile record into either the old
+             * model or the new one. It may be called from any thread.
+             *
+             * @param [in] pCostModel The model to record into, nullptr to detach.
+             */
+            void setCostModel(std::shared_ptr<TaskCostModel> pCostModel)
+            {
+                auto hasCostModel = static_cast<bool>(pCostModel);
+                m_pCostModel.store(std::move(pCostModel));
+                m_hasCostModel = hasCostModel;
+            }
+
+            /**
+             * @brief Get the Cost Model attached to the pool
+             *
+             * @return std::shared_ptr<TaskCostModel> The model, nullptr if none is attached.
+             */
+            inline std::shared_ptr<TaskCostModel> getCostModel() const noexcept { return m_pCostModel.load(); }
+
+            /**
+             * @brief Attaches a shared memory stats page to the pool.
+             * From now on every worker accounts the tasks it runs into its own record of the
+             * page and the pool counters are published at most every STATS_PUBLISH_INTERVAL,
+             * by whichever worker gets there first. It doesn't wait for the pool to drain,
+             * the tasks in flight are accounted into either the old page or the new one.
+             *
+             * @param [in] pStatsPage The page to publish into, created by this process, nullptr to detach.
+             */
+            void setStatsPage(std::shared_ptr<ShmStatsPage> pStatsPage);
+
+            /**
+             * @brief Get the Stats Page attached to the pool
+             *
+             * @return std::shared_ptr<ShmStatsPage> The page, nullptr if none is attached.
+             */
+            inline std::shared_ptr<ShmStatsPage> getStatsPage() const noexcept { return m_pStatsPage.load(); }
+
+            /** @brief The minimum interval between two publications of the pool counters */
+            static constexpr std::chrono::milliseconds STATS_PUBLISH_INTERVAL = std::chrono::milliseconds(1);
+
         private:
+            friend class PriorityFuture;
+
+            /** @brief The capacity of the ring between two cores in PER_CORE mode */
+            static constexpr size_t CORE_RING_CAPACITY = 128;
+
             /**
-             * @brief The worker function executed by each thread in the pool.
-             * Each worker thread runs this function in a loop, continuously checking for new tasks
-             * to execute from the task queue. If a task is available, it is executed; otherwise,
-             * the thread sleeps or yields to avoid busy-waiting.
+             * @brief Hints the CPU to start loading a cache line to read it soon.
+             *
+             * @param [in] pData The address to load, nothing is done for nullptr.
              */
-            void worker()
+            static inline void prefetch(const void* pData) noexcept
             {
-                while (m_taskRunning)
+#if defined (__GNUC__) || defined (__clang__)
+                if (pData)
+                    __builtin_prefetch(pData, 0, 3);
+#else
+                (void)pData;
+#endif
+            }
+
+            /**
+             * @struct ReadyQueue
+             * @brief The ready tasks of (a part of) the pool, one queue per priority.
+             * A boosted task sits in two of the queues, the entry left behind is
+             * skipped once it is popped. Those entries are counted apart so that
+             * they are drained, releasing their tasks, even once no live task is left.
+             */
+            struct alignas(64) ReadyQueue
+            {
+                /**
+                 * @brief A queued task, along with its data hint so that prefetching
+                 * the data does not have to wait for the task's descriptor.
+                 */
+                struct Entry
                 {
                     std::shared_ptr<Task> pTask;
-                    if (!m_pause && popTask(pTask))
+                    const void* pDataHint;
+                };
+
+                std::mutex mtx;
+                std::array<std::queue<Entry>, TASK_PRIORITY_LEVELS> levels;
+                /** @brief The no. of tasks queued, not counting the entries left behind */
+                std::atomic<ui64> size = 0;
+                /** @brief The no. of entries left behind by boosted tasks, or their boosted copies */
+                std::atomic<ui64> staleCnt = 0;
+
+                void push(std::shared_ptr<Task> pTask, const uint32_t queueIdx)
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    pTask->setQueued(queueIdx);
+                    auto pDataHint = pTask->getDataHint();
+                    levels[static_cast<uint32_t>(pTask->getPriority())].emplace(Entry{std::move(pTask), pDataHint});
+                    ++size;
+                }
+
+                bool tryPop(std::shared_ptr<Task>& pTask)
+                {
+                    if (!size && !staleCnt)
+                        return false;
+                    std::lock_guard<std::mutex> lock(mtx);
+                    for (auto level = TASK_PRIORITY_LEVELS; level-- > 0;)
                     {
-                        if (pTask.get())
+                        auto& taskQueue = levels[level];
+                        while (!taskQueue.empty())
+                        {
+                            pTask = std::move(taskQueue.front().pTask);
+                            taskQueue.pop();
+                            if (pTask->claim())
+                            {
+                                --size;
+                                prefetchNextLocked();
+                                return true;
+                            }
+                            --staleCnt;
+                        }
+                    }
+                    pTask.reset();
+                    return false;
+                }
+
+                /**
+                 * @brief Prefetches the descriptor and the declared data of the task
+                 * next in line, so that fetching them overlaps with running the task
+                 * just popped. Entries left behind by boosted tasks are prefetched
+                 * all the same, the guess is good enough to be worth it.
+                 */
+                void prefetchNextLocked() const noexcept
+                {
+                    for (auto level = TASK_PRIORITY_LEVELS; level-- > 0;)
+                    {
+                        if (levels[level].empty())
+                            continue;
+                        const auto& entry = levels[level].front();
+                        prefetch(entry.pTask.get());
+                        prefetch(entry.pDataHint);
+                        return;
+                    }
+                }
+            };
+
+            /**
+             * @brief Raises the priority of a task not started yet.
+             * A queued task is queued once more in the ready queue of its new
+             * priority, the entry left behind is skipped once it is popped.
+             *
+             * @param [in] pTask The task.
+             * @param [in] priority The priority to raise it to.
+             */
+            void boostTask(const std::shared_ptr<Task>& pTask, const TaskPriority priority)
+            {
+                if (pTask->isClaimed() || !pTask->boost(priority))
+                    return;
+                // Either this finds the task queued, or its push reads the raised priority
+                auto queueIdx = pTask->getQueueIdx();
+                if (queueIdx >= m_readyQueues.size())
+                    return;     // Not queued yet, it will be at its new priority
+                auto& readyQueue = *m_readyQueues[queueIdx];
+                std::lock_guard<std::mutex> lock(readyQueue.mtx);
+                if (!pTask->isClaimed())
+                {
+                    readyQueue.levels[static_cast<uint32_t>(priority)].emplace(ReadyQueue::Entry{pTask, pTask->getDataHint()});
+                    ++readyQueue.staleCnt;
+                    ++m_boostedCnt;
+                }
+            }
+
+            /**
+             * @brief Puts a task into the ready queue it belongs to, as per the queue mode.
+             * The task is counted as queued before it becomes visible to the workers.
+             *
+             * @param [in] pTask The task to be queued.
+             * @param [in] workerIdx The worker the task is meant for, NOT_A_WORKER for any.
+             */
+            void pushTask(std::shared_ptr<Task> pTask, const ui32 workerIdx)
+            {
+                ++m_taskQueuedCnt;
+                if (m_queueMode == QueueMode::PER_CORE)
+                {
+                    auto selfIdx = getWorkerIdx();
+                    ui32 coreIdx;
+                    if (workerIdx != NOT_A_WORKER)
+                        coreIdx = workerIdx % m_poolSize;
+                    else if (selfIdx != NOT_A_WORKER)
+                        coreIdx = selfIdx;
+                    else
+                        coreIdx = m_nextCoreIdx.fetch_add(1, std::memory_order_relaxed) % m_poolSize;
+
+                    // Hand over from core to core through their ring, unless it is full
+                    if (selfIdx != NOT_A_WORKER && selfIdx != coreIdx &&
+                        m_coreRings[selfIdx * m_poolSize + coreIdx]->tryPush(pTask))
+                        return;
+                    m_readyQueues[coreIdx]->push(std::move(pTask), static_cast<uint32_t>(coreIdx));
+                    return;
+                }
+                if (m_queueMode == QueueMode::SHARDED)
+                {
+                    auto shardIdx = pickShard();
+                    m_readyQueues[shardIdx]->push(std::move(pTask), shardIdx);
+                    return;
+                }
+                m_readyQueues[0]->push(std::move(pTask), 0);
+            }
+
+            /**
+             * @brief Picks the shard for a task in SHARDED mode, the
+             * shorter one of two different shards picked at random.
+             *
+             * @return uint32_t The index of the shard.
+             */
+            uint32_t pickShard() const noexcept
+            {
+                auto shardCnt = static_cast<uint32_t>(m_readyQueues.size());
+                if (shardCnt == 1)
+                    return 0;
+                auto firstIdx = getRandomIdx(shardCnt);
+                auto secondIdx = (firstIdx + 1 + getRandomIdx(shardCnt - 1)) % shardCnt;
+                return (m_readyQueues[secondIdx]->size < m_readyQueues[firstIdx]->size) ? secondIdx : firstIdx;
+            }
+
+            /**
+             * @brief Get a random index from a cheap per thread generator.
+             *
+             * @param [in] bound The no. of indices, greater than zero.
+             * @return uint32_t An index in [0, bound).
+             */
+            static uint32_t getRandomIdx(const uint32_t bound) noexcept;
+
+            /**
+             * @brief Makes a task visible to the workers.
+             *
+             * @param [in] pTask The task to be executed.
+             * @param [in] workerIdx The worker the task is meant for, NOT_A_WORKER for any.
+             * @return std::future<std::any> The future associated with the task's result.
+             */
+            std::future<std::any> enqueue(std::shared_ptr<Task> pTask, const ui32 workerIdx = NOT_A_WORKER)
+            {
+                auto taskFuture = pTask->getTaskFuture();
+                // Count the task before it becomes visible to the workers, otherwise
+                // a fast worker can finish it and decrement the counter first.
+                ++m_taskCntTotal;
+                pushTask(std::move(pTask), workerIdx);
+                return taskFuture;
+            }
+
+            /**
+             * @brief (Re)creates the ready queues (and rings) for the pool size and queue mode.
+             * The workers must not be running. The tasks still queued, if any, are carried
+             * over into the new queues.
+             */
+            void rebuildQueues()
+            {
+                std::vector<std::shared_ptr<Task>> pendingTasks;
+                for (auto& pQueue : m_readyQueues)
+                {
+                    for (auto& taskQueue : pQueue->levels)
+                    {
+                        for (; !taskQueue.empty(); taskQueue.pop())
                         {
-                            auto taskFunc = pTask->toFunction();
+                            auto& pTask = taskQueue.front().pTask;
+                            // Un-queue it on its first entry, so that a second one is left behind
+                            if (!pTask->isClaimed() && pTask->isQueued())
+                            {
+                                pTask->setQueued(Task::NOT_QUEUED);
+                                pendingTasks.emplace_back(std::move(pTask));
+                            }
+                        }
+                    }
+                }
+                for (auto& pRing : m_coreRings)
+                {
+                    std::shared_ptr<Task> pTask;
+                    while (pRing->tryPop(pTask))
+                        pendingTasks.emplace_back(std::move(pTask));
+                }
+
+                auto queueCnt = (m_queueMode == QueueMode::SHARED) ? 1 : m_poolSize;
+                m_readyQueues.clear();
+                for (ui32 idx = 0; idx < queueCnt; ++idx)
+                    m_readyQueues.emplace_back(std::make_unique<ReadyQueue>());
+                m_coreRings.clear();
+                if (m_queueMode == QueueMode::PER_CORE)
+                {
+                    for (ui32 idx = 0; idx < m_poolSize * m_poolSize; ++idx)
+                        m_coreRings.emplace_back(std::make_unique<SpscRing<std::shared_ptr<Task>>>(CORE_RING_CAPACITY));
+                }
+
+                m_taskQueuedCnt = 0;
+                for (auto& pTask : pendingTasks)
+                    pushTask(std::move(pTask), NOT_A_WORKER);
+            }
+
+            /**
+             * @brief Moves the tasks handed over by the other cores into a core's ready queue.
+             *
+             * @param [in] coreIdx The core of the calling worker.
+             */
+            void drainCoreRings(const ui32 coreIdx)
+            {
+                std::shared_ptr<Task> pTask;
+                for (ui32 srcIdx = 0; srcIdx < m_poolSize; ++srcIdx)
+                {
+                    if (srcIdx == coreIdx)
+                        continue;
+                    auto& ring = *m_coreRings[srcIdx * m_poolSize + coreIdx];
+                    while (ring.tryPop(pTask))
+                        m_readyQueues[coreIdx]->push(std::move(pTask), static_cast<uint32_t>(coreIdx));
+                }
+            }
+
+            /**
+             * @brief Makes the calling thread the worker of the given index,
+             * pinning it to its core in PER_CORE mode.
+             *
+             * @param [in] workerIdx The index of the worker.
+             */
+            void bindWorker(const ui32 workerIdx);
+
+            /**
+             * @brief Executes a task popped from a ready queue, in its memory group and context,
+             * with a fresh time slice.
+             *
+             * @param [in] pTask The task, claimed by the calling worker.
+             */
+            void runTask(const std::shared_ptr<Task>& pTask)
+            {
+                startTimeSlice();
+                auto taskFunc = pTask->toFunction();
+                MemoryGroup::Scope memoryScope(pTask->getMemoryGroup().get());
+                TaskContext::Scope contextScope(pTask->getContext());
+                const auto& context = TaskContext::getCurrent();
 #if defined (DEBUG) || (__DEBUG__)
-                            auto taskId = pTask->getTaskId();
-                            std::ostringstream oss;
-                            oss << std::this_thread::get_id();
-                            LOG_DBG("Task(ID) {:d} is now going to be executed by the thread {}",
-                                taskId, oss.str());
+                auto taskId = pTask->getTaskId();
+                std::ostringstream oss;
+                oss << std::this_thread::get_id();
+                LOG_DBG("Task(ID) {:d} of trace {:x} span {:x} tenant {:d} is now going to be executed by the thread {}",
+                    taskId, context.traceId, context.spanId, context.tenantId, oss.str());
 #endif
 
-                            taskFunc();
-                            --m_taskCntTotal;
+                auto hasCostModel = m_hasCostModel.load(std::memory_order_relaxed);
+                auto hasStatsPage = m_hasStatsPage.load(std::memory_order_relaxed);
+                if (hasCostModel || hasStatsPage)
+                {
+                    // Tasks run nested through yieldNow() are accounted on their own
+                    auto outerNestedNs = exchangeNestedBusyNs(0);
+                    auto startTime = std::chrono::steady_clock::now();
+                    taskFunc();
+                    auto endTime = std::chrono::steady_clock::now();
+                    uint64_t busyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+                    auto nestedNs = exchangeNestedBusyNs(outerNestedNs + busyNs);
+                    auto ownBusyNs = busyNs - std::min(nestedNs, busyNs);
+                    if (hasCostModel)
+                    {
+                        if (auto pCostModel = m_pCostModel.load())
+                            pCostModel->record(pTask->getTaskName(), std::chrono::nanoseconds(ownBusyNs));
+                    }
+                    if (hasStatsPage)
+                    {
+                        if (auto pStatsPage = m_pStatsPage.load())
+                            pStatsPage->recordWorkerTask(static_cast<uint32_t>(getWorkerIdx()), ownBusyNs,
+                                std::chrono::duration_cast<std::chrono::nanoseconds>(endTime.time_since_epoch()).count());
+                    }
+                }
+                else
+                {
+                    taskFunc();
+                }
+                if (context.hasDeadline() && context.isExpired())
+                {
+                    ++m_deadlineMissedCnt;
+                    LOG_DBG("Task(ID) {:d} of trace {:x} tenant {:d} completed past its deadline",
+                        pTask->getTaskId(), context.traceId, context.tenantId);
+                }
+                --m_taskCntTotal;
+                publishStats(false);
 #if defined (DEBUG) || (__DEBUG__)
-                            LOG_DBG("Task(ID) {:d} execution completed now by the thread {}",
-                                taskId, oss.str());
+                LOG_DBG("Task(ID) {:d} execution completed now by the thread {}",
+                    taskId, oss.str());
 #endif
-                        }
+            }
+
+            /**
+             * @brief Starts the time slice of the task the calling worker is going to run.
+             */
+            void startTimeSlice() noexcept;
+
+            /**
+             * @brief Swaps the time the calling worker has spent in the tasks run nested
+             * within the task it runs, so that the latter's busy time leaves them out.
+             *
+             * @param [in] nestedBusyNs The new time, nanoseconds.
+             * @return uint64_t The time so far, nanoseconds.
+             */
+            static uint64_t exchangeNestedBusyNs(const uint64_t nestedBusyNs) noexcept;
+
+            /**
+             * @brief Publishes the pool counters into the stats page, if one is attached.
+             * Skipped when they were published less than STATS_PUBLISH_INTERVAL ago,
+             * unless forced, or when another worker is publishing them right now.
+             *
+             * @param [in] isForced Whether to publish regardless of the interval.
+             */
+            void publishStats(const bool isForced) noexcept;
+
+            /**
+             * @brief The worker function executed by each thread in the pool.
+             * Each worker thread runs this function in a loop, continuously checking for new tasks
+             * to execute from the task queue. If a task is available, it is executed; otherwise,
+             * the thread sleeps or yields to avoid busy-waiting.
+             */
+            void worker(const ui32 workerIdx)
+            {
+                bindWorker(workerIdx);
+                ui32 idleRoundCnt = 0;
+                while (m_taskRunning)
+                {
+                    std::shared_ptr<Task> pTask;
+                    if (!m_pause && popTask(workerIdx, pTask))
+                    {
+                        idleRoundCnt = 0;
+                        if (pTask.get())
+                            runTask(pTask);
                     }
                     else
                     {
-                        sleepOrYield();
+                        publishStats(false);    // Keeps the page current once the queues drain
+                        sleepOrYield(++idleRoundCnt);
                     }
+                    if (m_deferredCnt)
+                        admitDeferredTasks(false);
                 }
             }
 
             /**
-             * @brief Pops a task from the task queue in a thread-safe manner.
-             * If the pool is not paused and there are tasks in the queue, the front task
-             * is removed from the queue and returned via the pTask parameter.
+             * @brief Queues the deferred tasks whose memory groups are within their budgets again.
+             *
+             * @param [in] force TRUE to queue all the deferred tasks regardless of their budgets.
+             */
+            void admitDeferredTasks(const bool force)
+            {
+                std::vector<std::shared_ptr<Task>> admitted;
+                {
+                    std::lock_guard<std::mutex> deferredLock(m_deferredMtx);
+                    for (auto itr = m_deferredTasks.begin(); itr != m_deferredTasks.end();)
+                    {
+                        if (force || !(*itr)->getMemoryGroup()->isOverBudget())
+                        {
+                            admitted.emplace_back(std::move(*itr));
+                            itr = m_deferredTasks.erase(itr);
+                        }
+                        else
+                        {
+                            ++itr;
+                        }
+                    }
+                    // Counted as queued before they stop being counted as deferred
+                    m_taskCntTotal += admitted.size();
+                    m_deferredCnt -= admitted.size();
+                }
+                for (auto& pTask : admitted)
+                    pushTask(std::move(pTask), NOT_A_WORKER);
+            }
+
+            /**
+             * @brief Pops a task from the task queues in a thread-safe manner.
+             * If the pool is not paused, the oldest task of the highest priority
+             * of the worker's ready queue (the first shard having one in SHARDED
+             * mode) is removed from it and returned via the pTask parameter.
              * 
+             * @param [in] workerIdx The index of the calling worker.
              * @param [out] pTask A shared pointer to hold the popped task.
              * @return true if a task was successfully popped; false otherwise.
              */
-            bool popTask(std::shared_ptr<Task>& pTask)
+            bool popTask(const ui32 workerIdx, std::shared_ptr<Task>& pTask)
             {
-                if (!m_pause)
+                if (m_pause)
+                    return false;
+                auto queueIdx = 0u;
+                if (m_queueMode == QueueMode::PER_CORE)
                 {
-                    std::lock_guard<std::mutex> lock(m_taskQueueMtx);
-                    if (!m_pause && !m_taskQueue.empty())
+                    drainCoreRings(workerIdx);
+                    queueIdx = static_cast<uint32_t>(workerIdx);
+                }
+                if (m_queueMode == QueueMode::SHARDED)
+                {
+                    // The home shard first, then the others in turn
+                    auto shardCnt = static_cast<uint32_t>(m_readyQueues.size());
+                    for (auto cnt = 0u; cnt < shardCnt; ++cnt)
                     {
-#if defined (DEBUG) || (__DEBUG__)
-                        std::ostringstream oss;
-                        oss << std::this_thread::get_id();
-                        LOG_DBG("Task with task ID {:d} popped up from the queue by the thread {}",
-                            m_taskQueue.front()->getTaskId(), 
-                            oss.str());
-#endif
-                        pTask = m_taskQueue.front();
-                        m_taskQueue.pop();
-                        return true;
+                        queueIdx = (workerIdx + cnt) % shardCnt;
+                        if (m_readyQueues[queueIdx]->tryPop(pTask))
+                            break;
                     }
+                    if (!pTask)
+                        return false;
                 }
-                return false;
+                else if (!m_readyQueues[queueIdx]->tryPop(pTask))
+                    return false;
+                --m_taskQueuedCnt;
+#if defined (DEBUG) || (__DEBUG__)
+                std::ostringstream oss;
+                oss << std::this_thread::get_id();
+                LOG_DBG("Task with task ID {:d} popped up from the queue {:d} by the thread {}",
+                    pTask->getTaskId(), queueIdx, oss.str());
+#endif
+                return true;
             }
 
             /**
              * @brief Waits for all tasks in the pool to complete.
              * This method blocks until there are no remaining tasks in the pool.
              * It checks both the queued tasks and the currently running tasks,
-             * ensuring that all tasks have finished before returning.
+             * ensuring that all tasks have finished before returning. The deferred
+             * tasks aren't waited for, their budgets may not free up meanwhile.
              */
             void waitForTaskCompletion()
             {
@@ -256,7 +1136,7 @@ namespace t_pool
                 {
                     if (!m_pause) // if not paused, check both queued and running tasks
                     {
-                        if (getTotalTaskCnt() == 0)
+                        if (m_taskCntTotal == 0)
                             break;
                     }
                     else    // if paused, only check running tasks
@@ -282,7 +1162,7 @@ namespace t_pool
                     // Start each thread, assigning it to the worker function
                     // which will continuously look for and execute tasks.
                     for (ui32 idx = 0; idx < m_poolSize; ++idx)
-                        m_pThreads[idx] = std::thread(&ThreadPool::worker, this);
+                        m_pThreads[idx] = std::thread(&ThreadPool::worker, this, idx);
                 }
                 else
                 {
@@ -307,13 +1187,17 @@ namespace t_pool
 
             /**
              * @brief Sleeps or yields the current thread to avoid busy-waiting.
-             * If a sleep duration is configured, the thread sleeps for that duration.
-             * Otherwise, it yields its execution to allow other threads to run.
+             * Past the first idle spin rounds, and if a sleep duration is configured, the
+             * thread sleeps for that duration. Otherwise, it yields its execution to allow
+             * other threads to run.
+             *
+             * @param [in] idleRoundCnt The no. of rounds the caller has found nothing to do in.
              */
-            inline void sleepOrYield()
+            inline void sleepOrYield(const ui32 idleRoundCnt = UINT32_MAX)
             {
-                if (m_sleepDuration)
-                    std::this_thread::sleep_for(std::chrono::microseconds(m_sleepDuration));
+                auto sleepDuration = m_sleepDuration.load(std::memory_order_relaxed);
+                if (sleepDuration && idleRoundCnt > m_idleSpinCnt.load(std::memory_order_relaxed))
+                    std::this_thread::sleep_for(std::chrono::microseconds(sleepDuration));
                 else
                     std::this_thread::yield();
             }
@@ -334,15 +1218,30 @@ namespace t_pool
              */
             std::atomic<ui64> m_taskCntTotal;
             /**
-             * @brief A mutex to protect the task queue.
+             * @brief How the ready tasks are queued, see QueueMode.
+             */
+            QueueMode m_queueMode = QueueMode::SHARED;
+            /**
+             * @brief The ready queues of tasks.
+             * One shared by all the workers, or one per worker in PER_CORE
+             * and SHARDED modes, each with a queue per priority.
              */
-            std::mutex m_taskQueueMtx = {};
+            std::vector<std::unique_ptr<ReadyQueue>> m_readyQueues;
             /**
-             * @brief A queue of tasks.
-             * The queue holds the tasks and its respective id
-             * to be executed by the threads in the pool.
+             * @brief The rings handing tasks over from core to core in PER_CORE
+             * mode, the one from core `src` to core `dst` at `src * m_poolSize + dst`.
              */
-            std::queue<std::shared_ptr<Task>> m_taskQueue;
+            std::vector<std::unique_ptr<SpscRing<std::shared_ptr<Task>>>> m_coreRings;
+            /**
+             * @brief The core the next task submitted from outside
+             * the pool goes to in PER_CORE mode.
+             */
+            std::atomic<ui32> m_nextCoreIdx = 0;
+            /**
+             * @brief The no. of tasks in the ready queues (and rings), not
+             * counting the entries left behind by boosted tasks.
+             */
+            std::atomic<ui64> m_taskQueuedCnt = 0;
             /**
              * @brief An atomic variable to indicate if the worker
              * threads should continue running/picking up the tasks
@@ -360,8 +1259,81 @@ namespace t_pool
              * @brief The duration for which a thread should take a nap.
              * Initially set to ZERO by default so no NAP by default.
              */
-            ui32 m_sleepDuration = 0;
+            std::atomic<ui32> m_sleepDuration = 0;
+            /**
+             * @brief The no. of idle rounds a worker yields
+             * in before it starts taking naps.
+             */
+            std::atomic<ui32> m_idleSpinCnt = 0;
+            /**
+             * @brief The model the durations of the named tasks are
+             * recorded into, if any. Read by the workers and the
+             * submitting threads while it may be replaced.
+             */
+            SharedPtrSlot<std::shared_ptr<TaskCostModel>> m_pCostModel;
+            /**
+             * @brief Whether a cost model is attached, checked by
+             * the workers without loading the pointer.
+             */
+            std::atomic_bool m_hasCostModel = false;
+            /**
+             * @brief A mutex to protect the deferred tasks.
+             */
+            std::mutex m_deferredMtx = {};
+            /**
+             * @brief The tasks held back because their memory
+             * groups are over their budgets, in submission order.
+             */
+            std::list<std::shared_ptr<Task>> m_deferredTasks;
+            /**
+             * @brief The no. of deferred tasks, checked by
+             * the workers without taking the lock.
+             */
+            std::atomic<ui64> m_deferredCnt = 0;
+            /**
+             * @brief The no. of tasks completed after
+             * the deadline of their context.
+             */
+            std::atomic<ui64> m_deadlineMissedCnt = 0;
+            /**
+             * @brief The time a task may run before it is expected
+             * to yield if other tasks are waiting, in microseconds.
+             */
+            std::atomic<int64_t> m_timeSliceUs = 10000;
+            /**
+             * @brief The no. of times tasks have yielded to the waiting ones.
+             */
+            std::atomic<ui64> m_yieldCnt = 0;
+            /**
+             * @brief The no. of times queued tasks have been boosted.
+             */
+            std::atomic<ui64> m_boostedCnt = 0;
+            /**
+             * @brief The shared memory page the counters
+             * are published into, if any.
+             */
+            SharedPtrSlot<std::shared_ptr<ShmStatsPage>> m_pStatsPage;
+            /**
+             * @brief Whether a stats page is attached, checked
+             * by the workers without touching the pointer.
+             */
+            std::atomic_bool m_hasStatsPage = false;
+            /**
+             * @brief Held while the pool counters are published,
+             * so that a single thread at a time writes the pool record.
+             */
+            std::atomic_flag m_isPublishingStats;
+            /**
+             * @brief When the pool counters are due to be published
+             * next, steady clock nanoseconds.
+             */
+            std::atomic<ui64> m_nextStatsPublishNs = 0;
     }; 
+
+    inline void PriorityFuture::boost(const TaskPriority priority)
+    {
+        m_pPool->boost(m_pTask, priority);
+    }
 } // namespace t_pool
 
 #endif  // THREAD_POOL_HPP
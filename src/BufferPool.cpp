@@ -0,0 +1,197 @@
+/**
+ * @file BufferPool.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the recycled payload buffers.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "BufferPool.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+using namespace t_pool;
+
+size_t Buffer::getCapacity() const noexcept
+{
+    return m_pSlab ? m_pSlab->pPool->getSlabSize() : 0;
+}
+
+void Buffer::setSize(const size_t size)
+{
+    if (size > getCapacity())
+        throw std::length_error("Buffer size " + std::to_string(size) + " exceeds its capacity");
+    m_pSlab->size = size;
+}
+
+BufferPool::BufferPool(const size_t slabSize,
+                       const size_t cacheCnt,
+                       const size_t cacheCapacity,
+                       const HugePageMode hugePages)
+    : m_slabSize(slabSize)
+    , m_slabStride(sizeof(BufferSlab) + ((slabSize + alignof(BufferSlab) - 1) & ~(alignof(BufferSlab) - 1)))
+    , m_cacheCnt(cacheCnt ? cacheCnt : 1)
+    , m_cacheCapacity(std::max<size_t>(cacheCapacity, 1))
+    , m_hugePages(hugePages)
+    , m_slabsPerChunk((hugePages == HugePageMode::OFF) ? SLABS_PER_CHUNK
+                                                       : std::max(SLABS_PER_CHUNK, HUGE_PAGE_SIZE / m_slabStride))
+    , m_pCaches(std::make_unique<Cache[]>(m_cacheCnt))
+{
+}
+
+BufferPool::~BufferPool()
+{
+    if (getInUseCnt())
+        LOG_ERR("Buffer pool destroyed with {:d} buffers still in use", getInUseCnt());
+    for (const auto& chunk : m_chunks)
+    {
+        if (m_hugePages == HugePageMode::OFF)
+            ::operator delete[](chunk.pData, std::align_val_t(alignof(BufferSlab)));
+        else
+            freeHugePages(chunk);
+    }
+}
+
+BufferPool::Cache& BufferPool::getCache() const noexcept
+{
+    // Every thread sticks to one cache
+    static thread_local const size_t threadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return m_pCaches[threadHash % m_cacheCnt];
+}
+
+BufferSlab* BufferPool::allocateChunk()
+{
+    HugePageRegion chunk;
+    if (m_hugePages == HugePageMode::OFF)
+    {
+        chunk.size = m_slabStride * m_slabsPerChunk;
+        chunk.pData = ::operator new[](chunk.size, std::align_val_t(alignof(BufferSlab)));
+    }
+    else
+    {
+        chunk = allocateHugePages(m_slabStride * m_slabsPerChunk, m_hugePages);
+        if (chunk.backing != HugePageMode::OFF)
+            m_hugePageBytes.fetch_add(chunk.size, std::memory_order_relaxed);
+    }
+    auto pChunk = static_cast<std::byte*>(chunk.pData);
+    BufferSlab* pFirst = nullptr;
+    for (auto idx = m_slabsPerChunk; idx > 0; --idx)
+    {
+        auto pSlab = new (pChunk + (idx - 1) * m_slabStride) BufferSlab{};
+        pSlab->pPool = this;
+        pSlab->pNext = pFirst;
+        pFirst = pSlab;
+    }
+    std::lock_guard<std::mutex> lock(m_sharedMtx);
+    m_chunks.emplace_back(chunk);
+    m_allocatedCnt.fetch_add(m_slabsPerChunk, std::memory_order_relaxed);
+    LOG_DBG("Buffer pool grown to {:d} slabs of {:d} bytes", getAllocatedCnt(), m_slabSize);
+    return pFirst;
+}
+
+Buffer BufferPool::acquire(const size_t size)
+{
+    if (size > m_slabSize)
+        throw std::length_error("Buffer of " + std::to_string(size) + " bytes exceeds the slab size");
+
+    auto& cache = getCache();
+    BufferSlab* pSlab = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(cache.mtx);
+        if (!cache.pFree)
+        {
+            // Refill from the shared list, or else from a new chunk
+            BufferSlab* pRefill = nullptr;
+            {
+                std::lock_guard<std::mutex> sharedLock(m_sharedMtx);
+                pRefill = std::exchange(m_pSharedFree, nullptr);
+            }
+            if (!pRefill)
+                pRefill = allocateChunk();
+            cache.pFree = pRefill;
+            for (auto pItr = pRefill; pItr; pItr = pItr->pNext)
+                ++cache.freeCnt;
+        }
+        pSlab = cache.pFree;
+        cache.pFree = pSlab->pNext;
+        --cache.freeCnt;
+    }
+    pSlab->pNext = nullptr;
+    pSlab->size = size;
+    pSlab->refCnt.store(1, std::memory_order_relaxed);
+    if (auto pGroup = MemoryGroup::getCurrent())
+    {
+        // Only groups owned by a shared_ptr can be credited back safely later on
+        pSlab->pGroup = pGroup->weak_from_this().lock();
+        if (pSlab->pGroup)
+            pSlab->pGroup->charge(m_slabSize);
+    }
+    m_inUseCnt.fetch_add(1, std::memory_order_relaxed);
+    return Buffer(pSlab);
+}
+
+void BufferPool::recycle(BufferSlab* pSlab) noexcept
+{
+    m_inUseCnt.fetch_sub(1, std::memory_order_relaxed);
+    if (pSlab->pGroup)
+    {
+        pSlab->pGroup->release(m_slabSize);
+        pSlab->pGroup.reset();
+    }
+    auto& cache = getCache();
+    BufferSlab* pSurplus = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(cache.mtx);
+        pSlab->pNext = cache.pFree;
+        cache.pFree = pSlab;
+        if (++cache.freeCnt <= m_cacheCapacity)
+            return;
+
+        // Too many free slabs here, hand half of them over to the other threads
+        auto keepCnt = m_cacheCapacity / 2;
+        auto pLast = cache.pFree;
+        for (size_t idx = 1; idx < keepCnt; ++idx)
+            pLast = pLast->pNext;
+        if (keepCnt)
+        {
+            pSurplus = pLast->pNext;
+            pLast->pNext = nullptr;
+        }
+        else
+        {
+            pSurplus = std::exchange(cache.pFree, nullptr);
+        }
+        cache.freeCnt = keepCnt;
+    }
+
+    auto pTail = pSurplus;
+    while (pTail->pNext)
+        pTail = pTail->pNext;
+    std::lock_guard<std::mutex> sharedLock(m_sharedMtx);
+    pTail->pNext = m_pSharedFree;
+    m_pSharedFree = pSurplus;
+}
@@ -0,0 +1,297 @@
+/**
+ * @file DagExecutor.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the CSR dataflow executor.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "DagExecutor.hpp"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace t_pool;
+
+/**
+ * @brief Book keeping of one DagExecutor::run() call.
+ * It is shared between the caller and all the submitted
+ * node tasks, so it outlives whichever finishes last.
+ */
+struct DagExecutor::RunState
+{
+    CsrGraphView graph;
+    DagExecutor::NodeFunc nodeFunc;
+    std::unique_ptr<std::atomic<uint32_t>[]> pPending;
+    // Only allocated if nodes can be duplicated, set by the run which completes a node
+    std::unique_ptr<std::atomic_bool[]> pClaimed;
+    std::atomic<uint32_t> remaining = 0;
+    std::atomic_bool failed = false;
+    std::exception_ptr pError;
+    std::mutex doneMtx;
+    std::condition_variable doneCv;
+    // The priority of every node, never lower than the ones of its successors
+    std::unique_ptr<std::atomic<TaskPriority>[]> pPriority;
+    // The tasks of the queued nodes, to boost them, cleared once they start
+    std::unique_ptr<SharedPtrSlot<std::weak_ptr<Task>>[]> pNodeTasks;
+    // The predecessors of every node, built on the first boost, guarded by the mutex
+    std::mutex boostMtx;
+    std::vector<uint64_t> predOffsets;
+    std::vector<uint32_t> predSources;
+};
+
+void DagExecutor::submitNode(ThreadPool& pool, const std::shared_ptr<RunState>& pState, const uint32_t nodeIdx)
+{
+    auto priority = pState->pPriority[nodeIdx].load(std::memory_order_relaxed);
+    auto pTask = pool.submitDetachedWithPriority(priority, [&pool, pState, nodeIdx]()
+    {
+        pState->pNodeTasks[nodeIdx].store(std::weak_ptr<Task>{});
+        executeFrom(pool, pState, nodeIdx);
+    });
+    pState->pNodeTasks[nodeIdx].store(pTask);
+    // A boost may have come in between, before it could find the task. Fenced as
+    // the boost is, so that either it finds the task or the task finds its priority.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto boosted = pState->pPriority[nodeIdx].load();
+    if (boosted > priority)
+        pool.boost(pTask, boosted);
+}
+
+void DagExecutor::executeFrom(ThreadPool& pool, const std::shared_ptr<RunState>& pState, uint32_t nodeIdx)
+{
+    auto& state = *pState;
+    while (true)
+    {
+        std::exception_ptr pNodeError;
+        if (!state.failed)
+        {
+            try
+            {
+                // Tasks submitted by the node inherit its priority
+                Task::PriorityScope priorityScope(state.pPriority[nodeIdx].load(std::memory_order_relaxed));
+                state.nodeFunc(nodeIdx);
+            }
+            catch (...)
+            {
+                pNodeError = std::current_exception();
+            }
+        }
+
+        // A duplicated node is completed by whichever of its runs gets here first
+        if (state.pClaimed && state.pClaimed[nodeIdx].exchange(true, std::memory_order_acq_rel))
+            break;
+
+        if (pNodeError)
+        {
+            std::lock_guard<std::mutex> lock(state.doneMtx);
+            if (!state.failed.exchange(true))
+                state.pError = pNodeError;
+        }
+
+        // Release the successors, keep the first ready one for ourselves
+        constexpr auto NONE = UINT32_MAX;
+        auto nextIdx = NONE;
+        for (auto edge = state.graph.offsets[nodeIdx]; edge < state.graph.offsets[nodeIdx + 1]; ++edge)
+        {
+            auto succIdx = state.graph.targets[edge];
+            if (state.pPending[succIdx].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                if (nextIdx == NONE)
+                    nextIdx = succIdx;
+                else
+                    submitNode(pool, pState, succIdx);
+            }
+        }
+
+        if (state.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock(state.doneMtx);
+            state.doneCv.notify_all();
+        }
+
+        if (nextIdx == NONE)
+            break;
+        nodeIdx = nextIdx;
+    }
+}
+
+void DagExecutor::run(const CsrGraphView& graph,
+                      NodeFunc nodeFunc,
+                      const WaitFunc& onWait,
+                      const std::chrono::microseconds waitInterval)
+{
+    LOG_ENTRY_DBG();
+    if (!graph.nodeCount)
+    {
+        LOG_EXIT_DBG();
+        return;
+    }
+
+    auto pState = std::make_shared<RunState>();
+    pState->graph = graph;
+    pState->nodeFunc = std::move(nodeFunc);
+    pState->pPending = std::make_unique<std::atomic<uint32_t>[]>(graph.nodeCount);
+    if (onWait)
+        pState->pClaimed = std::make_unique<std::atomic_bool[]>(graph.nodeCount);
+    pState->remaining = graph.nodeCount;
+    pState->pPriority = std::make_unique<std::atomic<TaskPriority>[]>(graph.nodeCount);
+    for (uint32_t nodeIdx = 0; nodeIdx < graph.nodeCount; ++nodeIdx)
+        pState->pPriority[nodeIdx].store(Task::getCurrentPriority(), std::memory_order_relaxed);
+    pState->pNodeTasks = std::make_unique<SharedPtrSlot<std::weak_ptr<Task>>[]>(graph.nodeCount);
+    for (uint64_t edge = 0; edge < graph.edgeCount(); ++edge)
+        pState->pPending[graph.targets[edge]].fetch_add(1, std::memory_order_relaxed);
+
+    // Collect the roots before submitting any of them. Once the first root runs it
+    // starts zeroing the counters of its successors which must not be taken for roots.
+    std::vector<uint32_t> rootNodes;
+    for (uint32_t nodeIdx = 0; nodeIdx < graph.nodeCount; ++nodeIdx)
+    {
+        if (pState->pPending[nodeIdx].load(std::memory_order_relaxed) == 0)
+            rootNodes.emplace_back(nodeIdx);
+    }
+    {
+        std::lock_guard<std::mutex> stateLock(m_stateMtx);
+        m_pState = pState;
+    }
+    for (auto nodeIdx : rootNodes)
+        submitNode(m_pool, pState, nodeIdx);
+
+    {
+        std::unique_lock<std::mutex> lock(pState->doneMtx);
+        auto isDone = [&pState]() { return pState->remaining == 0; };
+        if (onWait)
+        {
+            while (!pState->doneCv.wait_for(lock, waitInterval, isDone))
+            {
+                lock.unlock();
+                onWait();
+                lock.lock();
+            }
+        }
+        else
+        {
+            pState->doneCv.wait(lock, isDone);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> stateLock(m_stateMtx);
+        m_pState.reset();
+    }
+    LOG_DBG("DAG of {:d} nodes and {:d} edges executed", graph.nodeCount, graph.edgeCount());
+    LOG_EXIT_DBG();
+    if (pState->pError)
+        std::rethrow_exception(pState->pError);
+}
+
+void DagExecutor::duplicate(const uint32_t nodeIdx)
+{
+    std::shared_ptr<RunState> pState;
+    {
+        std::lock_guard<std::mutex> stateLock(m_stateMtx);
+        pState = m_pState;
+    }
+    if (!pState || !pState->pClaimed)
+    {
+        LOG_ERR("Node {:d} can't be duplicated, no graph in flight with duplication enabled", nodeIdx);
+        return;
+    }
+    if (pState->pClaimed[nodeIdx])
+        return;     // Completed already, nothing to speed up
+    LOG_DBG("Running node {:d} once more", nodeIdx);
+    m_pool.submit([&pool = m_pool, pState, nodeIdx]() { executeFrom(pool, pState, nodeIdx); });
+}
+
+void DagExecutor::boost(const uint32_t nodeIdx, const TaskPriority priority)
+{
+    std::shared_ptr<RunState> pState;
+    {
+        std::lock_guard<std::mutex> stateLock(m_stateMtx);
+        pState = m_pState;
+    }
+    if (!pState || nodeIdx >= pState->graph.nodeCount)
+    {
+        LOG_ERR("Node {:d} can't be boosted, no graph in flight with such a node", nodeIdx);
+        return;
+    }
+
+    auto& state = *pState;
+    std::lock_guard<std::mutex> lock(state.boostMtx);
+    if (state.predOffsets.empty())
+    {
+        // Reverse the edges once, boosts are rare compared to the node count
+        state.predOffsets.assign(state.graph.nodeCount + 1, 0);
+        for (uint64_t edge = 0; edge < state.graph.edgeCount(); ++edge)
+            ++state.predOffsets[state.graph.targets[edge] + 1];
+        for (uint32_t idx = 0; idx < state.graph.nodeCount; ++idx)
+            state.predOffsets[idx + 1] += state.predOffsets[idx];
+        state.predSources.resize(state.graph.edgeCount());
+        auto fill = state.predOffsets;
+        for (uint32_t srcIdx = 0; srcIdx < state.graph.nodeCount; ++srcIdx)
+        {
+            for (auto edge = state.graph.offsets[srcIdx]; edge < state.graph.offsets[srcIdx + 1]; ++edge)
+                state.predSources[fill[state.graph.targets[edge]]++] = srcIdx;
+        }
+    }
+
+    // A node as urgent as the boost already has all of its predecessors at least as urgent
+    std::vector<uint32_t> pendingNodes{nodeIdx};
+    while (!pendingNodes.empty())
+    {
+        auto idx = pendingNodes.back();
+        pendingNodes.pop_back();
+        auto current = state.pPriority[idx].load(std::memory_order_relaxed);
+        if (current >= priority)
+            continue;
+        state.pPriority[idx].store(priority);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_pool.boost(state.pNodeTasks[idx].load(), priority);
+        for (auto edge = state.predOffsets[idx]; edge < state.predOffsets[idx + 1]; ++edge)
+            pendingNodes.emplace_back(state.predSources[edge]);
+    }
+    LOG_DBG("Node {:d} and its predecessors boosted to priority {:d}", nodeIdx, static_cast<uint32_t>(priority));
+}
+
+bool DagExecutor::getTopologicalOrder(const CsrGraphView& graph, std::vector<uint32_t>& order)
+{
+    std::vector<uint32_t> inDegree(graph.nodeCount, 0);
+    for (uint64_t edge = 0; edge < graph.edgeCount(); ++edge)
+        ++inDegree[graph.targets[edge]];
+
+    order.clear();
+    order.reserve(graph.nodeCount);
+    for (uint32_t nodeIdx = 0; nodeIdx < graph.nodeCount; ++nodeIdx)
+    {
+        if (!inDegree[nodeIdx])
+            order.emplace_back(nodeIdx);
+    }
+    for (size_t pos = 0; pos < order.size(); ++pos)
+    {
+        auto nodeIdx = order[pos];
+        for (auto edge = graph.offsets[nodeIdx]; edge < graph.offsets[nodeIdx + 1]; ++edge)
+        {
+            if (--inDegree[graph.targets[edge]] == 0)
+                order.emplace_back(graph.targets[edge]);
+        }
+    }
+    return order.size() == graph.nodeCount;
+}
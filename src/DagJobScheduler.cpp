@@ -0,0 +1,246 @@
+/**
+ * @file DagJobScheduler.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the scheduler of concurrent TDAG jobs.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "DagJobScheduler.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+using namespace t_pool;
+using namespace logger;
+
+/**
+ * @brief The book keeping of one job, shared by the
+ * scheduler, its handle and its nodes in flight.
+ */
+struct DagJobScheduler::Job
+{
+    uint64_t jobId = 0;
+    DagJobOptions options;
+    CompiledTDAG graph;
+    std::shared_ptr<TaskCostModel> pCostModel;
+    std::vector<uint32_t> pendingDepCnts;
+    /** @brief The predicted work of every node */
+    std::vector<double> nodeWork;
+    /** @brief The ready nodes along with when they became ready */
+    std::deque<std::pair<uint32_t, std::chrono::steady_clock::time_point>> readyNodes;
+    uint32_t runningCnt = 0;
+    uint32_t remainingCnt = 0;
+    double remainingWork = 0.0;
+    uint64_t dispatchedCnt = 0;
+    bool isStarted = false;
+    std::chrono::steady_clock::time_point submitTime;
+    std::shared_ptr<DagJobStats> pStats;
+    std::promise<void> done;
+};
+
+DagJobScheduler::DagJobScheduler(ThreadPool& pool, const JobSchedulingPolicy policy, const uint32_t maxInFlight)
+    : m_pool(pool)
+    , m_policy(policy)
+    , m_maxInFlight(maxInFlight ? maxInFlight : std::max<uint32_t>(static_cast<uint32_t>(pool.getPoolSize()), 1))
+{
+}
+
+DagJobScheduler::~DagJobScheduler()
+{
+    waitAll();
+}
+
+DagJob DagJobScheduler::submit(TDAG& dag, const DagJobOptions& options)
+{
+    LOG_ENTRY_DBG();
+    if (!(options.weight > 0.0) || !options.maxConcurrency)
+        throw std::invalid_argument("A job needs a positive weight and concurrency cap");
+
+    auto pJob = std::make_shared<Job>();
+    pJob->options = options;
+    pJob->graph = dag.compile();
+    pJob->pCostModel = m_pool.getCostModel();
+    pJob->pStats = std::make_shared<DagJobStats>();
+    pJob->submitTime = std::chrono::steady_clock::now();
+    const auto nodeCnt = static_cast<uint32_t>(pJob->graph.tasks.size());
+    pJob->pStats->nodeCnt = nodeCnt;
+    pJob->remainingCnt = nodeCnt;
+
+    // Without a cost model every node is worth a microsecond
+    pJob->nodeWork.resize(nodeCnt);
+    for (uint32_t nodeIdx = 0; nodeIdx < nodeCnt; ++nodeIdx)
+    {
+        constexpr auto DEFAULT_COST = std::chrono::microseconds(1);
+        auto cost = pJob->pCostModel ? pJob->pCostModel->predict(pJob->graph.tasks[nodeIdx]->getTaskName(), DEFAULT_COST)
+                                     : DEFAULT_COST;
+        pJob->nodeWork[nodeIdx] = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(cost).count());
+        pJob->remainingWork += pJob->nodeWork[nodeIdx];
+    }
+    pJob->pendingDepCnts.assign(nodeCnt, 0);
+    for (auto target : pJob->graph.targets)
+        ++pJob->pendingDepCnts[target];
+    for (uint32_t nodeIdx = 0; nodeIdx < nodeCnt; ++nodeIdx)
+    {
+        if (!pJob->pendingDepCnts[nodeIdx])
+            pJob->readyNodes.emplace_back(nodeIdx, pJob->submitTime);
+    }
+
+    DagJob job;
+    job.m_done = pJob->done.get_future().share();
+    job.m_pStats = pJob->pStats;
+    std::vector<Dispatch> dispatches;
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        pJob->jobId = job.m_jobId = m_nextJobId++;
+        if (nodeCnt)
+        {
+            m_jobs.push_back(pJob);
+            pickNodes(dispatches);
+        }
+    }
+    if (!nodeCnt)
+        pJob->done.set_value();
+    LOG_DBG("Job {:d} ({}) of {:d} nodes submitted", job.m_jobId, options.name, nodeCnt);
+    dispatch(dispatches);
+    LOG_EXIT_DBG();
+    return job;
+}
+
+void DagJobScheduler::waitAll()
+{
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_idleCv.wait(lock, [this]() { return m_jobs.empty() && !m_inFlightCnt; });
+}
+
+size_t DagJobScheduler::getActiveJobCnt() const
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    return m_jobs.size();
+}
+
+void DagJobScheduler::pickNodes(std::vector<Dispatch>& dispatches)
+{
+    const auto now = std::chrono::steady_clock::now();
+    while (m_inFlightCnt < m_maxInFlight)
+    {
+        // Ties go to the job submitted first
+        const std::shared_ptr<Job>* ppBest = nullptr;
+        auto bestScore = 0.0;
+        for (const auto& pJob : m_jobs)
+        {
+            if (pJob->readyNodes.empty() || pJob->runningCnt >= pJob->options.maxConcurrency)
+                continue;
+            auto score = (m_policy == JobSchedulingPolicy::SHORTEST_FIRST)
+                            ? pJob->remainingWork / pJob->options.weight
+                            : static_cast<double>(pJob->dispatchedCnt) / pJob->options.weight;
+            if (!ppBest || score < bestScore)
+            {
+                ppBest = &pJob;
+                bestScore = score;
+            }
+        }
+        if (!ppBest)
+            break;
+
+        auto& job = **ppBest;
+        auto [nodeIdx, readySince] = job.readyNodes.front();
+        job.readyNodes.pop_front();
+        auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(now - readySince);
+        job.pStats->totalQueueingDelay += delay;
+        job.pStats->maxQueueingDelay = std::max(job.pStats->maxQueueingDelay, delay);
+        if (!job.isStarted)
+        {
+            job.isStarted = true;
+            job.pStats->startDelay = std::chrono::duration_cast<std::chrono::nanoseconds>(now - job.submitTime);
+        }
+        ++job.runningCnt;
+        ++job.dispatchedCnt;
+        ++m_inFlightCnt;
+        dispatches.push_back(Dispatch{*ppBest, nodeIdx});
+    }
+}
+
+void DagJobScheduler::dispatch(std::vector<Dispatch>& dispatches)
+{
+    for (auto& nodeDispatch : dispatches)
+    {
+        m_pool.submit([this, pJob = std::move(nodeDispatch.pJob), nodeIdx = nodeDispatch.nodeIdx]()
+        {
+            auto& task = *pJob->graph.tasks[nodeIdx];
+            {
+                // In the context and the memory group the node was created in
+                TaskContext::Scope contextScope(task.getContext());
+                MemoryGroup::Scope memoryScope(task.getMemoryGroup().get());
+                if (pJob->pCostModel)
+                {
+                    auto startTime = std::chrono::steady_clock::now();
+                    if (task.runAndForget())
+                        pJob->pCostModel->record(task.getTaskName(), std::chrono::steady_clock::now() - startTime);
+                }
+                else
+                {
+                    task.runAndForget();
+                }
+            }
+            onNodeDone(pJob, nodeIdx);
+        });
+    }
+    dispatches.clear();
+}
+
+void DagJobScheduler::onNodeDone(const std::shared_ptr<Job>& pJob, const uint32_t nodeIdx)
+{
+    std::vector<Dispatch> dispatches;
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        const auto now = std::chrono::steady_clock::now();
+        auto& job = *pJob;
+        --m_inFlightCnt;
+        --job.runningCnt;
+        --job.remainingCnt;
+        job.remainingWork -= job.nodeWork[nodeIdx];
+        const auto& graph = job.graph;
+        for (auto edge = graph.offsets[nodeIdx]; edge < graph.offsets[nodeIdx + 1]; ++edge)
+        {
+            if (!--job.pendingDepCnts[graph.targets[edge]])
+                job.readyNodes.emplace_back(graph.targets[edge], now);
+        }
+        if (!job.remainingCnt)
+        {
+            job.pStats->completionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - job.submitTime);
+            m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), pJob));
+            LOG_DBG("Job {:d} ({}) done in {:d}ns, mean queueing delay {:d}ns", job.jobId, job.options.name,
+                job.pStats->completionTime.count(), job.pStats->getMeanQueueingDelay().count());
+            // Before the scheduler may report idle, a job is done once waitAll() returns
+            job.done.set_value();
+        }
+        pickNodes(dispatches);
+        if (m_jobs.empty() && !m_inFlightCnt)
+            m_idleCv.notify_all();
+    }
+    // Once idle the scheduler may be gone, but then nothing is left to dispatch
+    if (!dispatches.empty())
+        dispatch(dispatches);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file HugePages.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the huge page backed memory.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "HugePages.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <new>
+
+#include <sys/mman.h>
+
+using namespace t_pool;
+
+namespace
+{
+    inline size_t roundUp(const size_t value, const size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    inline void* mapAnonymous(const size_t size, const int extraFlags)
+    {
+        auto pData = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extraFlags, -1, 0);
+        return (pData == MAP_FAILED) ? nullptr : pData;
+    }
+};
+
+HugePageRegion t_pool::allocateHugePages(const size_t size, const HugePageMode mode)
+{
+    HugePageRegion region;
+    region.size = (mode == HugePageMode::OFF) ? size : roundUp(size, HUGE_PAGE_SIZE);
+
+#if defined (MAP_HUGETLB)
+    if (mode == HugePageMode::EXPLICIT)
+    {
+        region.pData = mapAnonymous(region.size, MAP_HUGETLB);
+        if (region.pData)
+        {
+            region.backing = HugePageMode::EXPLICIT;
+            return region;
+        }
+        LOG_DBG("No reserved huge pages for {:d} bytes, falling back to transparent ones", region.size);
+    }
+#endif
+
+    if (mode != HugePageMode::OFF)
+    {
+        // Over map by a huge page to be able to align the region to one, the kernel
+        // only uses huge pages for the huge page aligned parts of a mapping
+        auto pRaw = static_cast<char*>(mapAnonymous(region.size + HUGE_PAGE_SIZE, 0));
+        if (pRaw)
+        {
+            auto pAligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(pRaw), HUGE_PAGE_SIZE));
+            if (pAligned != pRaw)
+                ::munmap(pRaw, static_cast<size_t>(pAligned - pRaw));
+            ::munmap(pAligned + region.size, static_cast<size_t>(pRaw + HUGE_PAGE_SIZE - pAligned));
+            region.pData = pAligned;
+            if (adviseHugePages(region.pData, region.size))
+                region.backing = HugePageMode::TRANSPARENT;
+            return region;
+        }
+    }
+
+    region.pData = mapAnonymous(region.size, 0);
+    if (!region.pData)
+    {
+        LOG_ERR("Failed to map {:d} bytes", region.size);
+        throw std::bad_alloc();
+    }
+    return region;
+}
+
+void t_pool::freeHugePages(const HugePageRegion& region) noexcept
+{
+    if (region.pData)
+        ::munmap(region.pData, region.size);
+}
+
+bool t_pool::adviseHugePages(void* pData, const size_t size) noexcept
+{
+#if defined (MADV_HUGEPAGE)
+    auto start = roundUp(reinterpret_cast<uintptr_t>(pData), HUGE_PAGE_SIZE);
+    auto end = (reinterpret_cast<uintptr_t>(pData) + size) & ~(HUGE_PAGE_SIZE - 1);
+    if (end <= start)
+        return false;
+    if (::madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) == 0)
+        return true;
+    LOG_DBG("Transparent huge pages not available for {:d} bytes", end - start);
+    return false;
+#else
+    (void)pData;
+    (void)size;
+    return false;
+#endif
+}
@@ -0,0 +1,328 @@
+/**
+ * @file PoolCalibration.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the startup calibration of the pools.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "PoolCalibration.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace t_pool;
+using namespace logger;
+
+namespace
+{
+    constexpr uint32_t YIELD_ROUNDS = 2000;
+    constexpr uint32_t NAP_ROUNDS = 16;
+    constexpr uint32_t PING_PONG_ROUNDS = 5000;
+    constexpr uint32_t STEAL_ROUNDS = 20000;
+    /** @brief Spins before yielding while waiting for the other thread, in case the host is busy */
+    constexpr uint32_t SPINS_BEFORE_YIELD = 1000;
+
+    std::chrono::nanoseconds getElapsed(const std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    void spinUntil(const std::atomic<uint64_t>& value, const uint64_t expected)
+    {
+        for (uint32_t spinCnt = 0; value.load(std::memory_order_acquire) != expected; ++spinCnt)
+        {
+            if (spinCnt >= SPINS_BEFORE_YIELD)
+                std::this_thread::yield();
+        }
+    }
+
+    std::chrono::nanoseconds measureYieldCost()
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t idx = 0; idx < YIELD_ROUNDS; ++idx)
+            std::this_thread::yield();
+        return getElapsed(start) / YIELD_ROUNDS;
+    }
+
+    std::chrono::nanoseconds measureWakeLatency()
+    {
+        constexpr auto NAP = std::chrono::microseconds(1);
+        std::vector<std::chrono::nanoseconds> overshoots;
+        for (uint32_t idx = 0; idx < NAP_ROUNDS; ++idx)
+        {
+            auto start = std::chrono::steady_clock::now();
+            std::this_thread::sleep_for(NAP);
+            overshoots.push_back(std::max(getElapsed(start) - NAP, std::chrono::nanoseconds(0)));
+        }
+        // The median, a preemption now and then shouldn't skew it
+        std::nth_element(overshoots.begin(), overshoots.begin() + NAP_ROUNDS / 2, overshoots.end());
+        return overshoots[NAP_ROUNDS / 2];
+    }
+
+    std::chrono::nanoseconds measureLineTransferCost()
+    {
+        struct alignas(64) { std::atomic<uint64_t> value = 0; } ball;
+        std::thread partner([&ball]()
+        {
+            for (uint64_t round = 1; round <= PING_PONG_ROUNDS; ++round)
+            {
+                spinUntil(ball.value, 2 * round - 1);
+                ball.value.store(2 * round, std::memory_order_release);
+            }
+        });
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t round = 1; round <= PING_PONG_ROUNDS; ++round)
+        {
+            ball.value.store(2 * round - 1, std::memory_order_release);
+            spinUntil(ball.value, 2 * round);
+        }
+        auto elapsed = getElapsed(start);
+        partner.join();
+        return elapsed / (2 * PING_PONG_ROUNDS);
+    }
+
+    std::chrono::nanoseconds measureStealCost()
+    {
+        std::mutex mtx;
+        std::deque<uint64_t> queue;
+        std::atomic_bool isDone = false;
+        std::thread producer([&]()
+        {
+            for (uint64_t item = 0; !isDone.load(std::memory_order_relaxed); ++item)
+            {
+                bool isFull = false;
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    isFull = queue.size() >= 64;
+                    if (!isFull)
+                        queue.push_back(item);
+                }
+                if (isFull)
+                    std::this_thread::yield();
+            }
+        });
+        uint32_t takenCnt = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (takenCnt < STEAL_ROUNDS)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!queue.empty())
+            {
+                queue.pop_front();
+                ++takenCnt;
+            }
+        }
+        auto elapsed = getElapsed(start);
+        isDone = true;
+        producer.join();
+        return elapsed / STEAL_ROUNDS;
+    }
+
+    PoolTuning measureHost()
+    {
+        LOG_ENTRY_DBG();
+        PoolTuning tuning;
+        tuning.hostName = getCalibrationHostName();
+        tuning.hardwareThreadCnt = std::thread::hardware_concurrency();
+        tuning.yieldCost = measureYieldCost();
+        tuning.wakeLatency = measureWakeLatency();
+        // Two threads spinning on one core measure the scheduler, not the caches
+        if (tuning.hardwareThreadCnt > 1)
+        {
+            tuning.lineTransferCost = measureLineTransferCost();
+            tuning.stealCost = measureStealCost();
+        }
+        LOG_INFO("Host measured: wake up {:d}ns, line transfer {:d}ns, steal {:d}ns, yield {:d}ns",
+            tuning.wakeLatency.count(), tuning.lineTransferCost.count(),
+            tuning.stealCost.count(), tuning.yieldCost.count());
+        LOG_EXIT_DBG();
+        return tuning;
+    }
+};
+
+void t_pool::choosePoolParameters(PoolTuning& tuning, const ui32 poolSize) noexcept
+{
+    // Spin about as long as waking up from a nap would take, nap about as long again:
+    // a shorter nap is mostly overshoot, a longer one delays the next task for nothing
+    auto yieldCost = std::max(tuning.yieldCost, std::chrono::nanoseconds(1));
+    tuning.idleSpinCnt = static_cast<ui32>(std::clamp<int64_t>(tuning.wakeLatency / yieldCost, 16, 4096));
+    tuning.sleepDuration = static_cast<ui32>(std::clamp<int64_t>((tuning.wakeLatency.count() + 999) / 1000, 1, 1000));
+
+    // A couple of workers barely contend on one queue. Past that, if taking a task out of a
+    // queue fed by another core costs much more than moving the line itself, keep the tasks
+    // on the cores submitting them; pinning a worker per core needs a core per worker though,
+    // and the caller's consent as a task waiting for its own children would never see them run.
+    if (poolSize <= 2 || tuning.hardwareThreadCnt < 2)
+        tuning.queueMode = QueueMode::SHARED;
+    else if (tuning.allowPerCore && tuning.stealCost > 4 * tuning.lineTransferCost &&
+             poolSize <= tuning.hardwareThreadCnt)
+        tuning.queueMode = QueueMode::PER_CORE;
+    else
+        tuning.queueMode = QueueMode::SHARDED;
+}
+
+PoolTuning t_pool::calibratePool(const ui32 poolSize)
+{
+    auto tuning = measureHost();
+    choosePoolParameters(tuning, poolSize);
+    return tuning;
+}
+
+PoolTuning t_pool::calibratePool(const ui32 poolSize, const std::string& cachePath)
+{
+    PoolTuning tuning;
+    if (loadTuning(tuning, cachePath))
+    {
+        LOG_INFO("Host measurements reused from {}", cachePath);
+    }
+    else
+    {
+        tuning = measureHost();
+        if (!saveTuning(tuning, cachePath))
+            LOG_ERR("Host measurements couldn't be cached in {}", cachePath);
+    }
+    choosePoolParameters(tuning, poolSize);
+    return tuning;
+}
+
+bool t_pool::saveTuning(const PoolTuning& tuning, const std::string& path)
+{
+    // Written aside and renamed, a crash never leaves a half written file behind
+    const auto tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERR("Failed to open {} for writing", tmpPath);
+            return false;
+        }
+        file << "# TPool host measurements v2: name value\n"
+             << "host\t" << tuning.hostName << '\n'
+             << "hardwareThreads\t" << tuning.hardwareThreadCnt << '\n'
+             << "wakeLatencyNs\t" << tuning.wakeLatency.count() << '\n'
+             << "lineTransferNs\t" << tuning.lineTransferCost.count() << '\n'
+             << "stealNs\t" << tuning.stealCost.count() << '\n'
+             << "yieldNs\t" << tuning.yieldCost.count() << '\n';
+        if (!file.flush())
+        {
+            LOG_ERR("Failed to write {}", tmpPath);
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()))
+    {
+        LOG_ERR("Failed to rename {} to {}", tmpPath, path);
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool t_pool::loadTuning(PoolTuning& tuning, const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    PoolTuning loaded;
+    uint32_t fieldMask = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.front() == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string name;
+        int64_t value = 0;
+        if ((fields >> name) && name == "host")
+        {
+            if (!(fields >> loaded.hostName))
+            {
+                LOG_ERR("Malformed line in {}: {}", path, line);
+                return false;
+            }
+            fieldMask |= 32;
+            continue;
+        }
+        if (!(fields >> value) || value < 0)
+        {
+            LOG_ERR("Malformed line in {}: {}", path, line);
+            return false;
+        }
+        if (name == "hardwareThreads")
+        {
+            loaded.hardwareThreadCnt = static_cast<ui32>(value);
+            fieldMask |= 1;
+        }
+        else if (name == "wakeLatencyNs")
+        {
+            loaded.wakeLatency = std::chrono::nanoseconds(value);
+            fieldMask |= 2;
+        }
+        else if (name == "lineTransferNs")
+        {
+            loaded.lineTransferCost = std::chrono::nanoseconds(value);
+            fieldMask |= 4;
+        }
+        else if (name == "stealNs")
+        {
+            loaded.stealCost = std::chrono::nanoseconds(value);
+            fieldMask |= 8;
+        }
+        else if (name == "yieldNs")
+        {
+            loaded.yieldCost = std::chrono::nanoseconds(value);
+            fieldMask |= 16;
+        }
+    }
+    if (fieldMask != 63)
+    {
+        LOG_ERR("Incomplete host measurements in {}", path);
+        return false;
+    }
+    if (loaded.hostName != getCalibrationHostName() || loaded.hardwareThreadCnt != std::thread::hardware_concurrency())
+    {
+        LOG_INFO("Host measurements in {} were taken on another host", path);
+        return false;
+    }
+    loaded.allowPerCore = tuning.allowPerCore;     // A choice of the caller, not a measurement
+    tuning = loaded;
+    return true;
+}
+
+std::string t_pool::getCalibrationHostName()
+{
+    char hostName[256] = {};
+    if (::gethostname(hostName, sizeof(hostName) - 1) != 0 || !hostName[0])
+        return "unknown";
+    return hostName;
+}
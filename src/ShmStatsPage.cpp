@@ -0,0 +1,265 @@
+/**
+ * @file ShmStatsPage.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the shared memory stats page.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ShmStatsPage.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace t_pool;
+using namespace logger;
+
+/**
+ * @brief Header at the start of the segment, the pool record and
+ * the worker records follow, each on a cache line of its own.
+ */
+struct ShmStatsPage::Header
+{
+    char magic[8];
+    /** @brief Written last by the creator, zero until the segment is initialised */
+    std::atomic<uint32_t> version;
+    uint32_t workerCapacity;
+};
+
+/**
+ * @brief A seqlocked record, odd sequences meaning it is being written.
+ */
+struct alignas(64) ShmStatsPage::Record
+{
+    static constexpr uint32_t VALUE_CNT = 7;
+
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> values[VALUE_CNT];
+
+    void write(const uint64_t (&newValues)[VALUE_CNT]) noexcept
+    {
+        auto seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (uint32_t idx = 0; idx < VALUE_CNT; ++idx)
+            values[idx].store(newValues[idx], std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    bool read(uint64_t (&copy)[VALUE_CNT]) const noexcept
+    {
+        // A writer is never preempted for long, one which died midway never finishes
+        for (uint32_t attempt = 0; attempt < 10000; ++attempt)
+        {
+            auto seq = sequence.load(std::memory_order_acquire);
+            if (seq & 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (uint32_t idx = 0; idx < VALUE_CNT; ++idx)
+                copy[idx] = values[idx].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == seq)
+                return true;
+        }
+        return false;
+    }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory atomics must be lock free");
+
+namespace
+{
+    constexpr size_t HEADER_SIZE = 64;
+
+    inline std::string toSegmentName(const std::string& name)
+    {
+        return (!name.empty() && name.front() == '/') ? name : "/" + name;
+    }
+
+    inline size_t getSegmentSize(const uint32_t workerCapacity)
+    {
+        return HEADER_SIZE + (size_t(workerCapacity) + 1) * 64;
+    }
+};
+
+ShmStatsPage::ShmStatsPage(const std::string& name, const uint32_t workerCapacity)
+    : m_name(toSegmentName(name))
+    , m_isOwner(true)
+    , m_workerCapacity(workerCapacity)
+{
+    static_assert(sizeof(Header) <= HEADER_SIZE, "Stats page header must fit a cache line");
+    static_assert(sizeof(Record) == 64, "A stats record must fill exactly one cache line");
+    LOG_ENTRY_DBG();
+    auto fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Unable to create the stats page " + m_name);
+    const auto size = getSegmentSize(m_workerCapacity);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        ::close(fd);
+        ::shm_unlink(m_name.c_str());
+        throw std::runtime_error("Unable to size the stats page " + m_name);
+    }
+    try
+    {
+        map(fd, size, true);
+    }
+    catch (...)
+    {
+        ::shm_unlink(m_name.c_str());
+        throw;
+    }
+
+    // The segment comes zeroed, which is a valid state for every record
+    m_pHeader = new (m_pMapping) Header{};
+    std::memcpy(m_pHeader->magic, MAGIC, sizeof(MAGIC));
+    m_pHeader->workerCapacity = m_workerCapacity;
+    for (uint32_t idx = 0; idx <= m_workerCapacity; ++idx)
+        new (static_cast<char*>(m_pMapping) + HEADER_SIZE + size_t(idx) * 64) Record{};
+    m_pHeader->version.store(VERSION, std::memory_order_release);
+    LOG_DBG("Stats page {} created for {:d} workers", m_name, m_workerCapacity);
+    LOG_EXIT_DBG();
+}
+
+ShmStatsPage::ShmStatsPage(const std::string& name)
+    : m_name(toSegmentName(name))
+{
+    LOG_ENTRY_DBG();
+    auto fd = ::shm_open(m_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        throw std::runtime_error("Unable to open the stats page " + m_name);
+    struct stat segmentStat = {};
+    if (::fstat(fd, &segmentStat) != 0 || static_cast<size_t>(segmentStat.st_size) < getSegmentSize(0))
+    {
+        ::close(fd);
+        throw std::runtime_error("Stats page " + m_name + " is too small");
+    }
+    map(fd, static_cast<size_t>(segmentStat.st_size), false);
+    m_pHeader = static_cast<Header*>(m_pMapping);
+
+    // The creator may still be initialising the segment
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (m_pHeader->version.load(std::memory_order_acquire) == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+
+    const char* reason = nullptr;
+    if (std::memcmp(m_pHeader->magic, MAGIC, sizeof(MAGIC)) != 0)
+        reason = "bad magic";
+    else if (m_pHeader->version.load(std::memory_order_acquire) != VERSION)
+        reason = "unsupported version";
+    else if (getSegmentSize(m_pHeader->workerCapacity) > m_mappingSize)
+        reason = "inconsistent geometry";
+    if (reason)
+    {
+        LOG_ERR("Malformed stats page {}: {}", m_name, reason);
+        ::munmap(m_pMapping, m_mappingSize);
+        throw std::runtime_error("Malformed stats page " + m_name + ": " + reason);
+    }
+    m_workerCapacity = m_pHeader->workerCapacity;
+    LOG_EXIT_DBG();
+}
+
+ShmStatsPage::~ShmStatsPage()
+{
+    if (m_pMapping)
+        ::munmap(m_pMapping, m_mappingSize);
+    if (m_isOwner)
+        ::shm_unlink(m_name.c_str());
+}
+
+void ShmStatsPage::map(const int fd, const size_t size, const bool isWritable)
+{
+    auto pMapping = ::mmap(nullptr, size, isWritable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);   // The mapping keeps the segment referenced
+    if (pMapping == MAP_FAILED)
+        throw std::runtime_error("Unable to map the stats page " + m_name);
+    m_pMapping = pMapping;
+    m_mappingSize = size;
+}
+
+ShmStatsPage::Record& ShmStatsPage::poolRecord() const noexcept
+{
+    return *reinterpret_cast<Record*>(static_cast<char*>(m_pMapping) + HEADER_SIZE);
+}
+
+ShmStatsPage::Record& ShmStatsPage::workerRecord(const uint32_t workerIdx) const noexcept
+{
+    return *reinterpret_cast<Record*>(static_cast<char*>(m_pMapping) + HEADER_SIZE + (size_t(workerIdx) + 1) * 64);
+}
+
+void ShmStatsPage::publishPool(const PoolStats& stats) noexcept
+{
+    if (!m_isOwner)
+        return;     // Attached read only
+    const uint64_t values[Record::VALUE_CNT] = {stats.publishedNs, stats.poolSize, stats.taskCnt, stats.queuedCnt,
+                                                stats.deferredCnt, stats.deadlineMissedCnt, stats.yieldCnt};
+    poolRecord().write(values);
+}
+
+void ShmStatsPage::recordWorkerTask(const uint32_t workerIdx, const uint64_t busyNs, const uint64_t endNs) noexcept
+{
+    if (!m_isOwner || workerIdx >= m_workerCapacity)
+        return;
+    // The worker is the only writer of its record, its current values can be read as they are
+    auto& record = workerRecord(workerIdx);
+    const uint64_t values[Record::VALUE_CNT] = {record.values[0].load(std::memory_order_relaxed) + 1,
+                                                record.values[1].load(std::memory_order_relaxed) + busyNs,
+                                                endNs, 0, 0, 0, 0};
+    record.write(values);
+}
+
+bool ShmStatsPage::readPool(PoolStats& stats) const noexcept
+{
+    uint64_t values[Record::VALUE_CNT];
+    if (!poolRecord().read(values))
+        return false;
+    stats.publishedNs = values[0];
+    stats.poolSize = values[1];
+    stats.taskCnt = values[2];
+    stats.queuedCnt = values[3];
+    stats.deferredCnt = values[4];
+    stats.deadlineMissedCnt = values[5];
+    stats.yieldCnt = values[6];
+    return true;
+}
+
+bool ShmStatsPage::readWorker(const uint32_t workerIdx, WorkerStats& stats) const noexcept
+{
+    uint64_t values[Record::VALUE_CNT];
+    if (workerIdx >= m_workerCapacity || !workerRecord(workerIdx).read(values))
+        return false;
+    stats.taskCnt = values[0];
+    stats.busyNs = values[1];
+    stats.lastTaskEndNs = values[2];
+    return true;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file ShmTaskQueue.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the shared memory task queue.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ShmTaskQueue.hpp"
+
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace t_pool;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory atomics must be lock free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared memory atomics must be lock free");
+
+/**
+ * @brief Header at the start of the segment. The ring positions
+ * are on their own cache lines, producers and consumers of
+ * different processes hammer on them.
+ */
+struct ShmTaskQueue::Header
+{
+    char magic[8];
+    /** @brief Written last by the creator, zero until the segment is initialised */
+    std::atomic<uint32_t> version;
+    uint32_t slotCnt;
+    uint32_t slotSize;
+    uint32_t slotStride;
+    /** @brief Non zero if the ring is to be backed by transparent huge pages */
+    uint32_t hugePages;
+    alignas(64) std::atomic<uint64_t> enqueuePos;
+    alignas(64) std::atomic<uint64_t> dequeuePos;
+};
+
+/**
+ * @brief Header of every slot, the payload follows on the next cache line.
+ * A slot at ring position `pos` is free if its sequence is `pos`, ready if it
+ * is `pos + 1` and free again for the next lap once it is `pos + slotCnt`.
+ */
+struct ShmTaskQueue::SlotHeader
+{
+    std::atomic<uint64_t> sequence;
+    uint32_t payloadSize;
+    uint32_t nameLength;
+    char handlerName[MAX_HANDLER_NAME_LENGTH + 1];
+};
+
+namespace
+{
+    constexpr uint32_t SLOT_HEADER_SIZE = 64;
+
+    inline uint64_t alignUp(const uint64_t value) { return (value + 63) & ~uint64_t(63); }
+
+    inline std::string toSegmentName(const std::string& name)
+    {
+        return (!name.empty() && name.front() == '/') ? name : "/" + name;
+    }
+};
+
+ShmTaskQueue::ShmTaskQueue(const std::string& name,
+                           const uint32_t slotCnt,
+                           const uint32_t slotSize,
+                           const HugePageMode hugePages)
+    : m_name(toSegmentName(name))
+    , m_isOwner(true)
+    , m_slotCnt(std::bit_ceil(std::max<uint32_t>(slotCnt, 1)))
+    , m_slotSize(slotSize)
+    , m_slotStride(static_cast<uint32_t>(alignUp(SLOT_HEADER_SIZE + uint64_t(slotSize))))
+{
+    static_assert(sizeof(SlotHeader) <= SLOT_HEADER_SIZE, "Slot header must fit a cache line");
+    LOG_ENTRY_DBG();
+    auto fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throw std::runtime_error("Unable to create the shared memory queue " + m_name);
+    const auto size = alignUp(sizeof(Header)) + uint64_t(m_slotCnt) * m_slotStride;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        ::close(fd);
+        ::shm_unlink(m_name.c_str());
+        throw std::runtime_error("Unable to size the shared memory queue " + m_name);
+    }
+    try
+    {
+        map(fd, size);
+    }
+    catch (...)
+    {
+        ::shm_unlink(m_name.c_str());
+        throw;
+    }
+
+    m_pHeader = new (m_pMapping) Header{};
+    std::memcpy(m_pHeader->magic, MAGIC, sizeof(MAGIC));
+    m_pHeader->slotCnt = m_slotCnt;
+    m_pHeader->slotSize = m_slotSize;
+    m_pHeader->slotStride = m_slotStride;
+    m_pHeader->hugePages = (hugePages != HugePageMode::OFF);
+    if (m_pHeader->hugePages && !adviseHugePages(m_pMapping, m_mappingSize))
+        LOG_INFO("Shared memory queue {} is backed by regular pages", m_name);
+    for (uint32_t idx = 0; idx < m_slotCnt; ++idx)
+    {
+        auto pSlot = new (m_pSlots + uint64_t(idx) * m_slotStride) SlotHeader{};
+        pSlot->sequence.store(idx, std::memory_order_relaxed);
+    }
+    m_pHeader->version.store(VERSION, std::memory_order_release);
+    LOG_DBG("Shared memory queue {} created with {:d} slots of {:d} bytes", m_name, m_slotCnt, m_slotSize);
+    LOG_EXIT_DBG();
+}
+
+ShmTaskQueue::ShmTaskQueue(const std::string& name)
+    : m_name(toSegmentName(name))
+{
+    LOG_ENTRY_DBG();
+    auto fd = ::shm_open(m_name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        throw std::runtime_error("Unable to open the shared memory queue " + m_name);
+    struct stat segmentStat = {};
+    if (::fstat(fd, &segmentStat) != 0 || static_cast<size_t>(segmentStat.st_size) < alignUp(sizeof(Header)))
+    {
+        ::close(fd);
+        throw std::runtime_error("Shared memory queue " + m_name + " is too small");
+    }
+    map(fd, static_cast<size_t>(segmentStat.st_size));
+    m_pHeader = static_cast<Header*>(m_pMapping);
+
+    // The creator may still be initialising the segment
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (m_pHeader->version.load(std::memory_order_acquire) == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+
+    const char* reason = nullptr;
+    if (std::memcmp(m_pHeader->magic, MAGIC, sizeof(MAGIC)) != 0)
+        reason = "bad magic";
+    else if (m_pHeader->version.load(std::memory_order_acquire) != VERSION)
+        reason = "unsupported version";
+    else if (!std::has_single_bit(m_pHeader->slotCnt) ||
+             m_pHeader->slotStride != alignUp(SLOT_HEADER_SIZE + uint64_t(m_pHeader->slotSize)) ||
+             alignUp(sizeof(Header)) + uint64_t(m_pHeader->slotCnt) * m_pHeader->slotStride > m_mappingSize)
+        reason = "inconsistent geometry";
+    if (reason)
+    {
+        LOG_ERR("Malformed shared memory queue {}: {}", m_name, reason);
+        ::munmap(m_pMapping, m_mappingSize);
+        throw std::runtime_error("Malformed shared memory queue " + m_name + ": " + reason);
+    }
+    m_slotCnt = m_pHeader->slotCnt;
+    m_slotSize = m_pHeader->slotSize;
+    m_slotStride = m_pHeader->slotStride;
+    if (m_pHeader->hugePages)
+        adviseHugePages(m_pMapping, m_mappingSize);
+    LOG_EXIT_DBG();
+}
+
+ShmTaskQueue::~ShmTaskQueue()
+{
+    if (m_pMapping)
+        ::munmap(m_pMapping, m_mappingSize);
+    if (m_isOwner)
+        ::shm_unlink(m_name.c_str());
+}
+
+void ShmTaskQueue::map(const int fd, const size_t size)
+{
+    auto pMapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);   // The mapping keeps the segment referenced
+    if (pMapping == MAP_FAILED)
+        throw std::runtime_error("Unable to map the shared memory queue " + m_name);
+    m_pMapping = pMapping;
+    m_mappingSize = size;
+    m_pSlots = static_cast<char*>(m_pMapping) + alignUp(sizeof(Header));
+}
+
+ShmTaskQueue::SlotHeader& ShmTaskQueue::slotAt(const uint64_t pos) const noexcept
+{
+    return *reinterpret_cast<SlotHeader*>(m_pSlots + (pos & (m_slotCnt - 1)) * m_slotStride);
+}
+
+ShmTaskQueue::WriteSlot ShmTaskQueue::beginPush(std::string_view handlerName, const uint32_t payloadSize)
+{
+    if (handlerName.empty() || handlerName.size() > MAX_HANDLER_NAME_LENGTH)
+        throw std::invalid_argument("Handler name must be 1 to " + std::to_string(MAX_HANDLER_NAME_LENGTH) +
+                                    " characters long");
+    if (payloadSize > m_slotSize)
+        throw std::invalid_argument("Payload of " + std::to_string(payloadSize) + " bytes exceeds the slot size");
+
+    WriteSlot slot;
+    auto pos = m_pHeader->enqueuePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto& slotHeader = slotAt(pos);
+        auto seqDiff = static_cast<int64_t>(slotHeader.sequence.load(std::memory_order_acquire) - pos);
+        if (seqDiff == 0)
+        {
+            if (m_pHeader->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (seqDiff < 0)
+        {
+            return slot;    // Full, the slot of the previous lap is still in use
+        }
+        else
+        {
+            pos = m_pHeader->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto& slotHeader = slotAt(pos);
+    slotHeader.payloadSize = payloadSize;
+    slotHeader.nameLength = static_cast<uint32_t>(handlerName.size());
+    std::memcpy(slotHeader.handlerName, handlerName.data(), handlerName.size());
+    slot.pData = reinterpret_cast<char*>(&slotHeader) + SLOT_HEADER_SIZE;
+    slot.capacity = payloadSize;
+    slot.pos = pos;
+    return slot;
+}
+
+void ShmTaskQueue::commitPush(const WriteSlot& slot)
+{
+    slotAt(slot.pos).sequence.store(slot.pos + 1, std::memory_order_release);
+}
+
+bool ShmTaskQueue::tryPush(std::string_view handlerName, const void* pPayload, const uint32_t payloadSize)
+{
+    auto slot = beginPush(handlerName, payloadSize);
+    if (!slot)
+        return false;
+    if (payloadSize)
+        std::memcpy(slot.pData, pPayload, payloadSize);
+    commitPush(slot);
+    return true;
+}
+
+bool ShmTaskQueue::tryPop(ReadSlot& slot)
+{
+    auto pos = m_pHeader->dequeuePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto& slotHeader = slotAt(pos);
+        auto seqDiff = static_cast<int64_t>(slotHeader.sequence.load(std::memory_order_acquire) - (pos + 1));
+        if (seqDiff == 0)
+        {
+            if (m_pHeader->dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (seqDiff < 0)
+        {
+            return false;   // Empty, or the next descriptor is still being written
+        }
+        else
+        {
+            pos = m_pHeader->dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    const auto& slotHeader = slotAt(pos);
+    slot.handlerName = std::string_view(slotHeader.handlerName,
+                                        std::min<size_t>(slotHeader.nameLength, MAX_HANDLER_NAME_LENGTH));
+    slot.pData = reinterpret_cast<const char*>(&slotHeader) + SLOT_HEADER_SIZE;
+    slot.size = std::min(slotHeader.payloadSize, m_slotSize);
+    slot.pos = pos;
+    return true;
+}
+
+void ShmTaskQueue::release(const ReadSlot& slot)
+{
+    slotAt(slot.pos).sequence.store(slot.pos + m_slotCnt, std::memory_order_release);
+}
+
+size_t ShmTaskQueue::serve(ThreadPool& pool, const ShmHandlerRegistry& registry, const size_t maxTasks)
+{
+    size_t takenCnt = 0;
+    ReadSlot slot;
+    while (takenCnt < maxTasks && tryPop(slot))
+    {
+        ++takenCnt;
+        auto pHandler = registry.find(slot.handlerName);
+        if (!pHandler)
+        {
+            LOG_ERR("No handler {} registered, task descriptor dropped", slot.handlerName);
+            release(slot);
+            continue;
+        }
+        pool.submit([this, pHandler, slot]()
+        {
+            try
+            {
+                (*pHandler)(slot.pData, slot.size);
+            }
+            catch (...)
+            {
+                release(slot);
+                throw;
+            }
+            release(slot);
+        });
+    }
+    return takenCnt;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file TaskContext.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the current task context of a thread.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TaskContext.hpp"
+
+using namespace t_pool;
+
+namespace
+{
+    thread_local TaskContext t_currentContext;
+};
+
+const TaskContext& TaskContext::getCurrent() noexcept
+{
+    return t_currentContext;
+}
+
+TaskContext::Scope::Scope(const TaskContext& context) noexcept
+    : m_previous(t_currentContext)
+{
+    t_currentContext = context;
+}
+
+TaskContext::Scope::~Scope()
+{
+    t_currentContext = m_previous;
+}
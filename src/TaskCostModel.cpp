@@ -0,0 +1,263 @@
+/**
+ * @file TaskCostModel.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the historical task cost model.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TaskCostModel.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+using namespace t_pool;
+
+TaskCostModel::TaskCostModel(const size_t capacity, const double alpha)
+    : m_capacity(std::bit_ceil(std::max<size_t>(capacity, 1)))
+    , m_alpha(std::clamp(alpha, std::numeric_limits<double>::min(), 1.0))
+    , m_pEntries(std::make_unique<Entry[]>(m_capacity))
+{
+}
+
+TaskCostModel::TaskCostModel(const std::string& persistPath, const size_t capacity, const double alpha)
+    : TaskCostModel(capacity, alpha)
+{
+    m_persistPath = persistPath;
+    if (!load(m_persistPath))
+        LOG_INFO("No task cost history loaded from {}, starting afresh", m_persistPath);
+}
+
+TaskCostModel::~TaskCostModel()
+{
+    if (!m_persistPath.empty())
+        save(m_persistPath);
+}
+
+uint64_t TaskCostModel::hashName(std::string_view taskName) noexcept
+{
+    // FNV-1a, zero is reserved for the free entries
+    uint64_t hash = 14695981039346656037ull;
+    for (auto chr : taskName)
+    {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= 1099511628211ull;
+    }
+    return hash ? hash : 1;
+}
+
+TaskCostModel::Entry* TaskCostModel::findEntry(std::string_view taskName, const bool create) const
+{
+    if (taskName.empty() || taskName.size() > MAX_NAME_LENGTH)
+        return nullptr;
+
+    const auto hash = hashName(taskName);
+    const auto mask = m_capacity - 1;
+    for (size_t probe = 0; probe < m_capacity; ++probe)
+    {
+        auto& entry = m_pEntries[(hash + probe) & mask];
+        auto entryHash = entry.nameHash.load(std::memory_order_acquire);
+        if (!entryHash)
+        {
+            if (!create)
+                return nullptr;
+            if (entry.nameHash.compare_exchange_strong(entryHash, hash, std::memory_order_acq_rel))
+            {
+                std::memcpy(entry.name, taskName.data(), taskName.size());
+                entry.nameLength = static_cast<uint32_t>(taskName.size());
+                entry.ready.store(true, std::memory_order_release);
+                return &entry;
+            }
+            // Lost the race, entryHash now holds the hash of the winner
+        }
+        if (entryHash == hash)
+        {
+            // The claiming thread is a few stores away from publishing the name
+            while (!entry.ready.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            if (std::string_view(entry.name, entry.nameLength) == taskName)
+                return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void TaskCostModel::record(std::string_view taskName, const std::chrono::nanoseconds duration)
+{
+    auto pEntry = findEntry(taskName, true);
+    if (!pEntry)
+    {
+        if (!taskName.empty())
+            LOG_DBG("Task {} can't be tracked by the cost model", taskName);
+        return;
+    }
+
+    // The very first sample initialises the averages
+    const auto alpha = pEntry->sampleCnt.fetch_add(1, std::memory_order_relaxed) ? m_alpha : 1.0;
+    const auto sample = static_cast<double>(duration.count());
+    auto mean = pEntry->mean.load(std::memory_order_relaxed);
+    auto delta = 0.0;
+    do
+    {
+        delta = sample - mean;
+    } while (!pEntry->mean.compare_exchange_weak(mean, mean + alpha * delta, std::memory_order_relaxed));
+
+    auto variance = pEntry->variance.load(std::memory_order_relaxed);
+    while (!pEntry->variance.compare_exchange_weak(variance, (1.0 - alpha) * (variance + alpha * delta * delta),
+                                                   std::memory_order_relaxed));
+}
+
+TaskCostEstimate TaskCostModel::getEstimate(std::string_view taskName) const
+{
+    TaskCostEstimate estimate;
+    auto pEntry = findEntry(taskName, false);
+    if (pEntry)
+    {
+        estimate.sampleCnt = pEntry->sampleCnt.load(std::memory_order_relaxed);
+        estimate.mean = std::chrono::nanoseconds(std::llround(pEntry->mean.load(std::memory_order_relaxed)));
+        estimate.stdDev = std::chrono::nanoseconds(
+            std::llround(std::sqrt(std::max(pEntry->variance.load(std::memory_order_relaxed), 0.0))));
+    }
+    return estimate;
+}
+
+std::chrono::nanoseconds TaskCostModel::predict(std::string_view taskName, const std::chrono::nanoseconds defaultCost) const
+{
+    auto estimate = getEstimate(taskName);
+    return estimate.sampleCnt ? estimate.mean : defaultCost;
+}
+
+size_t TaskCostModel::suggestGrainSize(std::string_view itemTaskName,
+                                       const std::chrono::nanoseconds targetChunkDuration,
+                                       const size_t maxGrainSize) const
+{
+    const auto maxGrain = std::max<size_t>(maxGrainSize, 1);
+    auto estimate = getEstimate(itemTaskName);
+    if (!estimate.sampleCnt || estimate.mean.count() <= 0)
+        return maxGrain;
+    auto grain = static_cast<size_t>(targetChunkDuration.count() / estimate.mean.count());
+    return std::clamp<size_t>(grain, 1, maxGrain);
+}
+
+bool TaskCostModel::save(const std::string& path) const
+{
+    LOG_ENTRY_DBG();
+    // Written aside and renamed, a crash never leaves a half written file behind
+    const auto tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERR("Failed to open {} for writing", tmpPath);
+            LOG_EXIT_DBG();
+            return false;
+        }
+        file.precision(std::numeric_limits<double>::max_digits10);
+        file << "# TPool task cost model v1: name mean_ns variance_ns2 samples\n";
+        for (size_t idx = 0; idx < m_capacity; ++idx)
+        {
+            const auto& entry = m_pEntries[idx];
+            if (!entry.ready.load(std::memory_order_acquire))
+                continue;
+            std::string_view name(entry.name, entry.nameLength);
+            if (name.find_first_of("\t\n") != std::string_view::npos)
+                continue;
+            file << name << '\t'
+                 << entry.mean.load(std::memory_order_relaxed) << '\t'
+                 << entry.variance.load(std::memory_order_relaxed) << '\t'
+                 << entry.sampleCnt.load(std::memory_order_relaxed) << '\n';
+        }
+        if (!file.flush())
+        {
+            LOG_ERR("Failed to write {}", tmpPath);
+            LOG_EXIT_DBG();
+            return false;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()))
+    {
+        LOG_ERR("Failed to rename {} to {}", tmpPath, path);
+        std::remove(tmpPath.c_str());
+        LOG_EXIT_DBG();
+        return false;
+    }
+    LOG_EXIT_DBG();
+    return true;
+}
+
+bool TaskCostModel::load(const std::string& path)
+{
+    LOG_ENTRY_DBG();
+    std::ifstream file(path);
+    if (!file)
+    {
+        LOG_EXIT_DBG();
+        return false;
+    }
+
+    size_t lineNo = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        ++lineNo;
+        if (line.empty() || line.front() == '#')
+            continue;
+        auto nameEnd = line.find('\t');
+        double mean = 0.0;
+        double variance = 0.0;
+        uint64_t sampleCnt = 0;
+        std::istringstream fields(nameEnd == std::string::npos ? std::string() : line.substr(nameEnd + 1));
+        if (nameEnd == std::string::npos || !(fields >> mean >> variance >> sampleCnt) || !sampleCnt)
+        {
+            LOG_ERR("Malformed line {:d} in {}, skipped", lineNo, path);
+            continue;
+        }
+        auto pEntry = findEntry(std::string_view(line).substr(0, nameEnd), true);
+        if (pEntry)
+        {
+            pEntry->mean.store(mean, std::memory_order_relaxed);
+            pEntry->variance.store(variance, std::memory_order_relaxed);
+            pEntry->sampleCnt.store(sampleCnt, std::memory_order_relaxed);
+        }
+    }
+    LOG_EXIT_DBG();
+    return true;
+}
+
+size_t TaskCostModel::getTaskCnt() const noexcept
+{
+    size_t taskCnt = 0;
+    for (size_t idx = 0; idx < m_capacity; ++idx)
+    {
+        if (m_pEntries[idx].ready.load(std::memory_order_relaxed))
+            ++taskCnt;
+    }
+    return taskCnt;
+}
@@ -1,7 +1,52 @@
 #include "TaskDAG.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+
 using namespace t_pool;
 
+namespace
+{
+    /**
+     * @brief Computes the earliest start of every node and the longest path from
+     * every node start to the end of the graph.
+     *
+     * @param [in] graph The compiled graph.
+     * @param [in] estimates The estimated duration of every node.
+     * @param [out] head The earliest start of every node.
+     * @param [out] tail The longest path from the start of every node to the end.
+     * @return double The length of the critical path.
+     */
+    double computeCriticalPath(const CompiledTDAG& graph,
+                               const std::vector<double>& estimates,
+                               std::vector<double>& head,
+                               std::vector<double>& tail)
+    {
+        head.assign(graph.tasks.size(), 0.0);
+        tail.assign(graph.tasks.size(), 0.0);
+        for (auto nodeIdx : graph.order)
+        {
+            for (auto edge = graph.offsets[nodeIdx]; edge < graph.offsets[nodeIdx + 1]; ++edge)
+            {
+                auto& succHead = head[graph.targets[edge]];
+                succHead = std::max(succHead, head[nodeIdx] + estimates[nodeIdx]);
+            }
+        }
+        auto makespan = 0.0;
+        for (auto itr = graph.order.rbegin(); itr != graph.order.rend(); ++itr)
+        {
+            auto longestSucc = 0.0;
+            for (auto edge = graph.offsets[*itr]; edge < graph.offsets[*itr + 1]; ++edge)
+                longestSucc = std::max(longestSucc, tail[graph.targets[edge]]);
+            tail[*itr] = estimates[*itr] + longestSucc;
+            makespan = std::max(makespan, head[*itr] + tail[*itr]);
+        }
+        return makespan;
+    }
+};
+
 TDAG& TDAG::addTask(Task&& task)
 {
     LOG_ENTRY_DBG();
@@ -37,6 +82,7 @@ TDAG& TDAG::addDependency(Task&& task)
         {
             auto pTask = std::shared_ptr<Task>(new Task(std::move(task)));
             m_taskIdMap[pTask->getTaskId()] = std::make_pair(pTask, 0);
+            m_taskGraph.try_emplace(pTask->getTaskId());
             dependencyVec.emplace_back(pTask->getTaskId());
             ++inDegree;
         }
@@ -122,3 +168,518 @@ bool TDAG::removeDependencyRecurs(const uint32_t taskId)
     LOG_EXIT_DBG();
     return retVal;
 }
+
+std::vector<uint32_t> TDAG::getDependencies(const uint32_t taskId) const
+{
+    auto graphItr = m_taskGraph.find(taskId);
+    return (graphItr == m_taskGraph.end()) ? std::vector<uint32_t>{} : graphItr->second;
+}
+
+void TDAG::insertTask(std::shared_ptr<Task> pTask)
+{
+    const auto taskId = static_cast<uint32_t>(pTask->getTaskId());
+    if (m_taskIdMap.try_emplace(taskId, std::move(pTask), 0).second)
+        m_taskGraph.try_emplace(taskId);
+    else
+        LOG_INFO("Task {:d} is already added earlier", taskId);
+}
+
+bool TDAG::insertDependency(const uint32_t taskId, const uint32_t dependencyId)
+{
+    auto itr = m_taskIdMap.find(taskId);
+    if (itr == m_taskIdMap.end() || !m_taskIdMap.count(dependencyId))
+    {
+        LOG_ERR("Dependency {:d} of task {:d} refers to a task which is not added",
+                dependencyId, taskId);
+        return false;
+    }
+    auto& dependencyVec = m_taskGraph[taskId];
+    if (std::find(dependencyVec.cbegin(), dependencyVec.cend(), dependencyId) != dependencyVec.cend())
+    {
+        LOG_INFO("Dependency {:d} has already been added", dependencyId);
+        return false;
+    }
+    dependencyVec.emplace_back(dependencyId);
+    ++itr->second.second;
+    return true;
+}
+
+ConcurrentDAGBuilder::Shard& ConcurrentDAGBuilder::getShard() noexcept
+{
+    // Every thread sticks to one shard, so the shard locks are practically uncontended
+    thread_local const auto threadHash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return m_pShards[threadHash % m_shardCnt];
+}
+
+uint32_t ConcurrentDAGBuilder::addTask(Task&& task)
+{
+    auto pTask = std::shared_ptr<Task>(new Task(std::move(task)));
+    const auto taskId = static_cast<uint32_t>(pTask->getTaskId());
+    auto& shard = getShard();
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.tasks.emplace_back(std::move(pTask));
+    return taskId;
+}
+
+void ConcurrentDAGBuilder::addDependency(const uint32_t taskId, const uint32_t dependencyId)
+{
+    auto& shard = getShard();
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.dependencies.emplace_back(taskId, dependencyId);
+}
+
+void ConcurrentDAGBuilder::mergeInto(TDAG& dag)
+{
+    LOG_ENTRY_DBG();
+    size_t taskCnt = 0;
+    size_t dependencyCnt = 0;
+    for (uint32_t idx = 0; idx < m_shardCnt; ++idx)
+    {
+        taskCnt += m_pShards[idx].tasks.size();
+        dependencyCnt += m_pShards[idx].dependencies.size();
+    }
+    dag.m_taskIdMap.reserve(dag.m_taskIdMap.size() + taskCnt);
+    dag.m_taskGraph.reserve(dag.m_taskGraph.size() + taskCnt);
+
+    // All the tasks first, a dependency may refer to a task of any shard
+    for (uint32_t idx = 0; idx < m_shardCnt; ++idx)
+    {
+        for (auto& pTask : m_pShards[idx].tasks)
+            dag.insertTask(std::move(pTask));
+        m_pShards[idx].tasks.clear();
+    }
+    for (uint32_t idx = 0; idx < m_shardCnt; ++idx)
+    {
+        for (const auto& [taskId, dependencyId] : m_pShards[idx].dependencies)
+            dag.insertDependency(taskId, dependencyId);
+        m_pShards[idx].dependencies.clear();
+    }
+    LOG_DBG("Merged {:d} tasks and {:d} dependencies into the DAG", taskCnt, dependencyCnt);
+    LOG_EXIT_DBG();
+}
+
+DataHandle DataflowDAGBuilder::registerData(std::string_view name)
+{
+    m_data.emplace_back().name = name;
+    return DataHandle{static_cast<uint32_t>(m_data.size() - 1)};
+}
+
+uint32_t DataflowDAGBuilder::addTask(Task&& task, const std::vector<DataAccess>& accesses)
+{
+    // One access per piece of data, with the strongest mode asked for
+    std::vector<DataAccess> merged;
+    merged.reserve(accesses.size());
+    for (const auto& access : accesses)
+    {
+        if (access.handle.id >= m_data.size())
+            throw std::invalid_argument("Data handle " + std::to_string(access.handle.id) + " is not registered");
+        auto itr = std::find_if(merged.begin(), merged.end(),
+                                [&access](const DataAccess& other) { return other.handle.id == access.handle.id; });
+        if (itr == merged.end())
+            merged.emplace_back(access);
+        else if (itr->mode != access.mode)
+            itr->mode = AccessMode::READ_WRITE;
+    }
+
+    const auto taskId = static_cast<uint32_t>(task.getTaskId());
+    std::vector<uint32_t> dependencyIds;
+    auto dependOn = [&dependencyIds, taskId](const std::vector<uint32_t>& taskIds)
+    {
+        for (auto dependencyId : taskIds)
+        {
+            if (dependencyId != taskId &&
+                std::find(dependencyIds.cbegin(), dependencyIds.cend(), dependencyId) == dependencyIds.cend())
+                dependencyIds.emplace_back(dependencyId);
+        }
+    };
+
+    for (const auto& access : merged)
+    {
+        auto& data = m_data[access.handle.id];
+        switch (access.mode)
+        {
+            case AccessMode::READ:
+                dependOn(data.writers);     // RAW
+                data.readers.emplace_back(taskId);
+                break;
+
+            case AccessMode::WRITE:
+            case AccessMode::READ_WRITE:
+                // WAR, the readers already wait for the writers, else WAW (and RAW)
+                dependOn(data.readers.empty() ? data.writers : data.readers);
+                data.writers.assign(1, taskId);
+                data.readers.clear();
+                data.isConcurrentGroup = false;
+                break;
+
+            case AccessMode::CONCURRENT:
+                if (data.isConcurrentGroup && data.readers.empty())
+                {
+                    // Joins the group, waiting for what the group waits for
+                    dependOn(data.groupDeps);
+                    data.writers.emplace_back(taskId);
+                    break;
+                }
+                data.groupDeps = data.readers.empty() ? data.writers : data.readers;
+                dependOn(data.groupDeps);
+                data.writers.assign(1, taskId);
+                data.readers.clear();
+                data.isConcurrentGroup = true;
+                break;
+        }
+    }
+
+    LOG_DBG("Task {:d} depends upon {:d} tasks as per its {:d} data accesses",
+            taskId, dependencyIds.size(), merged.size());
+    m_tasks.emplace_back(std::make_shared<Task>(std::move(task)));
+    for (auto dependencyId : dependencyIds)
+        m_dependencies.emplace_back(taskId, dependencyId);
+    return taskId;
+}
+
+void DataflowDAGBuilder::mergeInto(TDAG& dag)
+{
+    LOG_ENTRY_DBG();
+    dag.m_taskIdMap.reserve(dag.m_taskIdMap.size() + m_tasks.size());
+    dag.m_taskGraph.reserve(dag.m_taskGraph.size() + m_tasks.size());
+    for (auto& pTask : m_tasks)
+        dag.insertTask(std::move(pTask));
+    for (const auto& [taskId, dependencyId] : m_dependencies)
+        dag.insertDependency(taskId, dependencyId);
+    LOG_DBG("Merged {:d} tasks and {:d} derived dependencies into the DAG", m_tasks.size(), m_dependencies.size());
+    m_tasks.clear();
+    m_dependencies.clear();
+    for (auto& data : m_data)
+    {
+        data.writers.clear();
+        data.readers.clear();
+        data.groupDeps.clear();
+        data.isConcurrentGroup = false;
+    }
+    LOG_EXIT_DBG();
+}
+
+TaskDurationHistory& TaskDurationHistory::global()
+{
+    static TaskDurationHistory history;
+    return history;
+}
+
+void TaskDurationHistory::record(std::string_view taskName, const std::chrono::nanoseconds duration)
+{
+    if (taskName.empty())
+        return;
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto& samples = m_samples[std::string(taskName)];
+    samples.durations[samples.next] = duration.count();
+    samples.next = (samples.next + 1) % WINDOW_SIZE;
+    samples.count = std::min(samples.count + 1, WINDOW_SIZE);
+}
+
+size_t TaskDurationHistory::getSampleCnt(std::string_view taskName) const
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+    auto itr = m_samples.find(std::string(taskName));
+    return (itr == m_samples.end()) ? 0 : itr->second.count;
+}
+
+std::chrono::nanoseconds TaskDurationHistory::getPercentile(std::string_view taskName, const double percentile) const
+{
+    std::array<int64_t, WINDOW_SIZE> durations;
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        auto itr = m_samples.find(std::string(taskName));
+        if (itr == m_samples.end() || !itr->second.count)
+            return std::chrono::nanoseconds(0);
+        count = itr->second.count;
+        std::copy_n(itr->second.durations.cbegin(), count, durations.begin());
+    }
+    // Nearest rank percentile
+    auto rank = static_cast<size_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(count)));
+    auto pos = durations.begin() + static_cast<std::ptrdiff_t>(rank ? rank - 1 : 0);
+    std::nth_element(durations.begin(), pos, durations.begin() + static_cast<std::ptrdiff_t>(count));
+    return std::chrono::nanoseconds(*pos);
+}
+
+CompiledTDAG TDAG::compile() const
+{
+    LOG_ENTRY_DBG();
+    CompiledTDAG graph;
+    const auto taskCnt = m_taskIdMap.size();
+    graph.taskIds.reserve(taskCnt);
+    graph.tasks.reserve(taskCnt);
+    std::unordered_map<uint32_t, uint32_t> nodeIndices;
+    nodeIndices.reserve(taskCnt);
+    for (const auto& [taskId, taskInfo] : m_taskIdMap)
+    {
+        nodeIndices.emplace(taskId, static_cast<uint32_t>(graph.tasks.size()));
+        graph.taskIds.emplace_back(taskId);
+        graph.tasks.emplace_back(taskInfo.first);
+    }
+
+    // An edge runs from every dependency to the task depending upon it
+    graph.offsets.assign(taskCnt + 1, 0);
+    for (const auto& [taskId, dependencies] : m_taskGraph)
+    {
+        for (const auto& dependencyId : dependencies)
+            ++graph.offsets[nodeIndices.at(dependencyId) + 1];
+    }
+    for (size_t idx = 0; idx < taskCnt; ++idx)
+        graph.offsets[idx + 1] += graph.offsets[idx];
+    graph.targets.resize(graph.offsets[taskCnt]);
+    auto fillPos = graph.offsets;
+    for (const auto& [taskId, dependencies] : m_taskGraph)
+    {
+        for (const auto& dependencyId : dependencies)
+            graph.targets[fillPos[nodeIndices.at(dependencyId)]++] = nodeIndices.at(taskId);
+    }
+
+    if (!DagExecutor::getTopologicalOrder(graph.getGraphView(), graph.order))
+    {
+        LOG_ERR("The task graph has a cycle, it can't be executed");
+        throw std::logic_error("Task graph has a cycle");
+    }
+
+    // A node is one level below its deepest dependency, the nodes are bucketed by level
+    std::vector<uint32_t> levels(taskCnt, 0);
+    uint32_t levelCnt = taskCnt ? 1 : 0;
+    for (auto nodeIdx : graph.order)
+    {
+        for (auto edge = graph.offsets[nodeIdx]; edge < graph.offsets[nodeIdx + 1]; ++edge)
+        {
+            auto& succLevel = levels[graph.targets[edge]];
+            succLevel = std::max(succLevel, levels[nodeIdx] + 1);
+            levelCnt = std::max(levelCnt, succLevel + 1);
+        }
+    }
+    graph.levelOffsets.assign(levelCnt + 1, 0);
+    for (auto level : levels)
+        ++graph.levelOffsets[level + 1];
+    for (uint32_t level = 0; level < levelCnt; ++level)
+        graph.levelOffsets[level + 1] += graph.levelOffsets[level];
+    graph.levelNodes.resize(taskCnt);
+    auto levelFillPos = graph.levelOffsets;
+    for (auto nodeIdx : graph.order)
+        graph.levelNodes[levelFillPos[levels[nodeIdx]]++] = nodeIdx;
+    LOG_EXIT_DBG();
+    return graph;
+}
+
+void TDAG::execute(ThreadPool& pool)
+{
+    LOG_ENTRY_DBG();
+    m_speculationCnt = 0;
+    auto graph = compile();
+    m_lastExecutionMode = chooseExecutionMode(pool, graph);
+    if (m_speculation.enabled && m_lastExecutionMode == DagExecutionMode::DATAFLOW)
+    {
+        executeSpeculative(pool, graph);
+        LOG_EXIT_DBG();
+        return;
+    }
+
+    auto runNode = [&graph, pCostModel = pool.getCostModel()](uint32_t nodeIdx)
+    {
+        auto& task = *graph.tasks[nodeIdx];
+        // In the context and the memory group the node was created in, not the ones of its releaser
+        TaskContext::Scope contextScope(task.getContext());
+        MemoryGroup::Scope memoryScope(task.getMemoryGroup().get());
+        if (!pCostModel)
+        {
+            task.runAndForget();
+            return;
+        }
+        auto startTime = std::chrono::steady_clock::now();
+        if (task.runAndForget())
+            pCostModel->record(task.getTaskName(), std::chrono::steady_clock::now() - startTime);
+    };
+    if (m_lastExecutionMode == DagExecutionMode::LEVELS)
+    {
+        executeLevels(pool, graph, runNode);
+    }
+    else
+    {
+        DagExecutor executor(pool);
+        executor.run(graph.getGraphView(), runNode);
+    }
+    LOG_EXIT_DBG();
+}
+
+DagExecutionMode TDAG::chooseExecutionMode(const ThreadPool& pool, const CompiledTDAG& graph) const noexcept
+{
+    if (m_executionMode != DagExecutionMode::AUTO)
+        return m_executionMode;
+    if (m_speculation.enabled || !graph.getLevelCnt())
+        return DagExecutionMode::DATAFLOW;
+    // Wide and shallow: the barriers are amortised over many nodes per level and worker
+    const uint64_t minWidth = uint64_t(LEVEL_MIN_WIDTH_PER_WORKER) * std::max<uint64_t>(pool.getPoolSize(), 1);
+    return (graph.tasks.size() >= minWidth * graph.getLevelCnt()) ? DagExecutionMode::LEVELS
+                                                                  : DagExecutionMode::DATAFLOW;
+}
+
+void TDAG::executeLevels(ThreadPool& pool, const CompiledTDAG& graph, const DagExecutor::NodeFunc& runNode)
+{
+    LOG_ENTRY_DBG();
+    const ui32 workerCnt = std::max<ui32>(pool.getPoolSize(), 1);
+    std::exception_ptr pError;
+    std::mutex errorMtx;
+    for (uint32_t level = 0; level < graph.getLevelCnt() && !pError; ++level)
+    {
+        const auto levelBegin = graph.levelOffsets[level];
+        const auto levelWidth = graph.levelOffsets[level + 1] - levelBegin;
+
+        // The workers and the calling thread claim batches of the level until it is exhausted
+        const auto loopCnt = std::min<uint64_t>(workerCnt + 1, levelWidth);
+        const auto batchSize = std::max<uint64_t>(levelWidth / (loopCnt * 8), 1);
+        std::atomic<uint64_t> nextPos = 0;
+        auto loop = [&]()
+        {
+            try
+            {
+                for (auto pos = nextPos.fetch_add(batchSize, std::memory_order_relaxed); pos < levelWidth;
+                     pos = nextPos.fetch_add(batchSize, std::memory_order_relaxed))
+                {
+                    auto batchEnd = std::min<uint64_t>(pos + batchSize, levelWidth);
+                    for (; pos < batchEnd; ++pos)
+                        runNode(graph.levelNodes[levelBegin + pos]);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMtx);
+                if (!pError)
+                    pError = std::current_exception();
+                nextPos = levelWidth;   // Skips the rest of the level
+            }
+        };
+        std::vector<std::future<std::any>> helpers;
+        helpers.reserve(loopCnt - 1);
+        for (uint64_t idx = 1; idx < loopCnt; ++idx)
+            helpers.emplace_back(pool.submit(loop));
+        loop();
+        for (auto& helper : helpers)    // The barrier
+            helper.get();
+    }
+    LOG_DBG("{:d} nodes executed in {:d} levels", graph.tasks.size(), graph.getLevelCnt());
+    LOG_EXIT_DBG();
+    if (pError)
+        std::rethrow_exception(pError);
+}
+
+std::chrono::nanoseconds TDAG::estimateCriticalPath(const TaskCostModel& costModel,
+                                                    const std::chrono::nanoseconds defaultCost) const
+{
+    auto graph = compile();
+    std::vector<double> estimates(graph.tasks.size());
+    for (size_t idx = 0; idx < graph.tasks.size(); ++idx)
+        estimates[idx] = static_cast<double>(costModel.predict(graph.tasks[idx]->getTaskName(), defaultCost).count());
+    std::vector<double> head;
+    std::vector<double> tail;
+    return std::chrono::nanoseconds(std::llround(computeCriticalPath(graph, estimates, head, tail)));
+}
+
+void TDAG::executeSpeculative(ThreadPool& pool, const CompiledTDAG& graph)
+{
+    LOG_ENTRY_DBG();
+    using namespace std::chrono;
+    const auto nodeCnt = graph.tasks.size();
+
+    /**
+     * State shared with the node runs. The losing run of a duplicated
+     * node may still be executing after the graph has completed.
+     */
+    struct SpeculativeRun
+    {
+        std::vector<std::shared_ptr<Task>> tasks;
+        // When every node started, steady clock nanoseconds, 0 if not yet
+        std::unique_ptr<std::atomic<int64_t>[]> pStartTimes;
+        std::shared_ptr<TaskDurationHistory> pHistoryOwner;
+        TaskDurationHistory* pHistory = nullptr;
+        std::shared_ptr<TaskCostModel> pCostModel;
+    };
+    auto pRun = std::make_shared<SpeculativeRun>();
+    pRun->tasks = graph.tasks;
+    pRun->pStartTimes = std::make_unique<std::atomic<int64_t>[]>(nodeCnt);
+    pRun->pHistoryOwner = m_speculation.pHistory;
+    pRun->pHistory = m_speculation.pHistory ? m_speculation.pHistory.get() : &TaskDurationHistory::global();
+    pRun->pCostModel = pool.getCostModel();
+    const auto& history = *pRun->pHistory;
+
+    // Estimate the critical path from the cost model, or else from the median
+    // durations. Unknown tasks count as one unit.
+    std::vector<double> estimates(nodeCnt, 1.0);
+    for (size_t idx = 0; idx < nodeCnt; ++idx)
+    {
+        const auto taskName = graph.tasks[idx]->getTaskName();
+        auto estimate = pRun->pCostModel ? pRun->pCostModel->predict(taskName, nanoseconds(0)).count()
+                                         : history.getPercentile(taskName, 0.5).count();
+        if (estimate > 0)
+            estimates[idx] = static_cast<double>(estimate);
+    }
+    std::vector<double> head;   // Earliest start
+    std::vector<double> tail;   // Longest path from the node start to the end
+    auto makespan = computeCriticalPath(graph, estimates, head, tail);
+
+    // The idempotent critical nodes with enough history get a straggler threshold
+    struct Candidate
+    {
+        uint32_t nodeIdx;
+        int64_t thresholdNs;
+        bool launched;
+    };
+    std::vector<Candidate> candidates;
+    for (uint32_t idx = 0; idx < nodeCnt; ++idx)
+    {
+        const auto& task = *graph.tasks[idx];
+        if (!task.isIdempotent() || head[idx] + tail[idx] < makespan * (1.0 - 1e-9))
+            continue;
+        if (history.getSampleCnt(task.getTaskName()) < m_speculation.minSamples)
+            continue;
+        auto threshold = static_cast<double>(history.getPercentile(task.getTaskName(), m_speculation.percentile).count());
+        candidates.push_back(Candidate{idx, static_cast<int64_t>(threshold * m_speculation.slack), false});
+    }
+    LOG_DBG("{:d} of {:d} nodes are candidates for speculative execution", candidates.size(), nodeCnt);
+
+    DagExecutor executor(pool);
+    auto onWait = [this, &executor, &candidates, &pRun]()
+    {
+        auto now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+        for (auto& candidate : candidates)
+        {
+            if (candidate.launched)
+                continue;
+            auto startTime = pRun->pStartTimes[candidate.nodeIdx].load(std::memory_order_acquire);
+            if (!startTime || pRun->tasks[candidate.nodeIdx]->isCompleted())
+                continue;
+            if (now - startTime > candidate.thresholdNs)
+            {
+                LOG_INFO("Task {:d} is straggling, launching a duplicate",
+                         pRun->tasks[candidate.nodeIdx]->getTaskId());
+                candidate.launched = true;
+                ++m_speculationCnt;
+                executor.duplicate(candidate.nodeIdx);
+            }
+        }
+    };
+    executor.run(graph.getGraphView(), [pRun](uint32_t nodeIdx)
+    {
+        auto& task = *pRun->tasks[nodeIdx];
+        TaskContext::Scope contextScope(task.getContext());
+        MemoryGroup::Scope memoryScope(task.getMemoryGroup().get());
+        auto startTime = steady_clock::now();
+        int64_t notStarted = 0;
+        pRun->pStartTimes[nodeIdx].compare_exchange_strong(notStarted,
+                                                           duration_cast<nanoseconds>(startTime.time_since_epoch()).count(),
+                                                           std::memory_order_acq_rel);
+        // Only the run which completes the node contributes to the history
+        if (task.runAndForget())
+        {
+            auto duration = steady_clock::now() - startTime;
+            pRun->pHistory->record(task.getTaskName(), duration);
+            if (pRun->pCostModel)
+                pRun->pCostModel->record(task.getTaskName(), duration);
+        }
+    }, onWait, duration_cast<microseconds>(m_speculation.checkInterval));
+    LOG_EXIT_DBG();
+}
@@ -0,0 +1,126 @@
+/**
+ * @file TaskGraph.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the replay of the captured task graphs.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TaskGraph.hpp"
+
+#include <logger/LOGGER_MACROS.hpp>
+
+using namespace t_pool;
+using namespace logger;
+
+void TaskGraph::compile()
+{
+    LOG_ENTRY_DBG();
+    // An edge runs from every dependency to the task depending upon it
+    const auto nodeCnt = m_nodes.size();
+    m_offsets.assign(nodeCnt + 1, 0);
+    for (const auto& node : m_nodes)
+    {
+        for (auto depIdx : node.argDeps)
+            ++m_offsets[depIdx + 1];
+        for (auto depIdx : node.extraDeps)
+            ++m_offsets[depIdx + 1];
+    }
+    for (size_t idx = 0; idx < nodeCnt; ++idx)
+        m_offsets[idx + 1] += m_offsets[idx];
+    m_targets.resize(m_offsets[nodeCnt]);
+    auto fillPos = m_offsets;
+    for (uint32_t nodeIdx = 0; nodeIdx < nodeCnt; ++nodeIdx)
+    {
+        for (auto depIdx : m_nodes[nodeIdx].argDeps)
+            m_targets[fillPos[depIdx]++] = nodeIdx;
+        for (auto depIdx : m_nodes[nodeIdx].extraDeps)
+            m_targets[fillPos[depIdx]++] = nodeIdx;
+    }
+
+    std::vector<uint32_t> order;
+    if (!DagExecutor::getTopologicalOrder(CsrGraphView{static_cast<uint32_t>(nodeCnt), m_offsets.data(), m_targets.data()}, order))
+    {
+        LOG_ERR("The captured task graph has a cycle, it can't be replayed");
+        throw std::logic_error("Task graph has a cycle");
+    }
+    m_consumerCnts.assign(nodeCnt, 0);
+    for (const auto& node : m_nodes)
+    {
+        for (auto depIdx : node.argDeps)
+            ++m_consumerCnts[depIdx];
+    }
+    m_pPendingConsumerCnts = std::make_unique<std::atomic<uint32_t>[]>(nodeCnt);
+    m_resultBytes.assign(nodeCnt, 0);
+    m_isCompiled = true;
+    LOG_EXIT_DBG();
+}
+
+void TaskGraph::replay(ThreadPool& pool)
+{
+    LOG_ENTRY_DBG();
+    if (!m_isCompiled)
+        compile();
+    for (auto& result : m_results)
+        result.reset();
+    for (size_t idx = 0; idx < m_nodes.size(); ++idx)
+    {
+        m_resultBytes[idx] = 0;
+        m_pPendingConsumerCnts[idx].store(m_consumerCnts[idx], std::memory_order_relaxed);
+    }
+    m_liveResultBytes = 0;
+    m_peakLiveResultBytes = 0;
+    ++m_replayCnt;
+    DagExecutor executor(pool);
+    executor.run(CsrGraphView{static_cast<uint32_t>(m_nodes.size()), m_offsets.data(), m_targets.data()},
+                 [this](uint32_t nodeIdx) { storeResult(nodeIdx); });
+    LOG_DBG("Replay {:d} of {:d} captured tasks completed, peak of {:d} bytes of results",
+        m_replayCnt, m_nodes.size(), m_peakLiveResultBytes.load());
+    LOG_EXIT_DBG();
+}
+
+void TaskGraph::storeResult(const uint32_t nodeIdx)
+{
+    auto& node = m_nodes[nodeIdx];
+    size_t resultBytes = 0;
+    m_results[nodeIdx] = node.invoke(*this, node.args, resultBytes);
+    m_resultBytes[nodeIdx] = resultBytes;
+    auto liveBytes = m_liveResultBytes.fetch_add(resultBytes, std::memory_order_relaxed) + resultBytes;
+    auto peakBytes = m_peakLiveResultBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes && !m_peakLiveResultBytes.compare_exchange_weak(peakBytes, liveBytes,
+                                                                                 std::memory_order_relaxed));
+
+    // The task has consumed its arguments, the last consumer of a result frees it
+    if (!m_isEarlyRelease)
+        return;
+    for (auto depIdx : node.argDeps)
+    {
+        if (m_pPendingConsumerCnts[depIdx].fetch_sub(1, std::memory_order_acq_rel) == 1 && !m_nodes[depIdx].isKept)
+            releaseResult(depIdx);
+    }
+}
+
+void TaskGraph::releaseResult(const uint32_t nodeIdx) noexcept
+{
+    m_results[nodeIdx].reset();
+    m_liveResultBytes.fetch_sub(m_resultBytes[nodeIdx], std::memory_order_relaxed);
+    m_resultBytes[nodeIdx] = 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file TaskGraphImage.cpp
+ * @author Swarnendu RC
+ * @brief Implementation of the graph image writer and the memory mapped loader.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "TaskGraphImage.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace t_pool;
+
+namespace
+{
+    inline uint64_t alignUp(const uint64_t value) { return (value + 7) & ~uint64_t(7); }
+
+    void writeSection(std::ofstream& file, const void* pData, const uint64_t size)
+    {
+        static const char padding[8] = {};
+        file.write(static_cast<const char*>(pData), static_cast<std::streamsize>(size));
+        file.write(padding, static_cast<std::streamsize>(alignUp(size) - size));
+    }
+
+    [[noreturn]] void malformed(const char* reason)
+    {
+        LOG_ERR("Malformed task graph image: {}", reason);
+        throw std::runtime_error(std::string("Malformed task graph image: ") + reason);
+    }
+};
+
+uint32_t TaskGraphImageWriter::addNode(std::string_view typeName)
+{
+    auto [itr, inserted] = m_typeIds.try_emplace(std::string(typeName),
+                                                 static_cast<uint32_t>(m_typeNames.size()));
+    if (inserted)
+        m_typeNames.emplace_back(typeName);
+    m_nodeTypes.emplace_back(itr->second);
+    return static_cast<uint32_t>(m_nodeTypes.size() - 1);
+}
+
+void TaskGraphImageWriter::addEdge(const uint32_t from, const uint32_t to)
+{
+    if (from >= m_nodeTypes.size() || to >= m_nodeTypes.size())
+        throw std::out_of_range("Edge refers to a node which has not been added");
+    m_edges.emplace_back(from, to);
+}
+
+void TaskGraphImageWriter::save(const std::string& path) const
+{
+    LOG_ENTRY_DBG();
+    const auto nodeCount = static_cast<uint32_t>(m_nodeTypes.size());
+
+    // Bucket the edges by their source node to get the CSR arrays
+    std::vector<uint64_t> offsets(nodeCount + 1, 0);
+    for (const auto& edge : m_edges)
+        ++offsets[edge.first + 1];
+    for (uint32_t idx = 0; idx < nodeCount; ++idx)
+        offsets[idx + 1] += offsets[idx];
+    std::vector<uint32_t> targets(m_edges.size());
+    {
+        auto fillPos = offsets;
+        for (const auto& edge : m_edges)
+            targets[fillPos[edge.first]++] = edge.second;
+    }
+
+    std::vector<uint32_t> typeTable;
+    typeTable.reserve(m_typeNames.size() * 2);
+    std::string nameBlob;
+    for (const auto& typeName : m_typeNames)
+    {
+        typeTable.emplace_back(static_cast<uint32_t>(nameBlob.size()));
+        typeTable.emplace_back(static_cast<uint32_t>(typeName.size()));
+        nameBlob += typeName;
+    }
+
+    TaskGraphImageHeader header = {};
+    std::memcpy(header.magic, TaskGraphImage::MAGIC, sizeof(header.magic));
+    header.version = TaskGraphImage::VERSION;
+    header.byteOrderMark = TaskGraphImage::BYTE_ORDER_MARK;
+    header.nodeCount = nodeCount;
+    header.typeCount = static_cast<uint32_t>(m_typeNames.size());
+    header.edgeCount = m_edges.size();
+    header.typeIdsOffset = alignUp(sizeof(header));
+    header.offsetsOffset = header.typeIdsOffset + alignUp(m_nodeTypes.size() * sizeof(uint32_t));
+    header.targetsOffset = header.offsetsOffset + alignUp(offsets.size() * sizeof(uint64_t));
+    header.typeTableOffset = header.targetsOffset + alignUp(targets.size() * sizeof(uint32_t));
+    header.nameBlobOffset = header.typeTableOffset + alignUp(typeTable.size() * sizeof(uint32_t));
+    header.nameBlobSize = nameBlob.size();
+    header.fileSize = header.nameBlobOffset + alignUp(nameBlob.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Unable to open " + path + " for writing the task graph image");
+    writeSection(file, &header, sizeof(header));
+    writeSection(file, m_nodeTypes.data(), m_nodeTypes.size() * sizeof(uint32_t));
+    writeSection(file, offsets.data(), offsets.size() * sizeof(uint64_t));
+    writeSection(file, targets.data(), targets.size() * sizeof(uint32_t));
+    writeSection(file, typeTable.data(), typeTable.size() * sizeof(uint32_t));
+    writeSection(file, nameBlob.data(), nameBlob.size());
+    if (!file.flush())
+        throw std::runtime_error("Unable to write the task graph image " + path);
+    LOG_DBG("Task graph image {} written with {:d} nodes and {:d} edges", path, nodeCount, m_edges.size());
+    LOG_EXIT_DBG();
+}
+
+TaskGraphImage::TaskGraphImage(const std::string& path)
+{
+    LOG_ENTRY_DBG();
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Unable to open the task graph image " + path);
+
+    struct stat fileStat = {};
+    if (::fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(TaskGraphImageHeader)))
+    {
+        ::close(fd);
+        throw std::runtime_error("Task graph image " + path + " is too small");
+    }
+    m_mappingSize = static_cast<size_t>(fileStat.st_size);
+    m_pMapping = ::mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);    // The mapping keeps the file referenced
+    if (m_pMapping == MAP_FAILED)
+    {
+        m_pMapping = nullptr;
+        throw std::runtime_error("Unable to map the task graph image " + path);
+    }
+    ::madvise(m_pMapping, m_mappingSize, MADV_WILLNEED);
+
+    const auto* pBase = static_cast<const char*>(m_pMapping);
+    m_pHeader = reinterpret_cast<const TaskGraphImageHeader*>(pBase);
+    try
+    {
+        validate(m_mappingSize);
+    }
+    catch (...)
+    {
+        ::munmap(m_pMapping, m_mappingSize);
+        m_pMapping = nullptr;
+        throw;
+    }
+    LOG_DBG("Task graph image {} mapped with {:d} nodes and {:d} edges",
+            path, m_pHeader->nodeCount, m_pHeader->edgeCount);
+    LOG_EXIT_DBG();
+}
+
+TaskGraphImage::~TaskGraphImage()
+{
+    if (m_pMapping)
+        ::munmap(m_pMapping, m_mappingSize);
+}
+
+void TaskGraphImage::validate(const size_t fileSize)
+{
+    const auto& header = *m_pHeader;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        malformed("bad magic");
+    if (header.byteOrderMark != BYTE_ORDER_MARK)
+        malformed("written on a machine with a different byte order");
+    if (header.version != VERSION)
+        malformed("unsupported version");
+    if (header.fileSize != fileSize)
+        malformed("file size mismatch");
+
+    auto checkSection = [fileSize](const uint64_t offset, const uint64_t count, const uint64_t elemSize)
+    {
+        if (offset % 8 || offset > fileSize || count > (fileSize - offset) / elemSize)
+            malformed("section out of bounds");
+    };
+    checkSection(header.typeIdsOffset, header.nodeCount, sizeof(uint32_t));
+    checkSection(header.offsetsOffset, uint64_t(header.nodeCount) + 1, sizeof(uint64_t));
+    checkSection(header.targetsOffset, header.edgeCount, sizeof(uint32_t));
+    checkSection(header.typeTableOffset, uint64_t(header.typeCount) * 2, sizeof(uint32_t));
+    checkSection(header.nameBlobOffset, header.nameBlobSize, sizeof(char));
+
+    const auto* pBase = static_cast<const char*>(m_pMapping);
+    m_pTypeIds = reinterpret_cast<const uint32_t*>(pBase + header.typeIdsOffset);
+    m_pOffsets = reinterpret_cast<const uint64_t*>(pBase + header.offsetsOffset);
+    m_pTargets = reinterpret_cast<const uint32_t*>(pBase + header.targetsOffset);
+    m_pTypeTable = reinterpret_cast<const uint32_t*>(pBase + header.typeTableOffset);
+    m_pNameBlob = pBase + header.nameBlobOffset;
+
+    for (uint32_t typeId = 0; typeId < header.typeCount; ++typeId)
+    {
+        uint64_t nameEnd = uint64_t(m_pTypeTable[2 * typeId]) + m_pTypeTable[2 * typeId + 1];
+        if (nameEnd > header.nameBlobSize)
+            malformed("type name out of bounds");
+    }
+
+    if (m_pOffsets[0] != 0 || m_pOffsets[header.nodeCount] != header.edgeCount)
+        malformed("CSR offsets don't cover the edges");
+    for (uint32_t nodeIdx = 0; nodeIdx < header.nodeCount; ++nodeIdx)
+    {
+        if (m_pTypeIds[nodeIdx] >= header.typeCount)
+            malformed("node type id out of range");
+        if (m_pOffsets[nodeIdx] > m_pOffsets[nodeIdx + 1])
+            malformed("CSR offsets are not monotonic");
+    }
+    for (uint64_t edge = 0; edge < header.edgeCount; ++edge)
+    {
+        if (m_pTargets[edge] >= header.nodeCount)
+            malformed("edge target out of range");
+    }
+
+    // Every node must get released for the graph to be acyclic
+    std::vector<uint32_t> order;
+    if (!DagExecutor::getTopologicalOrder(getGraphView(), order))
+        malformed("graph has a cycle");
+}
+
+std::string_view TaskGraphImage::getTypeName(const uint32_t typeId) const noexcept
+{
+    return std::string_view(m_pNameBlob + m_pTypeTable[2 * typeId], m_pTypeTable[2 * typeId + 1]);
+}
+
+void TaskGraphImage::bind(const TaskRegistry& registry)
+{
+    LOG_ENTRY_DBG();
+    std::vector<const TaskRegistry::NodeCallable*> boundTypes(getTypeCnt(), nullptr);
+    for (uint32_t typeId = 0; typeId < getTypeCnt(); ++typeId)
+    {
+        boundTypes[typeId] = registry.find(getTypeName(typeId));
+        if (!boundTypes[typeId])
+        {
+            LOG_ERR("Task type {} is not registered", getTypeName(typeId));
+            throw std::runtime_error("Task type " + std::string(getTypeName(typeId)) + " is not registered");
+        }
+    }
+    m_boundTypes = std::move(boundTypes);
+    LOG_EXIT_DBG();
+}
+
+void TaskGraphImage::run(ThreadPool& pool) const
+{
+    LOG_ENTRY_DBG();
+    if (!isBound())
+        throw std::logic_error("Task graph image must be bound to a registry before running it");
+    DagExecutor executor(pool);
+    executor.run(getGraphView(), [this](uint32_t nodeIdx)
+    {
+        (*m_boundTypes[m_pTypeIds[nodeIdx]])(nodeIdx);
+    });
+    LOG_EXIT_DBG();
+}
@@ -29,10 +29,177 @@
  * @author Swarnendu RC
  * @date 2025-09-15
  *
- * This file exists solely to satisfy compilation requirements.
- * No additional logic is implemented here.
+ * The pool itself is header only, this file holds its constructor taking
+ * the calibrated parameters (see PoolCalibration.hpp), the identity of the
+ * worker threads, their pinning to cores (PER_CORE queue mode), the
+ * random shard picking (SHARDED queue mode) and the time slices of the
+ * tasks yielding cooperatively.
  */
 #include "ThreadPool.hpp"
+#include "PoolCalibration.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#if defined (__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace t_pool;
 
+namespace
+{
+    /** @brief The pool the calling thread is a worker of, if any */
+    thread_local const ThreadPool* t_pWorkerPool = nullptr;
+    /** @brief The index of the calling worker thread within its pool */
+    thread_local ui32 t_workerIdx = ThreadPool::NOT_A_WORKER;
+    /** @brief When the time slice of the task the calling worker runs started */
+    thread_local std::chrono::steady_clock::time_point t_sliceStart = {};
+    /** @brief How many yields the calling worker is nested in */
+    thread_local uint32_t t_yieldDepth = 0;
+    /** @brief The time spent by the calling worker in tasks nested within the one it runs */
+    thread_local uint64_t t_nestedBusyNs = 0;
+    /** @brief How many yields a worker may be nested in, bounding its stack */
+    constexpr uint32_t MAX_YIELD_DEPTH = 4;
+
+    void pinToCore(const ui32 coreIdx)
+    {
+#if defined (__linux__)
+        auto coreCnt = std::thread::hardware_concurrency();
+        if (!coreCnt)
+            return;
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(coreIdx % coreCnt, &cpuSet);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet))
+            LOG_ERR("Could not pin the worker {:d} to its core", coreIdx);
+#else
+        (void)coreIdx;  // Pinning is best effort, not supported here
+#endif
+    }
+};
+
+ThreadPool::ThreadPool(const ui32 poolSize, const PoolTuning& tuning)
+    : ThreadPool(poolSize, tuning.queueMode)
+{
+    setIdlePolicy(tuning.idleSpinCnt, tuning.sleepDuration);
+}
+
+uint32_t ThreadPool::getRandomIdx(const uint32_t bound) noexcept
+{
+    // xorshift32, seeded per thread so that the producers do not pick in lockstep
+    static std::atomic<uint32_t> seed = 0x9E3779B9u;
+    thread_local uint32_t state = seed.fetch_add(0x9E3779B9u, std::memory_order_relaxed) | 1u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % bound;
+}
+
+ui32 ThreadPool::getWorkerIdx() const noexcept
+{
+    return (t_pWorkerPool == this) ? t_workerIdx : NOT_A_WORKER;
+}
+
+void ThreadPool::bindWorker(const ui32 workerIdx)
+{
+    t_pWorkerPool = this;
+    t_workerIdx = workerIdx;
+    if (m_queueMode == QueueMode::PER_CORE)
+        pinToCore(workerIdx);
+}
+
+void ThreadPool::startTimeSlice() noexcept
+{
+    t_sliceStart = std::chrono::steady_clock::now();
+}
+
+uint64_t ThreadPool::exchangeNestedBusyNs(const uint64_t nestedBusyNs) noexcept
+{
+    return std::exchange(t_nestedBusyNs, nestedBusyNs);
+}
+
+std::chrono::nanoseconds ThreadPool::getTimeSliceLeft() const noexcept
+{
+    if (t_pWorkerPool != this)
+        return getTimeSlice();
+    auto left = getTimeSlice() - (std::chrono::steady_clock::now() - t_sliceStart);
+    return std::max(std::chrono::nanoseconds(0), std::chrono::duration_cast<std::chrono::nanoseconds>(left));
+}
+
+ui32 ThreadPool::yieldNow()
+{
+    auto workerIdx = getWorkerIdx();
+    if (workerIdx == NOT_A_WORKER || t_yieldDepth >= MAX_YIELD_DEPTH)
+    {
+        std::this_thread::yield();
+        return 0;
+    }
+
+    ++t_yieldDepth;
+    ++m_yieldCnt;
+    auto sliceStart = t_sliceStart;
+    ui32 ranCnt = 0;
+    try
+    {
+        // Only the tasks already waiting, not the ones they submit meanwhile
+        for (auto waitingCnt = m_taskQueuedCnt.load(); ranCnt < waitingCnt; ++ranCnt)
+        {
+            std::shared_ptr<Task> pTask;
+            if (!popTask(workerIdx, pTask))
+                break;
+            runTask(pTask);
+        }
+    }
+    catch (...)
+    {
+        --t_yieldDepth;
+        t_sliceStart = sliceStart;
+        throw;
+    }
+    --t_yieldDepth;
+    LOG_DBG("Worker {:d} ran {:d} waiting tasks on behalf of a yielding task", workerIdx, ranCnt);
+    startTimeSlice();
+    return ranCnt;
+}
+
+void ThreadPool::setStatsPage(std::shared_ptr<ShmStatsPage> pStatsPage)
+{
+    // Publishers hold the flag, none of them writes into the page being replaced
+    while (m_isPublishingStats.test_and_set(std::memory_order_acquire))
+        std::this_thread::yield();
+    auto hasStatsPage = static_cast<bool>(pStatsPage);
+    m_pStatsPage.store(std::move(pStatsPage));
+    m_hasStatsPage = hasStatsPage;
+    m_isPublishingStats.clear(std::memory_order_release);
+    publishStats(true);
+}
+
+void ThreadPool::publishStats(const bool isForced) noexcept
+{
+    if (!m_hasStatsPage.load(std::memory_order_relaxed))
+        return;
+    uint64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!isForced && nowNs < m_nextStatsPublishNs.load(std::memory_order_relaxed))
+        return;
+    if (m_isPublishingStats.test_and_set(std::memory_order_acquire))
+        return;     // Somebody else is at it
+    if (auto pStatsPage = m_pStatsPage.load())
+    {
+        PoolStats stats;
+        stats.publishedNs = nowNs;
+        stats.poolSize = m_poolSize;
+        stats.taskCnt = getTotalTaskCnt();
+        stats.queuedCnt = m_taskQueuedCnt;
+        stats.deferredCnt = m_deferredCnt;
+        stats.deadlineMissedCnt = m_deadlineMissedCnt;
+        stats.yieldCnt = m_yieldCnt;
+        pStatsPage->publishPool(stats);
+    }
+    m_nextStatsPublishNs.store(nowNs + std::chrono::duration_cast<std::chrono::nanoseconds>(STATS_PUBLISH_INTERVAL).count(),
+                               std::memory_order_relaxed);
+    m_isPublishingStats.clear(std::memory_order_release);
+}
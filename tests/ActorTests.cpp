@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+ActorTests.cpp
+
+This file contains unit tests for the actors and their mailboxes. The main test cases are:
+
+- testMpscQueue: Values pushed by several threads are all popped, each thread's in order.
+- testOrderedDelivery: An actor handles the messages of every sender in order, one at a time.
+- testManyActors: Thousands of actors share the few workers of a pool.
+- testBatchBound: An activation handles no more than the batch size of messages.
+- testHandlerFailure: A failing message is counted and doesn't stop the actor.
+- testIdleRace: Senders racing an actor that keeps going idle lose no message and never run it twice at once.
+--------------------------------------------------------------------------------
+*/
+
+#include "Actor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+class ActorTests : public ::testing::Test
+{
+    protected:
+        static constexpr uint32_t SENDER_CNT = 4;
+        static constexpr uint32_t MSG_CNT = 10000;
+};
+
+TEST_F(ActorTests, testMpscQueue)
+{
+    MpscQueue<uint64_t> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    std::vector<std::thread> producers;
+    for (uint64_t sender = 0; sender < SENDER_CNT; ++sender)
+    {
+        producers.emplace_back([&queue, sender]()
+        {
+            for (uint64_t idx = 0; idx < MSG_CNT; ++idx)
+                queue.push((sender << 32) | idx);
+        });
+    }
+
+    std::vector<uint64_t> nextExpected(SENDER_CNT, 0);
+    uint32_t popped = 0;
+    uint64_t value = 0;
+    while (popped < SENDER_CNT * MSG_CNT)
+    {
+        if (!queue.tryPop(value))
+            continue;
+        ++popped;
+        auto sender = value >> 32;
+        EXPECT_EQ(nextExpected[sender]++, value & 0xFFFFFFFF);
+    }
+    for (auto& producer : producers)
+        producer.join();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST_F(ActorTests, testOrderedDelivery)
+{
+    std::vector<uint64_t> nextExpected(SENDER_CNT, 0);
+    std::atomic_bool isHandling = false;
+    uint32_t overlaps = 0;
+    uint32_t outOfOrder = 0;
+    std::shared_ptr<Actor<uint64_t>> pActor;
+    {
+        ThreadPool tpool(4);
+        pActor = Actor<uint64_t>::create(tpool, [&](uint64_t& message)
+        {
+            if (isHandling.exchange(true))
+                ++overlaps;
+            auto sender = message >> 32;
+            if ((message & 0xFFFFFFFF) != nextExpected[sender]++)
+                ++outOfOrder;
+            isHandling = false;
+        });
+        std::vector<std::thread> senders;
+        for (uint64_t sender = 0; sender < SENDER_CNT; ++sender)
+        {
+            senders.emplace_back([pActor, sender]()
+            {
+                for (uint64_t idx = 0; idx < MSG_CNT; ++idx)
+                    pActor->send((sender << 32) | idx);
+            });
+        }
+        for (auto& sender : senders)
+            sender.join();
+    }
+    EXPECT_EQ(0u, overlaps);
+    EXPECT_EQ(0u, outOfOrder);
+    EXPECT_EQ(SENDER_CNT * MSG_CNT, pActor->getHandledCnt());
+    EXPECT_EQ(0u, pActor->getPendingCnt());
+}
+
+TEST_F(ActorTests, testManyActors)
+{
+    constexpr uint32_t ACTOR_CNT = 20000;
+    std::vector<uint32_t> counts(ACTOR_CNT, 0);
+    {
+        ThreadPool tpool(4);
+        std::vector<std::shared_ptr<Actor<uint32_t>>> actors;
+        actors.reserve(ACTOR_CNT);
+        for (uint32_t idx = 0; idx < ACTOR_CNT; ++idx)
+            actors.emplace_back(Actor<uint32_t>::create(tpool, [&counts, idx](uint32_t& value) { counts[idx] += value; }));
+        for (uint32_t round = 1; round <= 5; ++round)
+        {
+            for (auto& pActor : actors)
+                pActor->send(round);
+        }
+    }
+    for (auto count : counts)
+        EXPECT_EQ(15u, count);
+}
+
+TEST_F(ActorTests, testBatchBound)
+{
+    ThreadPool tpool(1);
+    std::promise<void> gate;
+    auto blocker = tpool.submit([future = gate.get_future().share()]() { future.wait(); });
+
+    uint32_t handled = 0;
+    auto pActor = Actor<uint32_t>::create(tpool, [&handled](uint32_t&) { ++handled; }, 4);
+    for (uint32_t idx = 0; idx < 100; ++idx)
+        pActor->send(idx);
+    EXPECT_EQ(100u, pActor->getPendingCnt());
+    EXPECT_EQ(1u, pActor->getActivationCnt());
+
+    gate.set_value();
+    blocker.get();
+    while (pActor->getPendingCnt())
+        std::this_thread::yield();
+    EXPECT_EQ(25u, pActor->getActivationCnt());
+}
+
+TEST_F(ActorTests, testHandlerFailure)
+{
+    std::shared_ptr<Actor<int>> pActor;
+    int sum = 0;
+    {
+        ThreadPool tpool(2);
+        pActor = Actor<int>::create(tpool, [&sum](int& value)
+        {
+            if (value < 0)
+                throw std::invalid_argument("negative value");
+            sum += value;
+        });
+        for (auto value : {1, -1, 2, -2, 3})
+            pActor->send(value);
+    }
+    EXPECT_EQ(6, sum);
+    EXPECT_EQ(2u, pActor->getFailedCnt());
+    EXPECT_EQ(5u, pActor->getHandledCnt());
+}
+
+TEST_F(ActorTests, testIdleRace)
+{
+    constexpr uint32_t RACING_SENDER_CNT = 8;
+    constexpr uint32_t BURST_CNT = 2000;
+    std::atomic_bool isHandling = false;
+    std::atomic<uint32_t> overlaps = 0;
+    std::shared_ptr<Actor<uint32_t>> pActor;
+    {
+        ThreadPool tpool(4);
+        pActor = Actor<uint32_t>::create(tpool, [&](uint32_t&)
+        {
+            if (isHandling.exchange(true))
+                ++overlaps;
+            isHandling = false;
+        }, 1);
+        std::vector<std::thread> senders;
+        for (uint32_t sender = 0; sender < RACING_SENDER_CNT; ++sender)
+        {
+            senders.emplace_back([pActor]()
+            {
+                // Short bursts, the actor drains them and goes idle in between
+                for (uint32_t burst = 0; burst < BURST_CNT; ++burst)
+                {
+                    pActor->send(burst);
+                    pActor->send(burst);
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& sender : senders)
+            sender.join();
+        while (pActor->getPendingCnt())
+            std::this_thread::yield();
+    }
+    EXPECT_EQ(0u, overlaps.load());
+    EXPECT_EQ(2 * RACING_SENDER_CNT * BURST_CNT, pActor->getHandledCnt());
+    EXPECT_EQ(0u, pActor->getPendingCnt());
+    EXPECT_GT(pActor->getActivationCnt(), 1u);
+}
@@ -0,0 +1,146 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+BufferPoolTests.cpp
+
+This file contains unit tests for the recycled payload buffers. The main test cases are:
+
+- testAcquireRecycle: A released buffer's slab is handed out again by the next acquire.
+- testRefCount: Copies share the bytes, moves don't touch the count, the last handle recycles.
+- testTaskPayload: Buffers moved into pool tasks are recycled once the tasks are done.
+- testConcurrentRecycle: Many threads acquiring and releasing reuse a bounded no. of slabs.
+--------------------------------------------------------------------------------
+*/
+
+#include "BufferPool.hpp"
+#include "ThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <numeric>
+
+using namespace t_pool;
+
+class BufferPoolTests : public ::testing::Test
+{
+};
+
+TEST_F(BufferPoolTests, testAcquireRecycle)
+{
+    BufferPool pool(1000, 1);
+    EXPECT_EQ(1000u, pool.getSlabSize());
+    EXPECT_THROW(pool.acquire(1001), std::length_error);
+
+    const std::byte* pData = nullptr;
+    {
+        auto buffer = pool.acquire(10);
+        ASSERT_TRUE(buffer);
+        EXPECT_EQ(10u, buffer.getSize());
+        EXPECT_EQ(1000u, buffer.getCapacity());
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(buffer.getData()) % 64);
+        buffer.setSize(1000);
+        EXPECT_THROW(buffer.setSize(1001), std::length_error);
+        pData = buffer.getData();
+        EXPECT_EQ(1u, pool.getInUseCnt());
+    }
+    EXPECT_EQ(0u, pool.getInUseCnt());
+    EXPECT_EQ(BufferPool::SLABS_PER_CHUNK, pool.getAllocatedCnt());
+    auto buffer = pool.acquire();
+    EXPECT_EQ(pData, buffer.getData());
+    EXPECT_EQ(0u, buffer.getSize());
+}
+
+TEST_F(BufferPoolTests, testRefCount)
+{
+    BufferPool pool(64, 1);
+    auto buffer = pool.acquire(4);
+    std::memcpy(buffer.getData(), "abcd", 4);
+
+    auto copy = buffer;
+    EXPECT_EQ(2u, buffer.getRefCnt());
+    EXPECT_EQ(buffer.getData(), copy.getData());
+
+    auto moved = std::move(copy);
+    EXPECT_FALSE(copy);
+    EXPECT_EQ(2u, moved.getRefCnt());
+
+    buffer.reset();
+    EXPECT_EQ(1u, moved.getRefCnt());
+    EXPECT_EQ(1u, pool.getInUseCnt());
+    EXPECT_EQ(0, std::memcmp(moved.getData(), "abcd", 4));
+    moved = Buffer();
+    EXPECT_EQ(0u, pool.getInUseCnt());
+}
+
+TEST_F(BufferPoolTests, testTaskPayload)
+{
+    constexpr size_t TASKS = 200;
+    BufferPool bufferPool(4096);
+    std::vector<std::future<std::any>> futures;
+    {
+        ThreadPool tpool(4);
+        for (size_t idx = 0; idx < TASKS; ++idx)
+        {
+            auto payload = bufferPool.acquire(sizeof(uint32_t) * 1000);
+            auto pValues = reinterpret_cast<uint32_t*>(payload.getData());
+            std::iota(pValues, pValues + 1000, static_cast<uint32_t>(idx));
+            futures.emplace_back(tpool.submit([payload = std::move(payload)]()
+            {
+                auto pValues = reinterpret_cast<const uint32_t*>(payload.getData());
+                return std::accumulate(pValues, pValues + payload.getSize() / sizeof(uint32_t), uint64_t(0));
+            }));
+        }
+        for (size_t idx = 0; idx < TASKS; ++idx)
+            EXPECT_EQ(idx * 1000 + 999 * 1000 / 2, std::any_cast<uint64_t>(futures[idx].get()));
+    }
+    EXPECT_EQ(0u, bufferPool.getInUseCnt());
+}
+
+TEST_F(BufferPoolTests, testConcurrentRecycle)
+{
+    constexpr uint32_t THREADS = 8;
+    constexpr uint32_t ROUNDS = 10000;
+    BufferPool pool(256, 4, 8);
+    std::vector<std::thread> threads;
+    for (uint32_t thrd = 0; thrd < THREADS; ++thrd)
+    {
+        threads.emplace_back([&pool]()
+        {
+            std::vector<Buffer> held;
+            for (uint32_t round = 0; round < ROUNDS; ++round)
+            {
+                held.emplace_back(pool.acquire(16));
+                if (held.size() == 4)
+                    held.clear();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(0u, pool.getInUseCnt());
+    // At most 4 buffers in use per thread plus what sits in the caches
+    EXPECT_LE(pool.getAllocatedCnt(), 8 * BufferPool::SLABS_PER_CHUNK);
+}
@@ -0,0 +1,163 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+ChannelTests.cpp
+
+This file contains unit tests for the bounded channels and the generator tasks. The main test cases are:
+
+- testBoundedChannel: Pushing blocks while the channel is full, closing drains and releases everybody.
+- testGeneratorToCaller: The caller consumes a generator's values as they are produced, never buffering more than the capacity.
+- testGeneratorToTask: Another task of the pool consumes a generator's values.
+- testGeneratorFailure: A failing generator's exception reaches the consumer after the values produced before it.
+- testConsumerStops: A consumer closing the channel stops the generator.
+--------------------------------------------------------------------------------
+*/
+
+#include "ThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace t_pool;
+
+class ChannelTests : public ::testing::Test
+{
+};
+
+TEST_F(ChannelTests, testBoundedChannel)
+{
+    Channel<int> channel(2);
+    EXPECT_TRUE(channel.push(1));
+    EXPECT_TRUE(channel.push(2));
+    int value = 3;
+    EXPECT_FALSE(channel.tryPush(value));
+    EXPECT_EQ(3, value);
+
+    std::atomic_bool pushed = false;
+    std::thread producer([&]() { pushed = channel.push(3); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed);
+    ASSERT_TRUE(channel.pop(value));
+    EXPECT_EQ(1, value);
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(2u, channel.getSize());
+
+    channel.close();
+    EXPECT_FALSE(channel.push(4));
+    ASSERT_TRUE(channel.pop(value));
+    EXPECT_EQ(2, value);
+    ASSERT_TRUE(channel.tryPop(value));
+    EXPECT_EQ(3, value);
+    EXPECT_FALSE(channel.pop(value));
+    EXPECT_FALSE(channel.tryPop(value));
+}
+
+TEST_F(ChannelTests, testGeneratorToCaller)
+{
+    ThreadPool tpool(2);
+    std::atomic<size_t> maxAhead = 0;
+    std::atomic<int> consumed = 0;
+    auto pChannel = tpool.submitGenerator<int>(4, [&](Channel<int>& channel, const int count)
+    {
+        for (auto idx = 0; idx < count; ++idx)
+        {
+            auto ahead = static_cast<size_t>(idx - consumed);
+            if (ahead > maxAhead)
+                maxAhead = ahead;
+            channel.push(idx);
+        }
+    }, 1000);
+
+    int value = 0;
+    int expected = 0;
+    while (pChannel->pop(value))
+    {
+        EXPECT_EQ(expected++, value);
+        ++consumed;
+    }
+    EXPECT_EQ(1000, expected);
+    // The producer can be ahead by the capacity plus the value being popped
+    EXPECT_LE(maxAhead, pChannel->getCapacity() + 1);
+}
+
+TEST_F(ChannelTests, testGeneratorToTask)
+{
+    ThreadPool tpool(2);
+    auto pChannel = tpool.submitGenerator<std::string>(8, [](Channel<std::string>& channel)
+    {
+        for (auto idx = 0; idx < 100; ++idx)
+            channel.push(std::to_string(idx));
+    });
+    auto future = tpool.submit([pChannel]()
+    {
+        size_t totalLength = 0;
+        std::string value;
+        while (pChannel->pop(value))
+            totalLength += value.size();
+        return totalLength;
+    });
+    // 10 one digit and 90 two digit numbers
+    EXPECT_EQ(190u, std::any_cast<size_t>(future.get()));
+}
+
+TEST_F(ChannelTests, testGeneratorFailure)
+{
+    ThreadPool tpool(1);
+    auto pChannel = tpool.submitGenerator<int>(16, [](Channel<int>& channel)
+    {
+        channel.push(1);
+        channel.push(2);
+        throw std::runtime_error("generator failed");
+    });
+    int value = 0;
+    ASSERT_TRUE(pChannel->pop(value));
+    EXPECT_EQ(1, value);
+    ASSERT_TRUE(pChannel->pop(value));
+    EXPECT_EQ(2, value);
+    EXPECT_THROW(pChannel->pop(value), std::runtime_error);
+}
+
+TEST_F(ChannelTests, testConsumerStops)
+{
+    std::atomic<int> produced = 0;
+    {
+        ThreadPool tpool(1);
+        auto pChannel = tpool.submitGenerator<int>(2, [&produced](Channel<int>& channel)
+        {
+            while (channel.push(produced))
+                ++produced;
+        });
+        int value = 0;
+        for (auto idx = 0; idx < 10; ++idx)
+            ASSERT_TRUE(pChannel->pop(value));
+        pChannel->close();
+        // Destroying the pool waits for the generator, which must have stopped
+    }
+    EXPECT_LE(produced, 13);
+}
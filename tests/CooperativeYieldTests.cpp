@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+--------------------------------------------------------------------------------
+CooperativeYieldTests.cpp
+
+This file contains unit tests for the cooperative yielding of long running tasks. The main test cases are:
+
+- testTimeSlice: A task's time slice runs out as it runs, threads outside the pool always have a whole one.
+- testYieldNow: A long task yielding lets the tasks waiting behind it run, then goes on with a fresh slice.
+- testCoroutineYield: A coroutine yielding is resumed behind the tasks which were waiting.
+- testYieldingTaskCost: The cost model records the time of a yielding task without the tasks it ran meanwhile.
+--------------------------------------------------------------------------------
+*/
+
+#include "CoTask.hpp"
+#include "TaskCostModel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+namespace
+{
+    void waitFor(const std::atomic_bool& flag)
+    {
+        while (!flag)
+            std::this_thread::yield();
+    }
+
+    void waitForQueued(ThreadPool& pool, const ui64 queuedCnt)
+    {
+        while (pool.getTaskQueued() < queuedCnt)
+            std::this_thread::yield();
+    }
+
+    CoTask<void> yieldingCoroutine(ThreadPool& pool, std::atomic_bool& started,
+                                   std::mutex& orderMtx, std::vector<int>& order)
+    {
+        co_await schedule(pool);
+        started = true;
+        waitForQueued(pool, 3);
+        co_await yield(pool);
+        std::lock_guard<std::mutex> lock(orderMtx);
+        order.push_back(-1);
+    }
+};
+
+class CooperativeYieldTests : public ::testing::Test
+{
+};
+
+TEST_F(CooperativeYieldTests, testTimeSlice)
+{
+    ThreadPool tpool(1);
+    tpool.setTimeSlice(std::chrono::milliseconds(2));
+    EXPECT_EQ(std::chrono::milliseconds(2), tpool.getTimeSlice());
+    EXPECT_EQ(std::chrono::nanoseconds(std::chrono::milliseconds(2)), tpool.getTimeSliceLeft());
+    EXPECT_FALSE(tpool.shouldYield());
+
+    auto future = tpool.submit([&tpool]()
+    {
+        auto atStart = tpool.getTimeSliceLeft();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return atStart > std::chrono::nanoseconds(0) && tpool.getTimeSliceLeft().count() == 0;
+    });
+    EXPECT_TRUE(std::any_cast<bool>(future.get()));
+}
+
+TEST_F(CooperativeYieldTests, testYieldNow)
+{
+    ThreadPool tpool(1);
+    tpool.setTimeSlice(std::chrono::milliseconds(1));
+    EXPECT_EQ(0u, tpool.yieldNow());    // Not from a worker
+
+    std::atomic_bool started = false;
+    std::atomic<uint32_t> shortDone = 0;
+    auto longTask = tpool.submit([&tpool, &started, &shortDone]()
+    {
+        started = true;
+        waitForQueued(tpool, 5);
+        while (!tpool.shouldYield())
+            std::this_thread::yield();
+        auto ranCnt = tpool.yieldNow();
+        auto isSliceFresh = tpool.getTimeSliceLeft().count() > 0;
+        return ranCnt == 5 && shortDone == 5 && isSliceFresh;
+    });
+    waitFor(started);
+    std::vector<std::future<std::any>> shortTasks;
+    for (auto idx = 0; idx < 5; ++idx)
+        shortTasks.emplace_back(tpool.submit([&shortDone]() { ++shortDone; }));
+
+    EXPECT_TRUE(std::any_cast<bool>(longTask.get()));
+    EXPECT_EQ(1u, tpool.getYieldCnt());
+    EXPECT_EQ(0u, tpool.getTaskQueued());
+}
+
+TEST_F(CooperativeYieldTests, testCoroutineYield)
+{
+    ThreadPool tpool(1);
+    std::atomic_bool started = false;
+    std::mutex orderMtx;
+    std::vector<int> order;
+    auto coroutine = spawn(tpool, yieldingCoroutine(tpool, started, orderMtx, order));
+    waitFor(started);
+    for (auto idx = 0; idx < 3; ++idx)
+    {
+        tpool.submit([&orderMtx, &order, idx]()
+        {
+            std::lock_guard<std::mutex> lock(orderMtx);
+            order.push_back(idx);
+        });
+    }
+    coroutine.get();
+    std::lock_guard<std::mutex> lock(orderMtx);
+    EXPECT_EQ((std::vector<int>{0, 1, 2, -1}), order);
+}
+
+TEST_F(CooperativeYieldTests, testYieldingTaskCost)
+{
+    constexpr auto NAP = std::chrono::milliseconds(20);
+    auto pModel = std::make_shared<TaskCostModel>();
+    ThreadPool tpool(1);
+    tpool.setCostModel(pModel);
+
+    std::atomic_bool started = false;
+    auto outer = tpool.submitNamed("outer", [&tpool, &started]()
+    {
+        started = true;
+        waitForQueued(tpool, 3);
+        return tpool.yieldNow();
+    });
+    waitFor(started);
+    for (auto idx = 0; idx < 3; ++idx)
+        tpool.submitNamed("nap", [NAP]() { std::this_thread::sleep_for(NAP); });
+    EXPECT_EQ(3u, std::any_cast<ui32>(outer.get()));
+
+    // The future is ready before the worker records the duration
+    while (pModel->getEstimate("outer").sampleCnt == 0)
+        std::this_thread::yield();
+    EXPECT_EQ(3u, pModel->getEstimate("nap").sampleCnt);
+    EXPECT_GE(pModel->getEstimate("nap").mean, NAP);
+    EXPECT_LT(pModel->getEstimate("outer").mean, NAP);
+}
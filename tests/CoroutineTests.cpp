@@ -0,0 +1,210 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+CoroutineTests.cpp
+
+This file contains unit tests for the coroutine tasks and the async generators. The main test cases are:
+
+- testCoTaskChain: Coroutine tasks awaiting each other on the pool deliver their results.
+- testCoTaskFailure: An exception escaping a coroutine task reaches its awaiter and the future.
+- testAsyncGeneratorStream: A consumer pulls all the items of a generator, in order, off the pool's workers.
+- testAsyncGeneratorBackpressure: The generator's body never gets more than one item ahead of its consumer.
+- testAsyncGeneratorFailure: A failing generator's exception is rethrown after its last item.
+- testAsyncGeneratorAbandon: A consumer dropping a generator midway lets the pool free its body.
+--------------------------------------------------------------------------------
+*/
+
+#include "AsyncGenerator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace t_pool;
+
+namespace
+{
+    CoTask<int> square(ThreadPool& pool, const int value)
+    {
+        co_await schedule(pool);
+        co_return value * value;
+    }
+
+    CoTask<int> sumOfSquares(ThreadPool& pool, const int count)
+    {
+        auto sum = 0;
+        for (auto idx = 1; idx <= count; ++idx)
+            sum += co_await square(pool, idx);
+        co_return sum;
+    }
+
+    CoTask<void> failing(ThreadPool& pool)
+    {
+        co_await schedule(pool);
+        throw std::runtime_error("coroutine failed");
+    }
+
+    CoTask<std::string> catching(ThreadPool& pool)
+    {
+        try
+        {
+            co_await failing(pool);
+        }
+        catch (const std::runtime_error& error)
+        {
+            co_return error.what();
+        }
+        co_return "";
+    }
+
+    AsyncGenerator<int> numbers(ThreadPool&, const int count, std::atomic<int>* pProduced = nullptr)
+    {
+        for (auto idx = 0; idx < count; ++idx)
+        {
+            if (pProduced)
+                ++*pProduced;
+            co_yield idx;
+        }
+    }
+
+    CoTask<long> consumeAll(AsyncGenerator<int> generator, std::thread::id callerId)
+    {
+        long sum = 0;
+        auto expected = 0;
+        while (auto item = co_await generator.next())
+        {
+            EXPECT_EQ(expected++, *item);
+            EXPECT_NE(callerId, std::this_thread::get_id());
+            sum += *item;
+        }
+        co_return sum;
+    }
+};
+
+class CoroutineTests : public ::testing::Test
+{
+};
+
+TEST_F(CoroutineTests, testCoTaskChain)
+{
+    ThreadPool tpool(2);
+    EXPECT_EQ(385, spawn(tpool, sumOfSquares(tpool, 10)).get());
+    EXPECT_EQ(0, spawn(tpool, sumOfSquares(tpool, 0)).get());
+}
+
+TEST_F(CoroutineTests, testCoTaskFailure)
+{
+    ThreadPool tpool(2);
+    EXPECT_THROW(spawn(tpool, failing(tpool)).get(), std::runtime_error);
+    EXPECT_EQ("coroutine failed", spawn(tpool, catching(tpool)).get());
+}
+
+TEST_F(CoroutineTests, testAsyncGeneratorStream)
+{
+    ThreadPool tpool(2);
+    auto future = spawn(tpool, consumeAll(numbers(tpool, 1000), std::this_thread::get_id()));
+    EXPECT_EQ(499500, future.get());
+}
+
+TEST_F(CoroutineTests, testAsyncGeneratorBackpressure)
+{
+    ThreadPool tpool(4);
+    std::atomic<int> produced = 0;
+    std::atomic<int> maxAhead = 0;
+    auto consumer = [](ThreadPool& pool, std::atomic<int>& produced, std::atomic<int>& maxAhead) -> CoTask<int>
+    {
+        auto generator = numbers(pool, 200, &produced);
+        auto consumed = 0;
+        while (auto item = co_await generator.next())
+        {
+            ++consumed;
+            // Give the body time to run ahead, if it could
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            auto ahead = produced - consumed;
+            if (ahead > maxAhead)
+                maxAhead = ahead;
+        }
+        co_return consumed;
+    };
+    EXPECT_EQ(200, spawn(tpool, consumer(tpool, produced, maxAhead)).get());
+    EXPECT_EQ(200, produced);
+    EXPECT_LE(maxAhead, 1);
+}
+
+TEST_F(CoroutineTests, testAsyncGeneratorFailure)
+{
+    ThreadPool tpool(2);
+    auto generator = [](ThreadPool&) -> AsyncGenerator<int>
+    {
+        co_yield 1;
+        throw std::runtime_error("generator failed");
+    };
+    auto consumer = [](AsyncGenerator<int> source) -> CoTask<int>
+    {
+        auto item = co_await source.next();
+        EXPECT_EQ(1, *item);
+        try
+        {
+            co_await source.next();
+        }
+        catch (const std::runtime_error&)
+        {
+            co_return -1;
+        }
+        co_return 0;
+    };
+    EXPECT_EQ(-1, spawn(tpool, consumer(generator(tpool))).get());
+}
+
+TEST_F(CoroutineTests, testAsyncGeneratorAbandon)
+{
+    struct Tracker
+    {
+        std::atomic<int>& m_alive;
+        explicit Tracker(std::atomic<int>& alive) : m_alive(alive) { ++m_alive; }
+        ~Tracker() { --m_alive; }
+    };
+    std::atomic<int> alive = 0;
+    {
+        ThreadPool tpool(1);
+        auto generator = [](ThreadPool&, std::atomic<int>& alive) -> AsyncGenerator<int>
+        {
+            Tracker tracker(alive);
+            for (auto idx = 0; ; ++idx)
+                co_yield idx;
+        };
+        auto consumer = [](AsyncGenerator<int> source) -> CoTask<int>
+        {
+            auto last = 0;
+            for (auto idx = 0; idx < 10; ++idx)
+                last = *co_await source.next();
+            co_return last;
+        };
+        EXPECT_EQ(9, spawn(tpool, consumer(generator(tpool, alive))).get());
+    }
+    EXPECT_EQ(0, alive);
+}
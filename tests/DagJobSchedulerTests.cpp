@@ -0,0 +1,197 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+DagJobSchedulerTests.cpp
+
+This file contains unit tests for the scheduler of concurrent TDAG jobs. The main test cases are:
+
+- testRunsAllJobs: Many jobs submitted at once all complete, every node after its dependencies.
+- testShortestFirst: A small job submitted behind a big one completes first.
+- testFairShare: The workers are shared between the jobs as per their weights.
+- testConcurrencyCap: A job never runs more nodes at a time than its cap allows.
+- testInvalidUse: Jobs without weight or concurrency are rejected, empty ones complete straightaway.
+--------------------------------------------------------------------------------
+*/
+
+#include "DagJobScheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+class DagJobSchedulerTests : public ::testing::Test
+{
+    public:
+        /**
+         * @brief Builds a graph of independent nodes, each calling @p func with its job tag.
+         */
+        template <typename F>
+        static TDAG makeWideDag(const uint32_t nodeCnt, F func)
+        {
+            ConcurrentDAGBuilder builder;
+            for (uint32_t idx = 0; idx < nodeCnt; ++idx)
+            {
+                Task task;
+                task.submit(func);
+                builder.addTask(std::move(task));
+            }
+            TDAG dag;
+            builder.mergeInto(dag);
+            return dag;
+        }
+};
+
+TEST_F(DagJobSchedulerTests, testRunsAllJobs)
+{
+    constexpr uint32_t JOB_CNT = 50;
+    ThreadPool pool(4);
+    DagJobScheduler scheduler(pool);
+    EXPECT_EQ(4u, scheduler.getMaxInFlight());
+
+    // Diamonds: the sink sees the root and both middle nodes done
+    std::vector<std::unique_ptr<std::atomic<uint32_t>>> doneCnts;
+    std::vector<std::future<std::any>> sinkResults;
+    std::vector<DagJob> jobs;
+    for (uint32_t jobIdx = 0; jobIdx < JOB_CNT; ++jobIdx)
+    {
+        doneCnts.push_back(std::make_unique<std::atomic<uint32_t>>(0));
+        auto& doneCnt = *doneCnts.back();
+        ConcurrentDAGBuilder builder;
+        Task root, left, right, sink;
+        root.submit([&doneCnt]() { ++doneCnt; });
+        left.submit([&doneCnt]() { ++doneCnt; });
+        right.submit([&doneCnt]() { ++doneCnt; });
+        sink.submit([&doneCnt]() { return doneCnt.load(); });
+        sinkResults.push_back(sink.getTaskFuture());
+        auto rootId = builder.addTask(std::move(root));
+        auto leftId = builder.addTask(std::move(left));
+        auto rightId = builder.addTask(std::move(right));
+        auto sinkId = builder.addTask(std::move(sink));
+        builder.addDependency(leftId, rootId);
+        builder.addDependency(rightId, rootId);
+        builder.addDependency(sinkId, leftId);
+        builder.addDependency(sinkId, rightId);
+        TDAG dag;
+        builder.mergeInto(dag);
+        jobs.push_back(scheduler.submit(dag, DagJobOptions{"diamond" + std::to_string(jobIdx), 1.0, 2}));
+    }
+    scheduler.waitAll();
+    EXPECT_EQ(0u, scheduler.getActiveJobCnt());
+    for (uint32_t jobIdx = 0; jobIdx < JOB_CNT; ++jobIdx)
+    {
+        EXPECT_TRUE(jobs[jobIdx].isDone());
+        EXPECT_EQ(3u, std::any_cast<uint32_t>(sinkResults[jobIdx].get()));
+        const auto& stats = jobs[jobIdx].getStats();
+        EXPECT_EQ(4u, stats.nodeCnt);
+        EXPECT_GE(stats.completionTime, stats.startDelay);
+        EXPECT_GE(stats.totalQueueingDelay, stats.maxQueueingDelay);
+    }
+}
+
+TEST_F(DagJobSchedulerTests, testShortestFirst)
+{
+    auto sleepy = []() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); };
+    ThreadPool pool(2);
+    DagJobScheduler scheduler(pool, JobSchedulingPolicy::SHORTEST_FIRST, 1);
+    auto bigDag = makeWideDag(40, sleepy);
+    auto smallDag = makeWideDag(2, sleepy);
+    auto bigJob = scheduler.submit(bigDag, DagJobOptions{"big"});
+    auto smallJob = scheduler.submit(smallDag, DagJobOptions{"small"});
+    bigJob.wait();
+    ASSERT_TRUE(smallJob.isDone());
+    EXPECT_LT(smallJob.getStats().completionTime, bigJob.getStats().completionTime);
+    // The small job only waited for the node of the big one already running
+    EXPECT_LT(smallJob.getStats().completionTime, bigJob.getStats().completionTime / 4);
+}
+
+TEST_F(DagJobSchedulerTests, testFairShare)
+{
+    std::mutex orderMtx;
+    std::vector<char> order;
+    auto tagged = [&orderMtx, &order](char tag)
+    {
+        return [&orderMtx, &order, tag]()
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            std::lock_guard<std::mutex> lock(orderMtx);
+            order.push_back(tag);
+        };
+    };
+    ThreadPool pool(2);
+    {
+        DagJobScheduler scheduler(pool, JobSchedulingPolicy::FAIR_SHARE, 1);
+        EXPECT_EQ(JobSchedulingPolicy::FAIR_SHARE, scheduler.getPolicy());
+        auto heavyDag = makeWideDag(40, tagged('A'));
+        auto lightDag = makeWideDag(40, tagged('B'));
+        scheduler.submit(heavyDag, DagJobOptions{"heavy", 3.0});
+        scheduler.submit(lightDag, DagJobOptions{"light", 1.0});
+    }   // Waits for both
+
+    ASSERT_EQ(80u, order.size());
+    auto heavyCnt = std::count(order.begin(), order.begin() + 20, 'A');
+    EXPECT_GE(heavyCnt, 14);
+    EXPECT_LE(heavyCnt, 16);
+}
+
+TEST_F(DagJobSchedulerTests, testConcurrencyCap)
+{
+    std::atomic<uint32_t> runningCnt = 0;
+    std::atomic<uint32_t> maxRunningCnt = 0;
+    auto tracked = [&runningCnt, &maxRunningCnt]()
+    {
+        auto running = ++runningCnt;
+        auto maxRunning = maxRunningCnt.load();
+        while (running > maxRunning && !maxRunningCnt.compare_exchange_weak(maxRunning, running));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --runningCnt;
+    };
+    ThreadPool pool(4);
+    DagJobScheduler scheduler(pool);
+    auto dag = makeWideDag(20, tracked);
+    auto job = scheduler.submit(dag, DagJobOptions{"capped", 1.0, 2});
+    job.wait();
+    EXPECT_LE(maxRunningCnt, 2u);
+    EXPECT_EQ(20u, job.getStats().nodeCnt);
+    EXPECT_GT(job.getStats().maxQueueingDelay, std::chrono::nanoseconds(0));
+}
+
+TEST_F(DagJobSchedulerTests, testInvalidUse)
+{
+    ThreadPool pool(2);
+    DagJobScheduler scheduler(pool);
+    auto dag = makeWideDag(1, []() {});
+    EXPECT_THROW(scheduler.submit(dag, DagJobOptions{"weightless", 0.0}), std::invalid_argument);
+    EXPECT_THROW(scheduler.submit(dag, DagJobOptions{"stalled", 1.0, 0}), std::invalid_argument);
+
+    TDAG emptyDag;
+    auto job = scheduler.submit(emptyDag);
+    EXPECT_TRUE(job.isDone());
+    EXPECT_EQ(0u, job.getStats().nodeCnt);
+}
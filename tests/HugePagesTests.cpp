@@ -0,0 +1,99 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+HugePagesTests.cpp
+
+This file contains unit tests for the huge page backed memory. Whether huge pages are
+actually available depends on the host, so the tests only insist on the fallbacks working.
+The main test cases are:
+
+- testAllocateFallback: Every mode yields usable, zero filled memory, rounded and aligned to huge pages.
+- testBufferPoolBacking: A huge page backed buffer pool fills a huge page per chunk.
+- testShmQueueBacking: A huge page backed shared memory queue works like a regular one.
+--------------------------------------------------------------------------------
+*/
+
+#include "BufferPool.hpp"
+#include "ShmTaskQueue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <unistd.h>
+
+using namespace t_pool;
+
+class HugePagesTests : public ::testing::Test
+{
+};
+
+TEST_F(HugePagesTests, testAllocateFallback)
+{
+    for (auto mode : {HugePageMode::OFF, HugePageMode::TRANSPARENT, HugePageMode::EXPLICIT})
+    {
+        auto region = allocateHugePages(100000, mode);
+        ASSERT_NE(nullptr, region.pData);
+        EXPECT_LE(static_cast<uint32_t>(region.backing), static_cast<uint32_t>(mode));
+        if (mode == HugePageMode::OFF)
+        {
+            EXPECT_EQ(100000u, region.size);
+        }
+        else
+        {
+            EXPECT_EQ(HUGE_PAGE_SIZE, region.size);
+            EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(region.pData) % HUGE_PAGE_SIZE);
+        }
+        auto pBytes = static_cast<unsigned char*>(region.pData);
+        EXPECT_EQ(0u, pBytes[0]);
+        EXPECT_EQ(0u, pBytes[region.size - 1]);
+        std::memset(pBytes, 0xAB, region.size);
+        freeHugePages(region);
+    }
+}
+
+TEST_F(HugePagesTests, testBufferPoolBacking)
+{
+    BufferPool pool(4096 - sizeof(BufferSlab), 1, 64, HugePageMode::TRANSPARENT);
+    {
+        auto buffer = pool.acquire(100);
+        std::memset(buffer.getData(), 1, 100);
+    }
+    EXPECT_EQ(HUGE_PAGE_SIZE / 4096, pool.getAllocatedCnt());
+    EXPECT_TRUE(pool.getHugePageBytes() == 0 || pool.getHugePageBytes() == HUGE_PAGE_SIZE);
+}
+
+TEST_F(HugePagesTests, testShmQueueBacking)
+{
+    auto queueName = "/HugePagesTests_" + std::to_string(::getpid());
+    ShmTaskQueue queue(queueName, 1024, 4000, HugePageMode::TRANSPARENT);
+    ShmTaskQueue consumer(queueName);
+    uint32_t value = 42;
+    ASSERT_TRUE(queue.tryPush("echo", &value, sizeof(value)));
+    ShmTaskQueue::ReadSlot slot;
+    ASSERT_TRUE(consumer.tryPop(slot));
+    std::memcpy(&value, slot.pData, sizeof(value));
+    consumer.release(slot);
+    EXPECT_EQ(42u, value);
+}
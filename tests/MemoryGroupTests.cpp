@@ -0,0 +1,189 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+MemoryGroupTests.cpp
+
+This file contains unit tests for the per task group memory accounting. The main test cases are:
+
+- testTrackedAllocator: Containers using the tracked allocator charge and credit the current group.
+- testTaskAttribution: Buffers acquired by a task are charged to the group it was submitted to.
+- testFailOverBudget: Submissions to a failing group over its budget throw.
+- testDeferOverBudget: Submissions to a deferring group over its budget run once memory is freed.
+- testDeferWhileDestroying: Tasks deferred by a running task while the pool is destroyed still run.
+- testDeferAcrossReset: Resetting the pool neither waits for nor runs the tasks deferred over budget.
+--------------------------------------------------------------------------------
+*/
+
+#include "BufferPool.hpp"
+#include "ThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace t_pool;
+
+class MemoryGroupTests : public ::testing::Test
+{
+};
+
+TEST_F(MemoryGroupTests, testTrackedAllocator)
+{
+    auto pGroup = std::make_shared<MemoryGroup>("parser");
+    EXPECT_EQ(nullptr, MemoryGroup::getCurrent());
+    {
+        MemoryGroup::Scope scope(pGroup.get());
+        EXPECT_EQ(pGroup.get(), MemoryGroup::getCurrent());
+        std::vector<uint64_t, TrackedAllocator<uint64_t>> values;
+        values.reserve(1000);
+        EXPECT_EQ(8000u, pGroup->getUsedBytes());
+        values.resize(2000);
+        EXPECT_EQ(16000u, pGroup->getUsedBytes());
+    }
+    EXPECT_EQ(nullptr, MemoryGroup::getCurrent());
+    EXPECT_EQ(0u, pGroup->getUsedBytes());
+    EXPECT_EQ(24000u, pGroup->getPeakBytes());
+    EXPECT_EQ(2u, pGroup->getAllocationCnt());
+
+    // Outside of any group nothing is charged
+    std::vector<uint64_t, TrackedAllocator<uint64_t>> untracked(100);
+    EXPECT_EQ(2u, pGroup->getAllocationCnt());
+}
+
+TEST_F(MemoryGroupTests, testTaskAttribution)
+{
+    auto pGroup = std::make_shared<MemoryGroup>("loader");
+    BufferPool bufferPool(1000, 1);
+    ThreadPool tpool(2);
+
+    auto future = tpool.submitToGroup(pGroup, [&bufferPool]()
+    {
+        std::vector<Buffer> buffers;
+        for (auto idx = 0; idx < 3; ++idx)
+            buffers.emplace_back(bufferPool.acquire(1000));
+        return buffers;
+    });
+    auto buffers = std::any_cast<std::vector<Buffer>>(future.get());
+    EXPECT_EQ(3000u, pGroup->getUsedBytes());
+
+    // Buffers acquired outside the group's tasks are not charged to it
+    auto other = tpool.submit([&bufferPool]() { return bufferPool.acquire(); });
+    auto otherBuffer = std::any_cast<Buffer>(other.get());
+    EXPECT_EQ(3000u, pGroup->getUsedBytes());
+
+    buffers.clear();
+    EXPECT_EQ(0u, pGroup->getUsedBytes());
+    EXPECT_EQ(3000u, pGroup->getPeakBytes());
+}
+
+TEST_F(MemoryGroupTests, testFailOverBudget)
+{
+    auto pGroup = std::make_shared<MemoryGroup>("bounded", 100, MemoryGroup::OverBudget::FAIL);
+    ThreadPool tpool(2);
+    pGroup->charge(200);
+    EXPECT_TRUE(pGroup->isOverBudget());
+    EXPECT_THROW(tpool.submitToGroup(pGroup, []() { return 1; }), std::runtime_error);
+    pGroup->release(200);
+    EXPECT_EQ(1, std::any_cast<int>(tpool.submitToGroup(pGroup, []() { return 1; }).get()));
+}
+
+TEST_F(MemoryGroupTests, testDeferOverBudget)
+{
+    auto pGroup = std::make_shared<MemoryGroup>("deferred", 1000, MemoryGroup::OverBudget::DEFER);
+    BufferPool bufferPool(4096, 1);
+    Buffer held;
+    {
+        MemoryGroup::Scope scope(pGroup.get());
+        held = bufferPool.acquire();
+    }
+    EXPECT_TRUE(pGroup->isOverBudget());
+
+    ThreadPool tpool(2);
+    std::atomic<uint32_t> ran = 0;
+    std::vector<std::future<std::any>> futures;
+    for (auto idx = 0; idx < 3; ++idx)
+        futures.emplace_back(tpool.submitToGroup(pGroup, [&ran]() { return ++ran; }));
+    EXPECT_EQ(3u, tpool.getTaskDeferredCnt());
+    EXPECT_EQ(3u, tpool.getTotalTaskCnt());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(0u, ran);
+
+    held.reset();
+    for (auto& future : futures)
+        future.get();
+    EXPECT_EQ(3u, ran);
+    EXPECT_EQ(0u, tpool.getTaskDeferredCnt());
+}
+
+TEST_F(MemoryGroupTests, testDeferWhileDestroying)
+{
+    auto pGroup = std::make_shared<MemoryGroup>("stuck", 1000, MemoryGroup::OverBudget::DEFER);
+    BufferPool bufferPool(4096, 1);
+    Buffer held;
+    {
+        MemoryGroup::Scope scope(pGroup.get());
+        held = bufferPool.acquire();    // Held past the pool, the budget never frees up
+    }
+
+    std::atomic_bool isDestroying = false;
+    std::atomic<uint32_t> ran = 0;
+    {
+        ThreadPool tpool(2);
+        tpool.submit([&tpool, &pGroup, &isDestroying, &ran]()
+        {
+            while (!isDestroying)
+                std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));   // Lets the destructor wait first
+            for (auto idx = 0; idx < 3; ++idx)
+                tpool.submitToGroup(pGroup, [&ran]() { return ++ran; });
+        });
+        isDestroying = true;
+    }
+    EXPECT_EQ(3u, ran);
+}
+
+TEST_F(MemoryGroupTests, testDeferAcrossReset)
+{
+    auto pGroup = std::make_shared<MemoryGroup>("kept", 1000, MemoryGroup::OverBudget::DEFER);
+    BufferPool bufferPool(4096, 1);
+    Buffer held;
+    {
+        MemoryGroup::Scope scope(pGroup.get());
+        held = bufferPool.acquire();
+    }
+
+    ThreadPool tpool(2);
+    std::atomic<uint32_t> ran = 0;
+    auto future = tpool.submitToGroup(pGroup, [&ran]() { return ++ran; });
+    tpool.reset(3);
+    EXPECT_EQ(1u, tpool.getTaskDeferredCnt());
+    EXPECT_EQ(1u, tpool.getTotalTaskCnt());
+    EXPECT_EQ(0u, tpool.getTaskRunningCnt());
+    EXPECT_EQ(0u, ran);
+
+    held.reset();
+    future.get();
+    EXPECT_EQ(1u, ran);
+    EXPECT_EQ(0u, tpool.getTaskDeferredCnt());
+}
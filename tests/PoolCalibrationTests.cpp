@@ -0,0 +1,194 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+PoolCalibrationTests.cpp
+
+This file contains unit tests for the startup calibration of the pools. The main test cases are:
+
+- testChooseParameters: The idle policy and the queueing mode follow the measurements.
+- testCalibrate: The host is measured and the chosen parameters are within their bounds.
+- testCache: Measurements cached in a file are reused, ones from another host (name or thread count) aren't.
+- testTunedPool: A pool constructed with a tuning runs with its parameters.
+- testNestedWait: A task waiting for a task it submitted completes on a calibrated pool.
+--------------------------------------------------------------------------------
+*/
+
+#include "PoolCalibration.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace t_pool;
+using namespace std::chrono_literals;
+
+class PoolCalibrationTests : public ::testing::Test
+{
+    public:
+        PoolCalibrationTests()
+            : m_cachePath((std::filesystem::temp_directory_path() /
+                           ("PoolCalibrationTests_" + std::to_string(::getpid()) + ".tuning")).string())
+        {}
+        ~PoolCalibrationTests() { std::remove(m_cachePath.c_str()); }
+
+    protected:
+        std::string m_cachePath;
+};
+
+TEST_F(PoolCalibrationTests, testChooseParameters)
+{
+    PoolTuning tuning;
+    tuning.hardwareThreadCnt = 8;
+    tuning.wakeLatency = 50us;
+    tuning.yieldCost = 200ns;
+    tuning.lineTransferCost = 50ns;
+    tuning.stealCost = 100ns;
+    choosePoolParameters(tuning, 8);
+    EXPECT_EQ(250u, tuning.idleSpinCnt);
+    EXPECT_EQ(50u, tuning.sleepDuration);
+    EXPECT_EQ(QueueMode::SHARDED, tuning.queueMode);
+
+    tuning.stealCost = 1us;
+    choosePoolParameters(tuning, 8);
+    EXPECT_EQ(QueueMode::SHARDED, tuning.queueMode);    // PER_CORE only on request
+    tuning.allowPerCore = true;
+    choosePoolParameters(tuning, 8);
+    EXPECT_EQ(QueueMode::PER_CORE, tuning.queueMode);
+    choosePoolParameters(tuning, 16);   // More workers than cores
+    EXPECT_EQ(QueueMode::SHARDED, tuning.queueMode);
+    choosePoolParameters(tuning, 2);
+    EXPECT_EQ(QueueMode::SHARED, tuning.queueMode);
+
+    // Out of range measurements are clamped
+    tuning.wakeLatency = 0ns;
+    tuning.yieldCost = 0ns;
+    choosePoolParameters(tuning, 2);
+    EXPECT_EQ(16u, tuning.idleSpinCnt);
+    EXPECT_EQ(1u, tuning.sleepDuration);
+    tuning.wakeLatency = 1s;
+    choosePoolParameters(tuning, 2);
+    EXPECT_EQ(4096u, tuning.idleSpinCnt);
+    EXPECT_EQ(1000u, tuning.sleepDuration);
+}
+
+TEST_F(PoolCalibrationTests, testCalibrate)
+{
+    auto tuning = calibratePool(4);
+    EXPECT_EQ(std::thread::hardware_concurrency(), tuning.hardwareThreadCnt);
+    EXPECT_GT(tuning.yieldCost, 0ns);
+    if (tuning.hardwareThreadCnt > 1)
+    {
+        EXPECT_GT(tuning.lineTransferCost, 0ns);
+        EXPECT_GT(tuning.stealCost, 0ns);
+    }
+    EXPECT_GE(tuning.idleSpinCnt, 16u);
+    EXPECT_LE(tuning.idleSpinCnt, 4096u);
+    EXPECT_GE(tuning.sleepDuration, 1u);
+    EXPECT_LE(tuning.sleepDuration, 1000u);
+}
+
+TEST_F(PoolCalibrationTests, testCache)
+{
+    PoolTuning tuning;
+    tuning.hostName = getCalibrationHostName();
+    tuning.hardwareThreadCnt = std::thread::hardware_concurrency();
+    tuning.wakeLatency = 12345ns;
+    tuning.lineTransferCost = 67ns;
+    tuning.stealCost = 890ns;
+    tuning.yieldCost = 321ns;
+    ASSERT_TRUE(saveTuning(tuning, m_cachePath));
+
+    // Reused as they are, not measured again
+    auto cached = calibratePool(4, m_cachePath);
+    EXPECT_EQ(12345ns, cached.wakeLatency);
+    EXPECT_EQ(67ns, cached.lineTransferCost);
+    EXPECT_EQ(890ns, cached.stealCost);
+    EXPECT_EQ(321ns, cached.yieldCost);
+    EXPECT_EQ(13u, cached.sleepDuration);
+
+    // Another host's are measured again and overwritten
+    PoolTuning loaded;
+    tuning.hostName += "-elsewhere";
+    ASSERT_TRUE(saveTuning(tuning, m_cachePath));
+    EXPECT_FALSE(loadTuning(loaded, m_cachePath));
+    tuning.hostName = getCalibrationHostName();
+    tuning.hardwareThreadCnt += 1;
+    ASSERT_TRUE(saveTuning(tuning, m_cachePath));
+    EXPECT_FALSE(loadTuning(loaded, m_cachePath));
+    auto measured = calibratePool(4, m_cachePath);
+    EXPECT_EQ(std::thread::hardware_concurrency(), measured.hardwareThreadCnt);
+    EXPECT_EQ(getCalibrationHostName(), measured.hostName);
+    EXPECT_TRUE(loadTuning(loaded, m_cachePath));
+    EXPECT_EQ(measured.wakeLatency, loaded.wakeLatency);
+
+    {
+        std::ofstream file(m_cachePath, std::ios::trunc);
+        file << "hardwareThreads\t" << std::thread::hardware_concurrency() << "\nwakeLatencyNs\tmany\n";
+    }
+    EXPECT_FALSE(loadTuning(loaded, m_cachePath));
+    EXPECT_FALSE(loadTuning(loaded, m_cachePath + ".missing"));
+}
+
+TEST_F(PoolCalibrationTests, testTunedPool)
+{
+    PoolTuning tuning;
+    tuning.idleSpinCnt = 32;
+    tuning.sleepDuration = 20;
+    tuning.queueMode = QueueMode::SHARDED;
+    ThreadPool tpool(4, tuning);
+    EXPECT_EQ(QueueMode::SHARDED, tpool.getQueueMode());
+    EXPECT_EQ(32u, tpool.getIdleSpinCnt());
+    EXPECT_EQ(20u, tpool.getSleepDuration());
+
+    std::atomic<uint32_t> ranCnt = 0;
+    std::vector<std::future<std::any>> futures;
+    for (uint32_t idx = 0; idx < 100; ++idx)
+        futures.push_back(tpool.submit([&ranCnt]() { ++ranCnt; }));
+    for (auto& future : futures)
+        future.get();
+    EXPECT_EQ(100u, ranCnt);
+
+    tpool.setIdlePolicy(0, 0);
+    EXPECT_EQ(0u, tpool.getIdleSpinCnt());
+    EXPECT_EQ(0u, tpool.getSleepDuration());
+}
+
+TEST_F(PoolCalibrationTests, testNestedWait)
+{
+    auto tuning = calibratePool(4);
+    EXPECT_NE(QueueMode::PER_CORE, tuning.queueMode);
+    ThreadPool tpool(4, tuning);
+    auto outer = tpool.submit([&tpool]()
+    {
+        auto child = tpool.submit([]() { return 7; });
+        return std::any_cast<int>(child.get()) + 1;
+    });
+    ASSERT_EQ(std::future_status::ready, outer.wait_for(5s));
+    EXPECT_EQ(8, std::any_cast<int>(outer.get()));
+}
@@ -0,0 +1,214 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+QueueModeTests.cpp
+
+This file contains unit tests for the queueing modes of the pool. The main test cases are:
+
+- testSpscRing: The ring hands values over in order and refuses them when full.
+- testPerCoreLocality: Tasks submitted by a worker of a PER_CORE pool run on the same worker.
+- testSubmitTo: Tasks sent to a worker run on it, from outside the pool and from another core.
+- testShardedManyProducers: Tasks of many producers are spread over the shards and all run.
+- testDataHint: Tasks submitted with a hint of their data run as any other, the hint kept with the task.
+- testSameCodeAllModes: The same workload gives the same results in every mode, also once resized.
+--------------------------------------------------------------------------------
+*/
+
+#include "SpscRing.hpp"
+#include "ThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+class QueueModeTests : public ::testing::Test
+{
+    protected:
+        static uint64_t runWorkload(ThreadPool& tpool)
+        {
+            std::vector<std::future<std::any>> futures;
+            for (uint64_t idx = 1; idx <= 200; ++idx)
+            {
+                futures.emplace_back(tpool.submit([&tpool, idx]()
+                {
+                    // Nested submissions, as a DAG releasing its successors does
+                    auto inner = tpool.submit([idx]() { return idx * 2; });
+                    return idx;
+                }));
+            }
+            uint64_t sum = 0;
+            for (auto& future : futures)
+                sum += std::any_cast<uint64_t>(future.get());
+            return sum;
+        }
+};
+
+TEST_F(QueueModeTests, testSpscRing)
+{
+    SpscRing<int> ring(3);
+    EXPECT_EQ(4u, ring.getCapacity());
+    for (auto value = 0; value < 4; ++value)
+        EXPECT_TRUE(ring.tryPush(value));
+    auto extra = 4;
+    EXPECT_FALSE(ring.tryPush(extra));
+    for (auto expected = 0; expected < 4; ++expected)
+    {
+        int value = -1;
+        ASSERT_TRUE(ring.tryPop(value));
+        EXPECT_EQ(expected, value);
+    }
+    int value = -1;
+    EXPECT_FALSE(ring.tryPop(value));
+}
+
+TEST_F(QueueModeTests, testPerCoreLocality)
+{
+    constexpr auto TASK_CNT = 16;
+    std::array<std::atomic<ui32>, TASK_CNT> outerIdxs;
+    std::array<std::atomic<ui32>, TASK_CNT> innerIdxs;
+    {
+        ThreadPool tpool(4, QueueMode::PER_CORE);
+        EXPECT_EQ(QueueMode::PER_CORE, tpool.getQueueMode());
+        EXPECT_EQ(ThreadPool::NOT_A_WORKER, tpool.getWorkerIdx());
+        for (auto idx = 0; idx < TASK_CNT; ++idx)
+        {
+            // A core must not wait for its own tasks, it is the only one to run them
+            tpool.submit([&tpool, &outerIdxs, &innerIdxs, idx]()
+            {
+                outerIdxs[idx] = tpool.getWorkerIdx();
+                tpool.submit([&tpool, &innerIdxs, idx]() { innerIdxs[idx] = tpool.getWorkerIdx(); });
+            });
+        }
+    }
+    for (auto idx = 0; idx < TASK_CNT; ++idx)
+    {
+        EXPECT_LT(outerIdxs[idx].load(), 4u);
+        EXPECT_EQ(outerIdxs[idx].load(), innerIdxs[idx].load());
+    }
+}
+
+TEST_F(QueueModeTests, testSubmitTo)
+{
+    ThreadPool tpool(3, QueueMode::PER_CORE);
+    for (ui32 workerIdx = 0; workerIdx < 3; ++workerIdx)
+    {
+        auto future = tpool.submitTo(workerIdx, [&tpool]() { return tpool.getWorkerIdx(); });
+        EXPECT_EQ(workerIdx, std::any_cast<ui32>(future.get()));
+    }
+
+    // From core 0 to core 2 through their ring, more than the ring holds
+    std::vector<std::future<std::any>> futures;
+    std::mutex futuresMtx;
+    tpool.submitTo(0, [&tpool, &futures, &futuresMtx]()
+    {
+        for (auto idx = 0; idx < 300; ++idx)
+        {
+            auto future = tpool.submitTo(2, [&tpool]() { return tpool.getWorkerIdx(); });
+            std::lock_guard<std::mutex> lock(futuresMtx);
+            futures.emplace_back(std::move(future));
+        }
+    }).get();
+    ASSERT_EQ(300u, futures.size());
+    for (auto& future : futures)
+        EXPECT_EQ(2u, std::any_cast<ui32>(future.get()));
+}
+
+TEST_F(QueueModeTests, testShardedManyProducers)
+{
+    constexpr auto PRODUCER_CNT = 8;
+    constexpr auto TASK_CNT = 500;
+    std::atomic<uint64_t> sum = 0;
+    std::array<std::atomic<uint32_t>, 4> ranBy = {};
+    {
+        ThreadPool tpool(4, QueueMode::SHARDED);
+        std::vector<std::thread> producers;
+        for (auto producerIdx = 0; producerIdx < PRODUCER_CNT; ++producerIdx)
+        {
+            producers.emplace_back([&tpool, &sum, &ranBy]()
+            {
+                for (uint64_t idx = 1; idx <= TASK_CNT; ++idx)
+                {
+                    tpool.submit([&tpool, &sum, &ranBy, idx]()
+                    {
+                        ++ranBy[tpool.getWorkerIdx()];
+                        sum += idx;
+                    });
+                }
+            });
+        }
+        for (auto& producer : producers)
+            producer.join();
+    }
+    EXPECT_EQ(PRODUCER_CNT * (TASK_CNT * (TASK_CNT + 1) / 2), sum.load());
+    uint32_t ranCnt = 0;
+    for (auto& cnt : ranBy)
+        ranCnt += cnt;
+    EXPECT_EQ(static_cast<uint32_t>(PRODUCER_CNT * TASK_CNT), ranCnt);
+}
+
+TEST_F(QueueModeTests, testDataHint)
+{
+    Task task;
+    EXPECT_EQ(nullptr, task.getDataHint());
+    std::vector<uint64_t> values(1024, 1);
+    task.setDataHint(values.data());
+    EXPECT_EQ(values.data(), task.getDataHint());
+
+    for (auto queueMode : {QueueMode::SHARED, QueueMode::PER_CORE, QueueMode::SHARDED})
+    {
+        ThreadPool tpool(2, queueMode);
+        std::vector<std::vector<uint64_t>> blocks(64, values);
+        std::vector<std::future<std::any>> futures;
+        for (auto& block : blocks)
+        {
+            futures.emplace_back(tpool.submitWithHint(block.data(), [&block]()
+            {
+                uint64_t sum = 0;
+                for (auto value : block)
+                    sum += value;
+                return sum;
+            }));
+        }
+        for (auto& future : futures)
+            EXPECT_EQ(1024u, std::any_cast<uint64_t>(future.get()));
+    }
+}
+
+TEST_F(QueueModeTests, testSameCodeAllModes)
+{
+    for (auto queueMode : {QueueMode::SHARED, QueueMode::PER_CORE, QueueMode::SHARDED})
+    {
+        ThreadPool tpool(4, queueMode);
+        EXPECT_EQ(20100u, runWorkload(tpool));
+
+        tpool.reset(2);
+        EXPECT_EQ(2u, tpool.getPoolSize());
+        EXPECT_EQ(20100u, runWorkload(tpool));
+    }
+}
@@ -0,0 +1,222 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+ShmStatsPageTests.cpp
+
+This file contains unit tests for the shared memory stats page. The main test cases are:
+
+- testPublishRead: Counters written by the owner are read back by a handle attached by name.
+- testNoTornReads: A reader never sees a half written record while the writer keeps publishing.
+- testInvalidUse: Duplicate and missing pages are rejected, out of range workers aren't read.
+- testPoolPublishes: A pool with a page attached publishes its own and its workers' counters.
+- testNestedTasksCountedOnce: Tasks run within a yielding task add to the busy time of their worker once.
+--------------------------------------------------------------------------------
+*/
+
+#include "ShmStatsPage.hpp"
+#include "ThreadPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace t_pool;
+
+class ShmStatsPageTests : public ::testing::Test
+{
+    public:
+        ShmStatsPageTests()
+            : m_pageName("/ShmStatsPageTests_" + std::to_string(::getpid()))
+        {}
+
+    protected:
+        std::string m_pageName;
+};
+
+TEST_F(ShmStatsPageTests, testPublishRead)
+{
+    ShmStatsPage page(m_pageName, 2);
+    EXPECT_TRUE(page.isOwner());
+    PoolStats poolStats;
+    poolStats.publishedNs = 1;
+    poolStats.poolSize = 2;
+    poolStats.taskCnt = 3;
+    poolStats.queuedCnt = 4;
+    poolStats.deferredCnt = 5;
+    poolStats.deadlineMissedCnt = 6;
+    poolStats.yieldCnt = 7;
+    page.publishPool(poolStats);
+    page.recordWorkerTask(1, 100, 1000);
+    page.recordWorkerTask(1, 50, 2000);
+
+    ShmStatsPage reader(m_pageName);
+    EXPECT_FALSE(reader.isOwner());
+    EXPECT_EQ(2u, reader.getWorkerCapacity());
+    PoolStats readStats;
+    ASSERT_TRUE(reader.readPool(readStats));
+    EXPECT_EQ(1u, readStats.publishedNs);
+    EXPECT_EQ(2u, readStats.poolSize);
+    EXPECT_EQ(3u, readStats.taskCnt);
+    EXPECT_EQ(4u, readStats.queuedCnt);
+    EXPECT_EQ(5u, readStats.deferredCnt);
+    EXPECT_EQ(6u, readStats.deadlineMissedCnt);
+    EXPECT_EQ(7u, readStats.yieldCnt);
+
+    WorkerStats workerStats;
+    ASSERT_TRUE(reader.readWorker(0, workerStats));
+    EXPECT_EQ(0u, workerStats.taskCnt);
+    ASSERT_TRUE(reader.readWorker(1, workerStats));
+    EXPECT_EQ(2u, workerStats.taskCnt);
+    EXPECT_EQ(150u, workerStats.busyNs);
+    EXPECT_EQ(2000u, workerStats.lastTaskEndNs);
+}
+
+TEST_F(ShmStatsPageTests, testNoTornReads)
+{
+    ShmStatsPage page(m_pageName, 1);
+    ShmStatsPage reader(m_pageName);
+    std::atomic_bool isDone = false;
+    std::thread writer([&page, &isDone]()
+    {
+        for (uint64_t value = 1; value <= 200000; ++value)
+        {
+            PoolStats stats;
+            stats.publishedNs = stats.poolSize = stats.taskCnt = stats.queuedCnt = value;
+            stats.deferredCnt = stats.deadlineMissedCnt = stats.yieldCnt = value;
+            page.publishPool(stats);
+        }
+        isDone = true;
+    });
+
+    uint64_t readCnt = 0, lastValue = 0;
+    while (!isDone)
+    {
+        PoolStats stats;
+        if (!reader.readPool(stats))
+            continue;
+        ++readCnt;
+        ASSERT_EQ(stats.publishedNs, stats.yieldCnt);
+        ASSERT_EQ(stats.poolSize, stats.deadlineMissedCnt);
+        ASSERT_EQ(stats.taskCnt, stats.deferredCnt);
+        ASSERT_EQ(stats.queuedCnt, stats.publishedNs);
+        ASSERT_LE(lastValue, stats.publishedNs);
+        lastValue = stats.publishedNs;
+    }
+    writer.join();
+    EXPECT_GT(readCnt, 0u);
+}
+
+TEST_F(ShmStatsPageTests, testInvalidUse)
+{
+    EXPECT_THROW(ShmStatsPage reader(m_pageName), std::runtime_error);
+    ShmStatsPage page(m_pageName, 1);
+    EXPECT_THROW(ShmStatsPage duplicate(m_pageName, 1), std::runtime_error);
+    WorkerStats workerStats;
+    EXPECT_FALSE(page.readWorker(1, workerStats));
+    page.recordWorkerTask(1, 1, 1);     // Ignored
+    EXPECT_TRUE(page.readWorker(0, workerStats));
+    EXPECT_EQ(0u, workerStats.taskCnt);
+}
+
+TEST_F(ShmStatsPageTests, testPoolPublishes)
+{
+    constexpr uint32_t TASK_CNT = 200;
+    auto pPage = std::make_shared<ShmStatsPage>(m_pageName, 4);
+    ShmStatsPage reader(m_pageName);
+    {
+        ThreadPool tpool(4);
+        tpool.setStatsPage(pPage);
+        PoolStats poolStats;
+        ASSERT_TRUE(reader.readPool(poolStats));
+        EXPECT_EQ(4u, poolStats.poolSize);
+        EXPECT_GT(poolStats.publishedNs, 0u);
+
+        std::vector<std::future<std::any>> futures;
+        for (uint32_t idx = 0; idx < TASK_CNT; ++idx)
+            futures.push_back(tpool.submit([]() { std::this_thread::sleep_for(std::chrono::microseconds(10)); }));
+        for (auto& future : futures)
+            future.get();
+
+        // The idle workers publish the drained pool shortly
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (reader.readPool(poolStats) && poolStats.taskCnt && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        EXPECT_EQ(0u, poolStats.taskCnt);
+        EXPECT_EQ(0u, poolStats.queuedCnt);
+
+        // A future is ready before its worker accounts the task
+        while (tpool.getTotalTaskCnt())
+            std::this_thread::yield();
+        tpool.setStatsPage(nullptr);
+        EXPECT_EQ(nullptr, tpool.getStatsPage());
+    }
+
+    uint64_t ranCnt = 0, busyNs = 0;
+    for (uint32_t idx = 0; idx < reader.getWorkerCapacity(); ++idx)
+    {
+        WorkerStats workerStats;
+        ASSERT_TRUE(reader.readWorker(idx, workerStats));
+        ranCnt += workerStats.taskCnt;
+        busyNs += workerStats.busyNs;
+    }
+    EXPECT_EQ(TASK_CNT, ranCnt);
+    EXPECT_GE(busyNs, TASK_CNT * 10000u);
+}
+
+TEST_F(ShmStatsPageTests, testNestedTasksCountedOnce)
+{
+    constexpr uint32_t NESTED_CNT = 5;
+    constexpr auto NAP = std::chrono::milliseconds(5);
+    auto pPage = std::make_shared<ShmStatsPage>(m_pageName, 1);
+    ShmStatsPage reader(m_pageName);
+    std::chrono::steady_clock::duration wallTime;
+    {
+        ThreadPool tpool(1);
+        tpool.setStatsPage(pPage);
+        auto startTime = std::chrono::steady_clock::now();
+        auto outer = tpool.submit([&tpool]()
+        {
+            while (tpool.getTaskQueued() < NESTED_CNT)
+                std::this_thread::yield();
+            return tpool.yieldNow();
+        });
+        std::vector<std::future<std::any>> futures;
+        for (uint32_t idx = 0; idx < NESTED_CNT; ++idx)
+            futures.push_back(tpool.submit([NAP]() { std::this_thread::sleep_for(NAP); }));
+        EXPECT_EQ(NESTED_CNT, std::any_cast<ui32>(outer.get()));
+        while (tpool.getTotalTaskCnt())     // The future is ready before the worker accounts the task
+            std::this_thread::yield();
+        tpool.setStatsPage(nullptr);
+        wallTime = std::chrono::steady_clock::now() - startTime;
+    }
+
+    WorkerStats workerStats;
+    ASSERT_TRUE(reader.readWorker(0, workerStats));
+    EXPECT_EQ(NESTED_CNT + 1, workerStats.taskCnt);
+    EXPECT_GE(workerStats.busyNs, static_cast<uint64_t>(std::chrono::nanoseconds(NAP * NESTED_CNT).count()));
+    EXPECT_LE(workerStats.busyNs, static_cast<uint64_t>(std::chrono::nanoseconds(wallTime).count()));
+}
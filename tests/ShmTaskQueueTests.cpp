@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+ShmTaskQueueTests.cpp
+
+This file contains unit tests for the shared memory task queue. The main test cases are:
+
+- testPushPop: Descriptors come out in order, with their payload in place, and a full queue refuses pushes.
+- testServe: Descriptors are dispatched to the pool, unknown handlers are dropped.
+- testInvalidUse: Oversized payloads, duplicate and missing queues are rejected.
+- testCrossProcess: A forked producer process feeds the pool of the parent through the queue.
+--------------------------------------------------------------------------------
+*/
+
+#include "ShmTaskQueue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace t_pool;
+
+class ShmTaskQueueTests : public ::testing::Test
+{
+    public:
+        ShmTaskQueueTests()
+            : m_queueName("/ShmTaskQueueTests_" + std::to_string(::getpid()))
+        {}
+
+    protected:
+        std::string m_queueName;
+};
+
+TEST_F(ShmTaskQueueTests, testPushPop)
+{
+    ShmTaskQueue queue(m_queueName, 3, 16);
+    EXPECT_EQ(4u, queue.getSlotCnt());
+    EXPECT_EQ(16u, queue.getSlotSize());
+
+    for (uint32_t idx = 0; idx < 4; ++idx)
+        EXPECT_TRUE(queue.tryPush("echo", &idx, sizeof(idx)));
+    uint32_t value = 4;
+    EXPECT_FALSE(queue.tryPush("echo", &value, sizeof(value)));
+
+    // Another handle on the same segment sees the same ring
+    ShmTaskQueue consumer(m_queueName);
+    ShmTaskQueue::ReadSlot slot;
+    ASSERT_TRUE(consumer.tryPop(slot));
+    EXPECT_EQ("echo", slot.handlerName);
+    ASSERT_EQ(sizeof(uint32_t), slot.size);
+    std::memcpy(&value, slot.pData, sizeof(value));
+    EXPECT_EQ(0u, value);
+    consumer.release(slot);
+
+    // The released slot takes the next lap, written in place
+    auto writeSlot = queue.beginPush("echo", sizeof(uint32_t));
+    ASSERT_TRUE(writeSlot);
+    value = 4;
+    std::memcpy(writeSlot.pData, &value, sizeof(value));
+    queue.commitPush(writeSlot);
+
+    for (uint32_t idx = 1; idx <= 4; ++idx)
+    {
+        ASSERT_TRUE(consumer.tryPop(slot));
+        std::memcpy(&value, slot.pData, sizeof(value));
+        EXPECT_EQ(idx, value);
+        consumer.release(slot);
+    }
+    EXPECT_FALSE(consumer.tryPop(slot));
+}
+
+TEST_F(ShmTaskQueueTests, testServe)
+{
+    ShmTaskQueue queue(m_queueName, 64, 8);
+    std::atomic<uint64_t> sum = 0;
+    ShmHandlerRegistry registry;
+    registry.registerHandler("add", [&sum](const void* pData, uint32_t size)
+    {
+        uint64_t value = 0;
+        std::memcpy(&value, pData, std::min<size_t>(size, sizeof(value)));
+        sum += value;
+    });
+
+    for (uint64_t value = 1; value <= 10; ++value)
+        queue.tryPush("add", &value, sizeof(value));
+    queue.tryPush("unknown", nullptr, 0);
+
+    ThreadPool pool(2);
+    EXPECT_EQ(5u, queue.serve(pool, registry, 5));
+    EXPECT_EQ(6u, queue.serve(pool, registry, 100));
+    EXPECT_EQ(0u, queue.serve(pool, registry, 100));
+    while (pool.getTotalTaskCnt())
+        std::this_thread::yield();
+    EXPECT_EQ(55u, sum);
+}
+
+TEST_F(ShmTaskQueueTests, testInvalidUse)
+{
+    EXPECT_THROW(ShmTaskQueue queue(m_queueName), std::runtime_error);
+    ShmTaskQueue queue(m_queueName, 4, 8);
+    EXPECT_THROW(ShmTaskQueue duplicate(m_queueName, 4, 8), std::runtime_error);
+    char payload[9] = {};
+    EXPECT_THROW(queue.tryPush("big", payload, sizeof(payload)), std::invalid_argument);
+    EXPECT_THROW(queue.tryPush(std::string(ShmTaskQueue::MAX_HANDLER_NAME_LENGTH + 1, 'x'), payload, 1),
+                 std::invalid_argument);
+}
+
+TEST_F(ShmTaskQueueTests, testCrossProcess)
+{
+    constexpr uint64_t TASKS = 5000;
+    ShmTaskQueue queue(m_queueName, 256, 64);
+
+    auto childPid = ::fork();
+    ASSERT_GE(childPid, 0);
+    if (childPid == 0)
+    {
+        // The producer process, only talks to the queue
+        try
+        {
+            ShmTaskQueue producer(m_queueName);
+            for (uint64_t value = 1; value <= TASKS; ++value)
+            {
+                while (!producer.tryPush("add", &value, sizeof(value)))
+                    std::this_thread::yield();
+            }
+        }
+        catch (...)
+        {
+            ::_exit(1);
+        }
+        ::_exit(0);
+    }
+
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint64_t> handled = 0;
+    ShmHandlerRegistry registry;
+    registry.registerHandler("add", [&](const void* pData, uint32_t)
+    {
+        uint64_t value = 0;
+        std::memcpy(&value, pData, sizeof(value));
+        sum += value;
+        ++handled;
+    });
+
+    ThreadPool pool(2);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (handled < TASKS && std::chrono::steady_clock::now() < deadline)
+    {
+        if (!queue.serve(pool, registry, 64))
+            std::this_thread::yield();
+    }
+    int status = 0;
+    ASSERT_EQ(childPid, ::waitpid(childPid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_EQ(TASKS, handled);
+    EXPECT_EQ(TASKS * (TASKS + 1) / 2, sum);
+}
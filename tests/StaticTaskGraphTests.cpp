@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+--------------------------------------------------------------------------------
+StaticTaskGraphTests.cpp
+
+This file contains unit tests for the task graphs fixed at compile time. The main test cases are:
+
+- testLayout: The compiler lays out the dependency counts and the successors of the nodes.
+- testRunOrder: Every node runs after its dependencies, its results readable from the graph.
+- testRerun: A graph runs again from scratch, with wide fan out and fan in.
+- testNodeFailure: The first exception of a node is rethrown once the graph has drained.
+--------------------------------------------------------------------------------
+*/
+
+#include "StaticTaskGraph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace t_pool;
+
+namespace
+{
+    std::atomic<uint32_t> g_sequence = 0;
+
+    template <uint32_t Id>
+    struct Step
+    {
+        uint32_t sequence = 0;
+        uint32_t runCnt = 0;
+        void operator()() { sequence = ++g_sequence; ++runCnt; }
+    };
+
+    using Load = Step<0>;
+    using Parse = Step<1>;
+    using Index = Step<2>;
+    using Check = Step<3>;
+    using Report = Step<4>;
+
+    using PipelineGraph = StaticTaskGraph<StaticNode<Report, Index, Check>,
+                                          StaticNode<Load>,
+                                          StaticNode<Parse, Load>,
+                                          StaticNode<Index, Parse>,
+                                          StaticNode<Check, Parse>>;
+
+    struct Failing
+    {
+        void operator()() { throw std::runtime_error("failing node"); }
+    };
+};
+
+class StaticTaskGraphTests : public ::testing::Test
+{
+};
+
+TEST_F(StaticTaskGraphTests, testLayout)
+{
+    static_assert(PipelineGraph::NODE_CNT == 5);
+    static_assert(PipelineGraph::EDGE_CNT == 5);
+    static_assert(PipelineGraph::getNodeIdx<Parse>() == 2);
+    static_assert(PipelineGraph::getNodeIdx<Failing>() == PipelineGraph::NODE_CNT);
+    constexpr auto& layout = PipelineGraph::LAYOUT;
+    static_assert(layout.depCnts[0] == 2 && layout.depCnts[1] == 0 && layout.depCnts[2] == 1);
+    static_assert(layout.isAcyclic);
+
+    // Parse releases Index and Check
+    EXPECT_EQ(2u, layout.offsets[3] - layout.offsets[2]);
+    EXPECT_EQ(3u, layout.targets[layout.offsets[2]]);
+    EXPECT_EQ(4u, layout.targets[layout.offsets[2] + 1]);
+    EXPECT_EQ(0u, layout.offsets[1] - layout.offsets[0]);
+}
+
+TEST_F(StaticTaskGraphTests, testRunOrder)
+{
+    ThreadPool tpool(4);
+    PipelineGraph graph;
+    graph.run(tpool);
+
+    EXPECT_LT(graph.getNode<Load>().sequence, graph.getNode<Parse>().sequence);
+    EXPECT_LT(graph.getNode<Parse>().sequence, graph.getNode<Index>().sequence);
+    EXPECT_LT(graph.getNode<Parse>().sequence, graph.getNode<Check>().sequence);
+    EXPECT_LT(graph.getNode<Index>().sequence, graph.getNode<Report>().sequence);
+    EXPECT_LT(graph.getNode<Check>().sequence, graph.getNode<Report>().sequence);
+    EXPECT_EQ(1u, graph.getNode<Report>().runCnt);
+}
+
+TEST_F(StaticTaskGraphTests, testRerun)
+{
+    using WideGraph = StaticTaskGraph<StaticNode<Step<10>>,
+                                      StaticNode<Step<11>, Step<10>>,
+                                      StaticNode<Step<12>, Step<10>>,
+                                      StaticNode<Step<13>, Step<10>>,
+                                      StaticNode<Step<14>, Step<10>>,
+                                      StaticNode<Step<15>, Step<11>, Step<12>, Step<13>, Step<14>>>;
+    ThreadPool tpool(4);
+    WideGraph graph;
+    for (auto run = 1u; run <= 20; ++run)
+    {
+        graph.run(tpool);
+        EXPECT_EQ(run, graph.getNode<Step<10>>().runCnt);
+        EXPECT_EQ(run, graph.getNode<Step<13>>().runCnt);
+        EXPECT_EQ(run, graph.getNode<Step<15>>().runCnt);
+        EXPECT_LT(graph.getNode<Step<12>>().sequence, graph.getNode<Step<15>>().sequence);
+    }
+}
+
+TEST_F(StaticTaskGraphTests, testNodeFailure)
+{
+    using FailingGraph = StaticTaskGraph<StaticNode<Step<20>>,
+                                         StaticNode<Failing, Step<20>>,
+                                         StaticNode<Step<21>, Failing>>;
+    ThreadPool tpool(2);
+    FailingGraph graph;
+    EXPECT_THROW(graph.run(tpool), std::runtime_error);
+    EXPECT_EQ(1u, graph.getNode<Step<20>>().runCnt);
+    EXPECT_EQ(0u, graph.getNode<Step<21>>().runCnt);
+
+    // Drained all the same, the graph can run again
+    EXPECT_THROW(graph.run(tpool), std::runtime_error);
+    EXPECT_EQ(2u, graph.getNode<Step<20>>().runCnt);
+}
@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+TaskContextTests.cpp
+
+This file contains unit tests for the propagation of the task contexts. The main test cases are:
+
+- testSubmitPropagation: A task, and the tasks it submits, run in the context of the submitting thread.
+- testWorkerRestored: A worker gets back to the default context once a task is done.
+- testDagPropagation: Every node of a DAG runs in the context of the thread running the graph,
+  every node of a TDAG in the context and memory group its task was created in, whatever the mode.
+- testDeadlineStats: Tasks completed past their deadline are counted by the pool.
+--------------------------------------------------------------------------------
+*/
+
+#include "DagExecutor.hpp"
+#include "DagJobScheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace t_pool;
+
+class TaskContextTests : public ::testing::Test
+{
+    protected:
+        static TaskContext makeContext()
+        {
+            TaskContext context;
+            context.traceId = 0xABCDEF;
+            context.spanId = 42;
+            context.tenantId = 7;
+            context.priority = TaskPriority::HIGH;
+            context.deadline = TaskContext::Clock::now() + std::chrono::hours(1);
+            return context;
+        }
+
+        static void expectSame(const TaskContext& expected, const TaskContext& actual)
+        {
+            EXPECT_EQ(expected.traceId, actual.traceId);
+            EXPECT_EQ(expected.spanId, actual.spanId);
+            EXPECT_EQ(expected.tenantId, actual.tenantId);
+            EXPECT_EQ(expected.priority, actual.priority);
+            EXPECT_EQ(expected.deadline, actual.deadline);
+        }
+};
+
+TEST_F(TaskContextTests, testSubmitPropagation)
+{
+    ThreadPool tpool(2);
+    auto context = makeContext();
+    std::future<std::any> future;
+    {
+        TaskContext::Scope scope(context);
+        future = tpool.submit([&tpool]()
+        {
+            auto inner = tpool.submit([]() { return TaskContext::getCurrent(); });
+            return std::make_pair(TaskContext::getCurrent(), std::any_cast<TaskContext>(inner.get()));
+        });
+    }
+    EXPECT_EQ(0u, TaskContext::getCurrent().traceId);
+    auto seen = std::any_cast<std::pair<TaskContext, TaskContext>>(future.get());
+    expectSame(context, seen.first);
+    expectSame(context, seen.second);
+}
+
+TEST_F(TaskContextTests, testWorkerRestored)
+{
+    ThreadPool tpool(1);
+    {
+        TaskContext::Scope scope(makeContext());
+        tpool.submit([]() {}).get();
+    }
+    auto seen = std::any_cast<TaskContext>(tpool.submit([]() { return TaskContext::getCurrent(); }).get());
+    expectSame(TaskContext{}, seen);
+    EXPECT_FALSE(seen.hasDeadline());
+}
+
+TEST_F(TaskContextTests, testDagPropagation)
+{
+    // A diamond, 0 -> {1, 2} -> 3
+    const uint64_t offsets[] = {0, 2, 3, 4, 4};
+    const uint32_t targets[] = {1, 2, 3, 3};
+    CsrGraphView graph{4, offsets, targets};
+
+    ThreadPool tpool(4);
+    DagExecutor executor(tpool);
+    auto context = makeContext();
+    std::atomic<uint32_t> matching = 0;
+    {
+        TaskContext::Scope scope(context);
+        executor.run(graph, [&](uint32_t)
+        {
+            const auto& current = TaskContext::getCurrent();
+            if (current.traceId == context.traceId && current.tenantId == context.tenantId &&
+                current.deadline == context.deadline && current.priority == context.priority)
+                ++matching;
+        });
+    }
+    EXPECT_EQ(4u, matching);
+
+    // Nodes created in another context than the one running the graph
+    auto pGroup = std::make_shared<MemoryGroup>("dag", 1 << 20);
+    auto makeDag = [&](TDAG& dag)
+    {
+        TaskContext::Scope scope(context);
+        auto makeNode = [&]()
+        {
+            Task task;
+            task.submit([&]()
+            {
+                const auto& current = TaskContext::getCurrent();
+                if (current.traceId == context.traceId && current.tenantId == context.tenantId &&
+                    current.priority == context.priority && MemoryGroup::getCurrent() == pGroup.get())
+                    ++matching;
+            });
+            task.setMemoryGroup(pGroup);
+            return task;
+        };
+        dag.addTask(makeNode()).addDependency(makeNode()).addDependency(makeNode());
+    };
+    for (auto mode : {DagExecutionMode::DATAFLOW, DagExecutionMode::LEVELS})
+    {
+        matching = 0;
+        TDAG dag;
+        makeDag(dag);
+        dag.setExecutionMode(mode);
+        dag.execute(tpool);
+        EXPECT_EQ(3u, matching);
+    }
+    matching = 0;
+    TDAG dag;
+    makeDag(dag);
+    DagJobScheduler scheduler(tpool);
+    scheduler.submit(dag, DagJobOptions{}).wait();
+    EXPECT_EQ(3u, matching);
+}
+
+TEST_F(TaskContextTests, testDeadlineStats)
+{
+    ThreadPool tpool(2);
+    auto context = makeContext();
+    {
+        TaskContext::Scope scope(context);
+        tpool.submit([]() {}).get();
+    }
+    EXPECT_EQ(0u, tpool.getDeadlineMissedCnt());
+
+    context.deadline = TaskContext::Clock::now() + std::chrono::milliseconds(1);
+    {
+        TaskContext::Scope scope(context);
+        tpool.submit([]() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }).get();
+        tpool.submit([]() {}).get();
+    }
+    // The future is ready before the worker looks at the deadline
+    while (tpool.getTotalTaskCnt())
+        std::this_thread::yield();
+    EXPECT_EQ(2u, tpool.getDeadlineMissedCnt());
+}
@@ -0,0 +1,242 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+TaskCostModelTests.cpp
+
+This file contains unit tests for the historical task cost model. The main test cases are:
+
+- testMovingAverage: The EWMA of the durations follows the recorded samples.
+- testConcurrentRecord: Many threads record into the same and different task names at once.
+- testPersistence: The statistics survive a save/load round trip and a model bound to a file.
+- testGrainSize: The suggested grain size follows the per item cost.
+- testPoolRecordsNamedTasks: A pool with a cost model records the durations of its named tasks.
+- testSwapWhileSubmitting: The model of a pool can be replaced while other threads submit named tasks.
+- testCriticalPathEstimate: The critical path of a TDAG is estimated from the predicted durations.
+--------------------------------------------------------------------------------
+*/
+
+#include "TaskDAG.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace t_pool;
+using namespace std::chrono_literals;
+
+class TaskCostModelTests : public ::testing::Test
+{
+    public:
+        TaskCostModelTests()
+            : m_modelPath((std::filesystem::temp_directory_path() /
+                           ("TaskCostModelTests_" + std::to_string(::getpid()) + ".cost")).string())
+        {}
+        ~TaskCostModelTests() { std::remove(m_modelPath.c_str()); }
+
+    protected:
+        std::string m_modelPath;
+};
+
+TEST_F(TaskCostModelTests, testMovingAverage)
+{
+    TaskCostModel model(16, 0.5);
+    EXPECT_EQ(0u, model.getEstimate("parse").sampleCnt);
+    EXPECT_EQ(7ns, model.predict("parse", 7ns));
+
+    model.record("parse", 100ns);
+    EXPECT_EQ(100ns, model.getEstimate("parse").mean);
+    EXPECT_EQ(0ns, model.getEstimate("parse").stdDev);
+    model.record("parse", 300ns);
+    auto estimate = model.getEstimate("parse");
+    EXPECT_EQ(2u, estimate.sampleCnt);
+    EXPECT_EQ(200ns, estimate.mean);
+    EXPECT_EQ(100ns, estimate.stdDev);     // (1 - 0.5) * (0 + 0.5 * 200^2) = 100^2
+    EXPECT_EQ(200ns, model.predict("parse", 7ns));
+
+    // Unnamed and too long names are not tracked
+    model.record("", 10ns);
+    model.record(std::string(TaskCostModel::MAX_NAME_LENGTH + 1, 'x'), 10ns);
+    EXPECT_EQ(1u, model.getTaskCnt());
+}
+
+TEST_F(TaskCostModelTests, testConcurrentRecord)
+{
+    constexpr uint32_t THREADS = 8;
+    constexpr uint32_t SAMPLES = 2000;
+    TaskCostModel model(64);
+    std::vector<std::thread> recorders;
+    for (uint32_t thrd = 0; thrd < THREADS; ++thrd)
+    {
+        recorders.emplace_back([&model, thrd]()
+        {
+            for (uint32_t idx = 0; idx < SAMPLES; ++idx)
+            {
+                model.record("shared", 50ns);
+                model.record("task" + std::to_string(idx % 16), std::chrono::nanoseconds(thrd + 1));
+            }
+        });
+    }
+    for (auto& recorder : recorders)
+        recorder.join();
+
+    EXPECT_EQ(17u, model.getTaskCnt());
+    auto estimate = model.getEstimate("shared");
+    EXPECT_EQ(THREADS * SAMPLES, estimate.sampleCnt);
+    EXPECT_EQ(50ns, estimate.mean);
+    uint64_t sampleCnt = 0;
+    for (auto idx = 0; idx < 16; ++idx)
+    {
+        auto taskEstimate = model.getEstimate("task" + std::to_string(idx));
+        sampleCnt += taskEstimate.sampleCnt;
+        EXPECT_GE(taskEstimate.mean, 1ns);
+        EXPECT_LE(taskEstimate.mean, std::chrono::nanoseconds(THREADS));
+    }
+    EXPECT_EQ(THREADS * SAMPLES, sampleCnt);
+}
+
+TEST_F(TaskCostModelTests, testPersistence)
+{
+    {
+        TaskCostModel model;
+        model.record("load", 1000ns);
+        model.record("load", 3000ns);
+        model.record("store", 250ns);
+        EXPECT_TRUE(model.save(m_modelPath));
+    }
+    {
+        TaskCostModel model;
+        EXPECT_FALSE(model.load(m_modelPath + ".missing"));
+        EXPECT_TRUE(model.load(m_modelPath));
+        EXPECT_EQ(2u, model.getTaskCnt());
+        EXPECT_EQ(2u, model.getEstimate("load").sampleCnt);
+        EXPECT_EQ(1400ns, model.getEstimate("load").mean);
+        EXPECT_EQ(250ns, model.getEstimate("store").mean);
+    }
+
+    // A model bound to the file picks up from where the previous one left
+    {
+        TaskCostModel model(m_modelPath, 1024);
+        EXPECT_EQ(250ns, model.predict("store", 0ns));
+        model.record("store", 250ns);
+    }
+    TaskCostModel model(m_modelPath, 1024);
+    EXPECT_EQ(2u, model.getEstimate("store").sampleCnt);
+}
+
+TEST_F(TaskCostModelTests, testGrainSize)
+{
+    TaskCostModel model;
+    EXPECT_EQ(4096u, model.suggestGrainSize("item", 100us, 4096));
+    model.record("item", 1us);
+    EXPECT_EQ(100u, model.suggestGrainSize("item", 100us, 4096));
+    EXPECT_EQ(64u, model.suggestGrainSize("item", 100us, 64));
+    model.record("slowItem", 1ms);
+    EXPECT_EQ(1u, model.suggestGrainSize("slowItem", 100us, 4096));
+}
+
+TEST_F(TaskCostModelTests, testPoolRecordsNamedTasks)
+{
+    auto pModel = std::make_shared<TaskCostModel>();
+    ThreadPool pool(2);
+    pool.setCostModel(pModel);
+    EXPECT_EQ(pModel, pool.getCostModel());
+
+    std::vector<std::future<std::any>> futures;
+    for (auto idx = 0; idx < 4; ++idx)
+        futures.emplace_back(pool.submitNamed("nap", []() { std::this_thread::sleep_for(2ms); return 1; }));
+    futures.emplace_back(pool.submit([]() { return 2; }));
+    for (auto& future : futures)
+        future.get();
+    // A future is ready before its worker records the duration
+    while (pool.getTotalTaskCnt())
+        std::this_thread::yield();
+    pool.setCostModel(nullptr);
+
+    EXPECT_EQ(1u, pModel->getTaskCnt());
+    EXPECT_EQ(4u, pModel->getEstimate("nap").sampleCnt);
+    EXPECT_GE(pModel->getEstimate("nap").mean, 2ms);
+}
+
+TEST_F(TaskCostModelTests, testSwapWhileSubmitting)
+{
+    constexpr uint32_t TASK_CNT = 2000;
+    auto pFirst = std::make_shared<TaskCostModel>();
+    auto pSecond = std::make_shared<TaskCostModel>();
+    ThreadPool pool(2);
+    std::atomic_bool isSubmitting = true;
+    std::thread submitter([&pool, &isSubmitting]()
+    {
+        std::vector<std::future<std::any>> futures;
+        for (uint32_t idx = 0; idx < TASK_CNT; ++idx)
+        {
+            futures.emplace_back(pool.submitNamed("tick", [idx]() { return idx; }));
+            (void)pool.getCostModel();
+        }
+        for (auto& future : futures)
+            future.get();
+        isSubmitting = false;
+    });
+    for (uint32_t swapCnt = 0; isSubmitting; ++swapCnt)
+        pool.setCostModel((swapCnt % 2) ? pFirst : pSecond);
+    submitter.join();
+    pool.setCostModel(nullptr);
+
+    EXPECT_EQ(nullptr, pool.getCostModel());
+    EXPECT_LE(pFirst->getEstimate("tick").sampleCnt + pSecond->getEstimate("tick").sampleCnt, TASK_CNT);
+}
+
+TEST_F(TaskCostModelTests, testCriticalPathEstimate)
+{
+    TaskCostModel model;
+    model.record("fast", 10ns);
+    model.record("slow", 100ns);
+    auto namedTask = [](const char* name)
+    {
+        Task task;
+        task.submit([]() { return 0; });
+        task.setTaskName(name);
+        return task;
+    };
+
+    // slow <- fast <- fast on one branch, slow on the other, plus an unknown task
+    ConcurrentDAGBuilder builder;
+    auto first = builder.addTask(namedTask("slow"));
+    auto second = builder.addTask(namedTask("fast"));
+    auto third = builder.addTask(namedTask("fast"));
+    auto other = builder.addTask(namedTask("slow"));
+    auto unknown = builder.addTask(namedTask("unknown"));
+    builder.addDependency(second, first);
+    builder.addDependency(third, second);
+    builder.addDependency(unknown, other);
+    TDAG dag;
+    builder.mergeInto(dag);
+
+    EXPECT_EQ(120ns, dag.estimateCriticalPath(model, 0ns));
+    EXPECT_EQ(150ns, dag.estimateCriticalPath(model, 50ns));
+}
@@ -0,0 +1,368 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+TaskDAGTests.cpp
+
+This file contains unit tests for the Task_As_DAG (TDAG) class. The main test cases are:
+
+- testAddDependency: Builds a small graph through the fluent TDAG interface.
+- testConcurrentBuilder: Many threads add tasks and dependencies through a ConcurrentDAGBuilder
+  which are then merged into one TDAG.
+- testConcurrentBuilderUnknownDependency: Dependencies on tasks never added are dropped on merge.
+- testDataflowDependencies: RAW/WAR/WAW dependencies are derived from the declared data accesses.
+- testDataflowExecute: Readers and CONCURRENT writers of the same data run in parallel, the rest in order.
+- testExecute: Executes a graph on the pool and checks every task ran after its dependencies.
+- testSpeculativeExecution: A straggling idempotent task gets duplicated and the duplicate completes it.
+- testLevelExecution: Wide graphs run level by level, deep ones node by node, both honouring the dependencies.
+--------------------------------------------------------------------------------
+*/
+
+#include "TaskDAG.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace t_pool;
+
+class TaskDAGTests : public ::testing::Test
+{
+    public:
+        static int nonVoidFunc() noexcept { return 10; }
+
+        static Task makeTask()
+        {
+            Task task;
+            task.submit(nonVoidFunc);
+            return task;
+        }
+};
+
+TEST_F(TaskDAGTests, testAddDependency)
+{
+    TDAG dag;
+    auto parent = makeTask();
+    auto child1 = makeTask();
+    auto child2 = makeTask();
+    const auto parentId = static_cast<uint32_t>(parent.getTaskId());
+    const auto child1Id = static_cast<uint32_t>(child1.getTaskId());
+    const auto child2Id = static_cast<uint32_t>(child2.getTaskId());
+
+    dag.addTask(std::move(parent))
+       .addDependency(std::move(child1))
+       .addDependency(std::move(child2));
+
+    EXPECT_EQ(3u, dag.getTaskCnt());
+    EXPECT_EQ((std::vector<uint32_t>{child1Id, child2Id}), dag.getDependencies(parentId));
+    EXPECT_TRUE(dag.getDependencies(child1Id).empty());
+}
+
+TEST_F(TaskDAGTests, testConcurrentBuilder)
+{
+    constexpr uint32_t THREADS = 8;
+    constexpr uint32_t TASKS_PER_THREAD = 500;
+    ConcurrentDAGBuilder builder(4);
+    std::vector<std::vector<uint32_t>> taskIds(THREADS);
+
+    std::vector<std::thread> producers;
+    for (uint32_t thrd = 0; thrd < THREADS; ++thrd)
+    {
+        producers.emplace_back([&builder, &taskIds, thrd]()
+        {
+            for (uint32_t idx = 0; idx < TASKS_PER_THREAD; ++idx)
+            {
+                auto taskId = builder.addTask(makeTask());
+                // Every task depends on the previous one of the same producer
+                if (idx)
+                    builder.addDependency(taskId, taskIds[thrd].back());
+                taskIds[thrd].emplace_back(taskId);
+            }
+        });
+    }
+    for (auto& producer : producers)
+        producer.join();
+
+    // Cross producer dependencies, declared after all the tasks exist
+    for (uint32_t thrd = 1; thrd < THREADS; ++thrd)
+        builder.addDependency(taskIds[thrd].front(), taskIds[thrd - 1].back());
+
+    TDAG dag;
+    builder.mergeInto(dag);
+    EXPECT_EQ(THREADS * TASKS_PER_THREAD, dag.getTaskCnt());
+    EXPECT_TRUE(dag.getDependencies(taskIds[0].front()).empty());
+    for (uint32_t thrd = 0; thrd < THREADS; ++thrd)
+    {
+        for (uint32_t idx = 1; idx < TASKS_PER_THREAD; ++idx)
+        {
+            EXPECT_EQ((std::vector<uint32_t>{taskIds[thrd][idx - 1]}),
+                      dag.getDependencies(taskIds[thrd][idx]));
+        }
+        if (thrd)
+        {
+            EXPECT_EQ((std::vector<uint32_t>{taskIds[thrd - 1].back()}),
+                      dag.getDependencies(taskIds[thrd].front()));
+        }
+    }
+}
+
+TEST_F(TaskDAGTests, testConcurrentBuilderUnknownDependency)
+{
+    ConcurrentDAGBuilder builder;
+    auto taskId = builder.addTask(makeTask());
+    builder.addDependency(taskId, taskId + 100000);
+
+    TDAG dag;
+    builder.mergeInto(dag);
+    EXPECT_EQ(1u, dag.getTaskCnt());
+    EXPECT_TRUE(dag.getDependencies(taskId).empty());
+
+    // The builder is empty after a merge
+    TDAG otherDag;
+    builder.mergeInto(otherDag);
+    EXPECT_EQ(0u, otherDag.getTaskCnt());
+}
+
+TEST_F(TaskDAGTests, testExecute)
+{
+    std::atomic<uint32_t> sequence = 0;
+    auto orderedTask = [&sequence]()
+    {
+        Task task;
+        task.submit([&sequence]() { return ++sequence; });
+        return task;
+    };
+
+    ConcurrentDAGBuilder builder;
+    auto root = orderedTask();
+    auto rootFuture = root.getTaskFuture();
+    auto rootId = builder.addTask(std::move(root));
+    std::vector<std::future<std::any>> childFutures;
+    for (auto idx = 0; idx < 10; ++idx)
+    {
+        auto child = orderedTask();
+        childFutures.emplace_back(child.getTaskFuture());
+        builder.addDependency(builder.addTask(std::move(child)), rootId);
+    }
+
+    TDAG dag;
+    builder.mergeInto(dag);
+    ThreadPool pool(4);
+    dag.execute(pool);
+
+    EXPECT_EQ(1u, std::any_cast<uint32_t>(rootFuture.get()));
+    for (auto& childFuture : childFutures)
+        EXPECT_LT(1u, std::any_cast<uint32_t>(childFuture.get()));
+    EXPECT_EQ(11u, sequence);
+    EXPECT_EQ(0u, dag.getSpeculationCnt());
+}
+
+TEST_F(TaskDAGTests, testSpeculativeExecution)
+{
+    auto pHistory = std::make_shared<TaskDurationHistory>();
+    for (auto idx = 0; idx < 10; ++idx)
+        pHistory->record("straggler", std::chrono::milliseconds(1));
+    EXPECT_EQ(10u, pHistory->getSampleCnt("straggler"));
+    EXPECT_EQ(std::chrono::milliseconds(1), pHistory->getPercentile("straggler", 0.95));
+
+    // The first run straggles, the duplicate finishes straightaway
+    std::atomic<uint32_t> runs = 0;
+    Task straggler;
+    straggler.submit([&runs]()
+    {
+        auto run = ++runs;
+        if (run == 1)
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        return run;
+    });
+    straggler.setTaskName("straggler");
+    straggler.setIdempotent(true);
+    auto result = straggler.getTaskFuture();
+
+    SpeculationPolicy policy;
+    policy.enabled = true;
+    policy.pHistory = pHistory;
+    TDAG dag;
+    dag.setSpeculation(policy).addTask(std::move(straggler));
+
+    ThreadPool pool(2);
+    auto startTime = std::chrono::steady_clock::now();
+    dag.execute(pool);
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+    EXPECT_EQ(1u, dag.getSpeculationCnt());
+    EXPECT_EQ(2u, std::any_cast<uint32_t>(result.get()));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(400));
+}
+
+TEST_F(TaskDAGTests, testDataflowDependencies)
+{
+    DataflowDAGBuilder builder;
+    auto matrix = builder.registerData("matrix");
+    auto vector = builder.registerData("vector");
+    auto sum = builder.registerData("sum");
+
+    auto init = builder.addTask(makeTask(), {{matrix, AccessMode::WRITE}});
+    auto initVec = builder.addTask(makeTask(), {{vector, AccessMode::WRITE}});
+    auto read1 = builder.addTask(makeTask(), {{matrix, AccessMode::READ}, {vector, AccessMode::READ}});
+    auto read2 = builder.addTask(makeTask(), {{matrix, AccessMode::READ}});
+    auto scale = builder.addTask(makeTask(), {{matrix, AccessMode::READ_WRITE}});
+    auto overwrite = builder.addTask(makeTask(), {{matrix, AccessMode::WRITE}});
+    auto acc1 = builder.addTask(makeTask(), {{sum, AccessMode::CONCURRENT}, {matrix, AccessMode::READ}});
+    auto acc2 = builder.addTask(makeTask(), {{sum, AccessMode::CONCURRENT}});
+    auto total = builder.addTask(makeTask(), {{sum, AccessMode::READ}, {vector, AccessMode::READ},
+                                              {vector, AccessMode::WRITE}});
+    EXPECT_THROW(builder.addTask(makeTask(), {{DataHandle{42}, AccessMode::READ}}), std::invalid_argument);
+
+    TDAG dag;
+    builder.mergeInto(dag);
+    EXPECT_EQ(9u, dag.getTaskCnt());
+    auto sorted = [&dag](const uint32_t taskId)
+    {
+        auto deps = dag.getDependencies(taskId);
+        std::sort(deps.begin(), deps.end());
+        return deps;
+    };
+    EXPECT_TRUE(sorted(init).empty());
+    EXPECT_TRUE(sorted(initVec).empty());                               // Disjoint writes
+    EXPECT_EQ((std::vector<uint32_t>{init, initVec}), sorted(read1));  // RAW
+    EXPECT_EQ((std::vector<uint32_t>{init}), sorted(read2));           // Not on the other reader
+    EXPECT_EQ((std::vector<uint32_t>{read1, read2}), sorted(scale));   // WAR, WAW implied
+    EXPECT_EQ((std::vector<uint32_t>{scale}), sorted(overwrite));      // WAW
+    EXPECT_EQ((std::vector<uint32_t>{overwrite}), sorted(acc1));
+    EXPECT_TRUE(sorted(acc2).empty());                                  // Alongside acc1
+    EXPECT_EQ((std::vector<uint32_t>{read1, acc1, acc2}), sorted(total));
+}
+
+TEST_F(TaskDAGTests, testDataflowExecute)
+{
+    DataflowDAGBuilder builder;
+    auto input = builder.registerData("input");
+    auto output = builder.registerData("output");
+    std::vector<uint64_t> values;
+    std::atomic<uint64_t> result = 0;
+    std::atomic<uint32_t> running = 0;
+    std::atomic<uint32_t> maxRunning = 0;
+    auto track = [&running, &maxRunning]()
+    {
+        auto now = ++running;
+        for (auto max = maxRunning.load(); now > max && !maxRunning.compare_exchange_weak(max, now);) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --running;
+    };
+
+    Task fill;
+    fill.submit([&values]() { values.assign(100, 2); });
+    builder.addTask(std::move(fill), {{input, AccessMode::WRITE}});
+    for (auto part = 0; part < 4; ++part)
+    {
+        Task accumulate;
+        accumulate.submit([&values, &result, &track, part]()
+        {
+            track();
+            for (auto idx = part * 25; idx < (part + 1) * 25; ++idx)
+                result += values[idx];
+        });
+        builder.addTask(std::move(accumulate), {{input, AccessMode::READ}, {output, AccessMode::CONCURRENT}});
+    }
+    Task check;
+    uint64_t checked = 0;
+    check.submit([&result, &checked]() { checked = result; });
+    builder.addTask(std::move(check), {{output, AccessMode::READ}});
+    Task clear;
+    clear.submit([&values]() { values.clear(); });
+    builder.addTask(std::move(clear), {{input, AccessMode::WRITE}});
+
+    TDAG dag;
+    builder.mergeInto(dag);
+    ThreadPool tpool(4);
+    dag.execute(tpool);
+    EXPECT_EQ(200u, checked);
+    EXPECT_TRUE(values.empty());
+    EXPECT_GT(maxRunning.load(), 1u);
+}
+
+TEST_F(TaskDAGTests, testLevelExecution)
+{
+    // Every node checks the whole level above it has completed before it runs
+    constexpr uint32_t LEVEL_WIDTHS[] = {4, 200, 1};
+    std::array<std::atomic<uint32_t>, 3> doneCnts = {};
+    std::atomic<uint32_t> violationCnt = 0;
+    auto levelTask = [&doneCnts, &violationCnt, &LEVEL_WIDTHS](uint32_t level)
+    {
+        Task task;
+        task.submit([&doneCnts, &violationCnt, &LEVEL_WIDTHS, level]()
+        {
+            if (level && doneCnts[level - 1] != LEVEL_WIDTHS[level - 1])
+                ++violationCnt;
+            ++doneCnts[level];
+        });
+        return task;
+    };
+
+    ConcurrentDAGBuilder builder;
+    std::vector<uint32_t> roots;
+    for (uint32_t idx = 0; idx < LEVEL_WIDTHS[0]; ++idx)
+        roots.push_back(builder.addTask(levelTask(0)));
+    auto sink = builder.addTask(levelTask(2));
+    for (uint32_t idx = 0; idx < LEVEL_WIDTHS[1]; ++idx)
+    {
+        auto middle = builder.addTask(levelTask(1));
+        for (auto root : roots)
+            builder.addDependency(middle, root);
+        builder.addDependency(sink, middle);
+    }
+    TDAG wideDag;
+    builder.mergeInto(wideDag);
+    ThreadPool pool(4);
+    wideDag.execute(pool);
+    EXPECT_EQ(DagExecutionMode::LEVELS, wideDag.getLastExecutionMode());
+    EXPECT_EQ(0u, violationCnt);
+    EXPECT_EQ(1u, doneCnts[2]);
+
+    // A chain is as deep as it is long, it runs node by node unless told otherwise
+    for (auto mode : {DagExecutionMode::AUTO, DagExecutionMode::LEVELS})
+    {
+        std::atomic<uint32_t> sequence = 0;
+        std::vector<std::future<std::any>> results;
+        ConcurrentDAGBuilder chainBuilder;
+        uint32_t prevId = 0;
+        for (uint32_t idx = 0; idx < 10; ++idx)
+        {
+            Task task;
+            task.submit([&sequence]() { return ++sequence; });
+            results.emplace_back(task.getTaskFuture());
+            auto taskId = chainBuilder.addTask(std::move(task));
+            if (idx)
+                chainBuilder.addDependency(taskId, prevId);
+            prevId = taskId;
+        }
+        TDAG chain;
+        chainBuilder.mergeInto(chain);
+        chain.setExecutionMode(mode).execute(pool);
+        EXPECT_EQ(mode == DagExecutionMode::AUTO ? DagExecutionMode::DATAFLOW : DagExecutionMode::LEVELS,
+                  chain.getLastExecutionMode());
+        for (uint32_t idx = 0; idx < 10; ++idx)
+            EXPECT_EQ(idx + 1, std::any_cast<uint32_t>(results[idx].get()));
+    }
+}
@@ -0,0 +1,180 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+TaskGraphImageTests.cpp
+
+This file contains unit tests for the memory mapped task graph image. The main test cases are:
+
+- testRoundTrip: Writes a graph image, maps it back and checks the node table, CSR edges and type names.
+- testRunHonoursEdges: Runs a bound diamond graph on the pool and checks the execution order.
+- testUnregisteredType: Binding fails if a node type has no callable registered.
+- testCorruptImage: Truncated and cyclic images are rejected by the validation.
+- testLargeChain: A long chain of nodes is executed in order.
+--------------------------------------------------------------------------------
+*/
+
+#include "TaskGraphImage.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+using namespace t_pool;
+
+class TaskGraphImageTests : public ::testing::Test
+{
+    public:
+        TaskGraphImageTests()
+            : m_imagePath((std::filesystem::temp_directory_path() /
+                           ("TaskGraphImageTests_" + std::to_string(::getpid()) + ".tdag")).string())
+            , m_tpool(4)
+        {}
+        ~TaskGraphImageTests() { std::remove(m_imagePath.c_str()); }
+
+    protected:
+        std::string m_imagePath;
+        ThreadPool m_tpool;
+};
+
+TEST_F(TaskGraphImageTests, testRoundTrip)
+{
+    TaskGraphImageWriter writer;
+    auto load = writer.addNode("load");
+    auto parse = writer.addNode("parse");
+    auto store = writer.addNode("store");
+    auto parse2 = writer.addNode("parse");
+    writer.addEdge(load, parse);
+    writer.addEdge(load, parse2);
+    writer.addEdge(parse, store);
+    writer.addEdge(parse2, store);
+    writer.save(m_imagePath);
+
+    TaskGraphImage image(m_imagePath);
+    EXPECT_EQ(4u, image.getNodeCnt());
+    EXPECT_EQ(4u, image.getEdgeCnt());
+    EXPECT_EQ(3u, image.getTypeCnt());
+    EXPECT_EQ("parse", image.getTypeName(image.getNodeType(parse2)));
+    EXPECT_EQ(image.getNodeType(parse), image.getNodeType(parse2));
+
+    auto graph = image.getGraphView();
+    ASSERT_EQ(2u, graph.offsets[load + 1] - graph.offsets[load]);
+    EXPECT_EQ(parse, graph.targets[graph.offsets[load]]);
+    EXPECT_EQ(parse2, graph.targets[graph.offsets[load] + 1]);
+    EXPECT_EQ(0u, graph.offsets[store + 1] - graph.offsets[store]);
+}
+
+TEST_F(TaskGraphImageTests, testRunHonoursEdges)
+{
+    TaskGraphImageWriter writer;
+    auto top = writer.addNode("stage");
+    auto left = writer.addNode("stage");
+    auto right = writer.addNode("stage");
+    auto bottom = writer.addNode("sink");
+    writer.addEdge(top, left);
+    writer.addEdge(top, right);
+    writer.addEdge(left, bottom);
+    writer.addEdge(right, bottom);
+    writer.save(m_imagePath);
+
+    std::atomic<uint32_t> sequence = 0;
+    std::vector<std::atomic<uint32_t>> order(4);
+    TaskRegistry registry;
+    registry.registerTask("stage", [&](uint32_t nodeIdx) { order[nodeIdx] = ++sequence; })
+            .registerTask("sink", [&](uint32_t nodeIdx) { order[nodeIdx] = ++sequence; });
+
+    TaskGraphImage image(m_imagePath);
+    EXPECT_FALSE(image.isBound());
+    image.bind(registry);
+    EXPECT_TRUE(image.isBound());
+    image.run(m_tpool);
+
+    EXPECT_EQ(1u, order[top]);
+    EXPECT_LT(order[top], order[left]);
+    EXPECT_LT(order[top], order[right]);
+    EXPECT_EQ(4u, order[bottom]);
+}
+
+TEST_F(TaskGraphImageTests, testUnregisteredType)
+{
+    TaskGraphImageWriter writer;
+    writer.addNode("known");
+    writer.addNode("unknown");
+    writer.save(m_imagePath);
+
+    TaskRegistry registry;
+    registry.registerTask("known", [](uint32_t) {});
+    TaskGraphImage image(m_imagePath);
+    EXPECT_THROW(image.bind(registry), std::runtime_error);
+    EXPECT_THROW(image.run(m_tpool), std::logic_error);
+}
+
+TEST_F(TaskGraphImageTests, testCorruptImage)
+{
+    {
+        TaskGraphImageWriter writer;
+        auto first = writer.addNode("node");
+        auto second = writer.addNode("node");
+        writer.addEdge(first, second);
+        writer.addEdge(second, first);
+        writer.save(m_imagePath);
+        EXPECT_THROW(TaskGraphImage image(m_imagePath), std::runtime_error);
+    }
+    {
+        TaskGraphImageWriter writer;
+        writer.addEdge(writer.addNode("node"), writer.addNode("node"));
+        writer.save(m_imagePath);
+        std::filesystem::resize_file(m_imagePath, std::filesystem::file_size(m_imagePath) - 8);
+        EXPECT_THROW(TaskGraphImage image(m_imagePath), std::runtime_error);
+    }
+    EXPECT_THROW(TaskGraphImage image(m_imagePath + ".missing"), std::runtime_error);
+}
+
+TEST_F(TaskGraphImageTests, testLargeChain)
+{
+    constexpr uint32_t NODES = 10000;
+    TaskGraphImageWriter writer;
+    writer.addNode("step");
+    for (uint32_t idx = 1; idx < NODES; ++idx)
+        writer.addEdge(idx - 1, writer.addNode("step"));
+    writer.save(m_imagePath);
+
+    uint32_t lastNode = 0;
+    bool inOrder = true;
+    TaskRegistry registry;
+    registry.registerTask("step", [&](uint32_t nodeIdx)
+    {
+        // A chain runs strictly one node after the other, no need to synchronise
+        inOrder = inOrder && (nodeIdx == 0 || nodeIdx == lastNode + 1);
+        lastNode = nodeIdx;
+    });
+    TaskGraphImage image(m_imagePath);
+    image.bind(registry);
+    image.run(m_tpool);
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(NODES - 1, lastNode);
+}
@@ -0,0 +1,161 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+TaskGraphTests.cpp
+
+This file contains unit tests for the captured task graphs. The main test cases are:
+
+- testCaptureReplay: Results flow along the captured futures, replays pick up new arguments.
+- testDependencies: Tasks taking no results run after the ones they were made to depend on, replay after replay.
+- testInvalidUse: Mismatched arguments, changed dependencies, foreign tasks and cycles are rejected,
+  exceptions of the tasks reach the caller.
+- testEarlyRelease: Results are freed once their last consumer has run unless kept, bounding the peak memory of a chain.
+--------------------------------------------------------------------------------
+*/
+
+#include "TaskGraph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace t_pool;
+
+class TaskGraphTests : public ::testing::Test
+{
+    public:
+        static int multiply(int lhs, int rhs) noexcept { return lhs * rhs; }
+};
+
+TEST_F(TaskGraphTests, testCaptureReplay)
+{
+    TaskGraph graph;
+    auto product = graph.submit(multiply, 2, 3);
+    auto sum = graph.submit([](const int& value, int offset) { return value + offset; }, product, 10);
+    auto label = graph.submit([](const int& lhs, const int& rhs, const std::string& prefix)
+                              { return prefix + std::to_string(lhs * rhs); }, product, sum, std::string("x="));
+    EXPECT_EQ(3u, graph.getTaskCnt());
+    EXPECT_THROW(graph.getResult(product), std::bad_any_cast);
+
+    ThreadPool pool(4);
+    graph.replay(pool);
+    EXPECT_EQ(6, graph.getResult(product));
+    EXPECT_EQ(16, graph.getResult(sum));
+    EXPECT_EQ("x=96", graph.getResult(label));
+
+    graph.setArguments(product, 4, 5);
+    graph.setArguments(label, product, sum, std::string("y="));
+    graph.replay(pool);
+    EXPECT_EQ(20, graph.getResult(product));
+    EXPECT_EQ(30, graph.getResult(sum));
+    EXPECT_EQ("y=600", graph.getResult(label));
+    EXPECT_EQ(2u, graph.getReplayCnt());
+}
+
+TEST_F(TaskGraphTests, testDependencies)
+{
+    constexpr uint32_t TASK_CNT = 100;
+    std::atomic<uint32_t> sequence = 0;
+    std::vector<uint32_t> positions(TASK_CNT);
+    TaskGraph graph;
+    GraphFuture<void> prev;
+    for (uint32_t idx = 0; idx < TASK_CNT; ++idx)
+    {
+        auto task = graph.submit([&sequence, &positions, idx]() { positions[idx] = sequence++; });
+        if (prev.valid())
+            graph.addDependency(task, prev);
+        prev = task;
+    }
+
+    ThreadPool pool(4);
+    for (uint32_t replay = 0; replay < 3; ++replay)
+    {
+        graph.replay(pool);
+        for (uint32_t idx = 0; idx < TASK_CNT; ++idx)
+            EXPECT_EQ(replay * TASK_CNT + idx, positions[idx]);
+    }
+}
+
+TEST_F(TaskGraphTests, testInvalidUse)
+{
+    TaskGraph graph;
+    auto first = graph.submit(multiply, 2, 3);
+    auto second = graph.submit([](const int& value) { return value; }, first);
+    EXPECT_THROW(graph.setArguments(first, 2L, 3L), std::bad_any_cast);
+    auto other = graph.submit(multiply, 1, 1);
+    EXPECT_THROW(graph.setArguments(second, other), std::invalid_argument);
+
+    TaskGraph bigger;
+    for (int idx = 0; idx < 5; ++idx)
+        bigger.submit(multiply, idx, idx);
+    auto foreign = bigger.submit(multiply, 7, 7);
+    EXPECT_THROW(graph.submit([](const int& value) { return value; }, foreign), std::invalid_argument);
+    EXPECT_EQ(3u, graph.getTaskCnt());
+
+    ThreadPool pool(2);
+    auto failing = graph.submit([](const int& value) -> int { throw std::runtime_error(std::to_string(value)); }, other);
+    auto skipped = graph.submit([](const int& value) { return value; }, failing);
+    EXPECT_THROW(graph.replay(pool), std::runtime_error);
+    EXPECT_THROW(graph.getResult(skipped), std::bad_any_cast);
+
+    graph.addDependency(first, second);     // first -> second -> first
+    EXPECT_THROW(graph.replay(pool), std::logic_error);
+}
+
+TEST_F(TaskGraphTests, testEarlyRelease)
+{
+    constexpr size_t BLOCK_SIZE = 1 << 20;
+    constexpr uint32_t CHAIN_LEN = 10;
+    TaskGraph graph;
+    std::vector<GraphFuture<std::vector<char>>> stages;
+    stages.push_back(graph.submit([](size_t size) { return std::vector<char>(size, 1); }, BLOCK_SIZE));
+    for (uint32_t idx = 1; idx < CHAIN_LEN; ++idx)
+    {
+        stages.push_back(graph.submit([](const std::vector<char>& prev)
+        {
+            std::vector<char> next(prev.size());
+            for (size_t pos = 0; pos < prev.size(); ++pos)
+                next[pos] = static_cast<char>(prev[pos] + 1);
+            return next;
+        }, stages.back()));
+    }
+
+    ThreadPool pool(2);
+    graph.replay(pool);
+    EXPECT_GE(graph.getPeakLiveResultBytes(), CHAIN_LEN * BLOCK_SIZE);
+    EXPECT_EQ(graph.getPeakLiveResultBytes(), graph.getLiveResultBytes());
+
+    graph.setEarlyRelease(true);
+    graph.keepResult(stages[3]);
+    graph.replay(pool);
+    EXPECT_GE(graph.getPeakLiveResultBytes(), 2 * BLOCK_SIZE);
+    EXPECT_LT(graph.getPeakLiveResultBytes(), 4 * BLOCK_SIZE);
+    EXPECT_LT(graph.getLiveResultBytes(), 3 * BLOCK_SIZE);    // The kept one and the sink
+    EXPECT_THROW(graph.getResult(stages[0]), std::bad_any_cast);
+    EXPECT_THROW(graph.getResult(stages[5]), std::bad_any_cast);
+    EXPECT_EQ(4, graph.getResult(stages[3]).front());
+    EXPECT_EQ(static_cast<char>(CHAIN_LEN), graph.getResult(stages.back()).front());
+}
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2025 Swarnendu RC
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+--------------------------------------------------------------------------------
+TaskPriorityTests.cpp
+
+This file contains unit tests for the task priorities and their inheritance. The main test cases are:
+
+- testPriorityOrder: The workers pick the queued tasks of the highest priority first, in submission order.
+- testSubmitInheritance: Tasks submitted by a task inherit its priority.
+- testFutureBoost: Waiting for a task from a more urgent context moves it up the ready queues,
+  the entry left behind is dropped once the pool has run dry.
+- testDagBoost: Boosting a DAG node boosts its unfinished predecessors.
+--------------------------------------------------------------------------------
+*/
+
+#include "DagExecutor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+class TaskPriorityTests : public ::testing::Test
+{
+    protected:
+        /** @brief Occupies the only worker of a pool until released */
+        void blockWorker(ThreadPool& pool)
+        {
+            m_blocker = pool.submit([future = m_gate.get_future().share()]() { future.wait(); });
+            while (pool.getTaskQueued())
+                std::this_thread::yield();
+        }
+
+        void releaseWorker()
+        {
+            m_gate.set_value();
+            m_blocker.get();
+        }
+
+        void record(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(m_orderMtx);
+            m_order.emplace_back(name);
+        }
+
+        std::promise<void> m_gate;
+        std::future<std::any> m_blocker;
+        std::mutex m_orderMtx;
+        std::vector<std::string> m_order;
+};
+
+TEST_F(TaskPriorityTests, testPriorityOrder)
+{
+    ThreadPool tpool(1);
+    blockWorker(tpool);
+    std::vector<PriorityFuture> futures;
+    futures.emplace_back(tpool.submitWithPriority(TaskPriority::LOW, [this]() { record("low1"); }));
+    futures.emplace_back(tpool.submitWithPriority(TaskPriority::HIGH, [this]() { record("high1"); }));
+    futures.emplace_back(tpool.submitWithPriority(TaskPriority::NORMAL, [this]() { record("normal"); }));
+    futures.emplace_back(tpool.submitWithPriority(TaskPriority::HIGH, [this]() { record("high2"); }));
+    futures.emplace_back(tpool.submitWithPriority(TaskPriority::CRITICAL, [this]() { record("critical"); }));
+    futures.emplace_back(tpool.submitWithPriority(TaskPriority::LOW, [this]() { record("low2"); }));
+    EXPECT_EQ(6u, tpool.getTaskQueued());
+    releaseWorker();
+    for (auto& future : futures)
+        future.get();
+    EXPECT_EQ((std::vector<std::string>{"critical", "high1", "high2", "normal", "low1", "low2"}), m_order);
+}
+
+TEST_F(TaskPriorityTests, testSubmitInheritance)
+{
+    ThreadPool tpool(2);
+    EXPECT_EQ(TaskPriority::NORMAL, Task::getCurrentPriority());
+    auto outer = tpool.submitWithPriority(TaskPriority::HIGH, [&tpool]()
+    {
+        auto inner = tpool.submit([]() { return Task::getCurrentPriority(); });
+        return std::any_cast<TaskPriority>(inner.get());
+    });
+    EXPECT_EQ(TaskPriority::HIGH, std::any_cast<TaskPriority>(outer.get()));
+
+    Task::PriorityScope scope(TaskPriority::LOW);
+    auto plain = tpool.submit([]() { return Task::getCurrentPriority(); });
+    EXPECT_EQ(TaskPriority::LOW, std::any_cast<TaskPriority>(plain.get()));
+}
+
+TEST_F(TaskPriorityTests, testFutureBoost)
+{
+    ThreadPool tpool(1);
+    blockWorker(tpool);
+    std::vector<PriorityFuture> futures;
+    for (auto idx = 0; idx < 3; ++idx)
+        futures.emplace_back(tpool.submitWithPriority(TaskPriority::NORMAL, [this]() { record("normal"); }));
+    auto pToken = std::make_shared<int>(0);
+    auto target = tpool.submitWithPriority(TaskPriority::LOW, [this, pToken]() { record("target"); });
+
+    std::thread waiter([&target]()
+    {
+        Task::PriorityScope scope(TaskPriority::HIGH);
+        target.get();
+    });
+    while (tpool.getTaskBoostedCnt() != 1)
+        std::this_thread::yield();
+    // The boosted task sits in two queues but counts once
+    EXPECT_EQ(4u, tpool.getTaskQueued());
+    releaseWorker();
+    waiter.join();
+    for (auto& future : futures)
+        future.get();
+    ASSERT_EQ(4u, m_order.size());
+    EXPECT_EQ("target", m_order.front());
+    EXPECT_EQ(0u, tpool.getTaskQueued());
+
+    // The idle worker drains the entry left behind, releasing the task and its closure
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (pToken.use_count() > 1 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    EXPECT_EQ(1, pToken.use_count());
+}
+
+TEST_F(TaskPriorityTests, testDagBoost)
+{
+    // 0 and 1 are roots, 2 waits for 1
+    const uint64_t offsets[] = {0, 0, 1, 1};
+    const uint32_t targets[] = {2};
+    CsrGraphView graph{3, offsets, targets};
+
+    ThreadPool tpool(1);
+    blockWorker(tpool);
+    DagExecutor executor(tpool);
+    std::thread runner([&]()
+    {
+        Task::PriorityScope scope(TaskPriority::LOW);
+        executor.run(graph, [this](uint32_t nodeIdx) { record("node" + std::to_string(nodeIdx)); });
+    });
+    while (tpool.getTaskQueued() != 2)
+        std::this_thread::yield();
+    std::vector<PriorityFuture> futures;
+    for (auto idx = 0; idx < 2; ++idx)
+        futures.emplace_back(tpool.submitWithPriority(TaskPriority::NORMAL, [this]() { record("normal"); }));
+
+    executor.boost(2, TaskPriority::HIGH);
+    releaseWorker();
+    runner.join();
+    for (auto& future : futures)
+        future.get();
+    EXPECT_EQ((std::vector<std::string>{"node1", "node2", "normal", "normal", "node0"}), m_order);
+}
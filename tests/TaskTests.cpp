@@ -497,5 +497,23 @@ TEST_F(TaskTests, testMove)
     }
 }
 
+TEST_F(TaskTests, testIdempotentRunTwice)
+{
+    LocalTask task;
+    std::atomic<int> runs = 0;
+    task.submit([&runs]() { return ++runs; });
+    task.setIdempotent(true);
+    EXPECT_TRUE(task.isIdempotent());
+    auto result = task.getTaskFuture();
+
+    EXPECT_FALSE(task.isCompleted());
+    EXPECT_TRUE(task.runAndForget());
+    EXPECT_TRUE(task.isCompleted());
+    // The second run executes but can't overwrite the published result
+    EXPECT_FALSE(task.runAndForget());
+    EXPECT_EQ(2, runs);
+    EXPECT_EQ(1, std::any_cast<int>(result.get()));
+}
+
 //leaks --atExit --list -- ./bin/TestThreadPool_d --gtest_shuffle --gtest_repeat=3 --gtest_filter="TaskTests.*"
 //leaks --atExit --list -- ./bin/TestThreadPool_d --gtest_shuffle --gtest_repeat=3 --gtest_filter=TaskTests.testSubmittingVoidFunctorWithArgs
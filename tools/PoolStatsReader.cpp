@@ -0,0 +1,105 @@
+/**
+ * @file PoolStatsReader.cpp
+ * @author Swarnendu RC
+ * @brief Prints the live counters a pool publishes into its shared memory stats page.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * The page is attached read only, the pool being watched is never slowed down
+ * by it. The task rates are computed between two consecutive samples.
+ *
+ * Usage: PoolStatsReader <page name> [interval ms] [samples, 0 for ever]
+ */
+#include "ShmStatsPage.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace t_pool;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s <page name> [interval ms] [samples, 0 for ever]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    auto interval = std::chrono::milliseconds((argc > 2) ? std::atol(argv[2]) : 1000);
+    auto sampleCnt = (argc > 3) ? std::atol(argv[3]) : 0;
+    if (interval.count() <= 0)
+        interval = std::chrono::milliseconds(1000);
+
+    try
+    {
+        ShmStatsPage page(argv[1]);
+        std::vector<WorkerStats> lastStats(page.getWorkerCapacity());
+        for (long sampleIdx = 0; !sampleCnt || sampleIdx < sampleCnt; ++sampleIdx)
+        {
+            if (sampleIdx)
+                std::this_thread::sleep_for(interval);
+
+            PoolStats poolStats;
+            if (!page.readPool(poolStats))
+            {
+                std::fprintf(stderr, "Pool record of %s keeps changing, skipped\n", page.getName().c_str());
+                continue;
+            }
+            auto nowNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count());
+            std::printf("pool: %llu workers, %llu tasks (%llu queued, %llu deferred), "
+                        "%llu deadlines missed, %llu yields, published %.3f ms ago\n",
+                        static_cast<unsigned long long>(poolStats.poolSize),
+                        static_cast<unsigned long long>(poolStats.taskCnt),
+                        static_cast<unsigned long long>(poolStats.queuedCnt),
+                        static_cast<unsigned long long>(poolStats.deferredCnt),
+                        static_cast<unsigned long long>(poolStats.deadlineMissedCnt),
+                        static_cast<unsigned long long>(poolStats.yieldCnt),
+                        (nowNs > poolStats.publishedNs) ? (nowNs - poolStats.publishedNs) / 1e6 : 0.0);
+
+            auto workerCnt = std::min<uint64_t>(poolStats.poolSize, page.getWorkerCapacity());
+            for (uint32_t workerIdx = 0; workerIdx < workerCnt; ++workerIdx)
+            {
+                WorkerStats workerStats;
+                if (!page.readWorker(workerIdx, workerStats))
+                    continue;
+                auto& last = lastStats[workerIdx];
+                double seconds = interval.count() / 1000.0;
+                std::printf("  worker %3u: %12llu tasks %10.0f tasks/s %6.1f%% busy\n", workerIdx,
+                            static_cast<unsigned long long>(workerStats.taskCnt),
+                            sampleIdx ? (workerStats.taskCnt - last.taskCnt) / seconds : 0.0,
+                            sampleIdx ? (workerStats.busyNs - last.busyNs) / (seconds * 1e7) : 0.0);
+                last = workerStats;
+            }
+            std::fflush(stdout);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}